@@ -22,6 +22,10 @@
 
 %{
 #include <gr_iir_filter_ffd.h>
+#include <gr_iir_sos_filter_ffd.h>
+#include <gr_iir_sos_filter_ccd.h>
+#include <gr_iir_sos_filter_mc_ffd.h>
+#include <gr_iir_sos_filter_mc_ccd.h>
 #include <gr_single_pole_iir_filter_ff.h>
 #include <gr_single_pole_iir_filter_cc.h>
 #include <gr_hilbert_fc.h>
@@ -34,6 +38,7 @@
 #include <gr_pfb_channelizer_ccf.h>
 #include <gr_pfb_synthesizer_ccf.h>
 #include <gr_pfb_decimator_ccf.h>
+#include <gr_pfb_xlating_decimator_ccf.h>
 #include <gr_pfb_interpolator_ccf.h>
 #include <gr_pfb_arb_resampler_ccf.h>
 #include <gr_pfb_arb_resampler_fff.h>
@@ -44,6 +49,10 @@
 %}
 
 %include "gr_iir_filter_ffd.i"
+%include "gr_iir_sos_filter_ffd.i"
+%include "gr_iir_sos_filter_ccd.i"
+%include "gr_iir_sos_filter_mc_ffd.i"
+%include "gr_iir_sos_filter_mc_ccd.i"
 %include "gr_single_pole_iir_filter_ff.i"
 %include "gr_single_pole_iir_filter_cc.i"
 %include "gr_hilbert_fc.i"
@@ -56,6 +65,7 @@
 %include "gr_pfb_channelizer_ccf.i"
 %include "gr_pfb_synthesizer_ccf.i"
 %include "gr_pfb_decimator_ccf.i"
+%include "gr_pfb_xlating_decimator_ccf.i"
 %include "gr_pfb_interpolator_ccf.i"
 %include "gr_pfb_arb_resampler_ccf.i"
 %include "gr_pfb_arb_resampler_fff.i"
@@ -26,6 +26,8 @@
 
 #include <gr_adaptive_fir_ccc.h>
 #include <gr_io_signature.h>
+#include <algorithm>
+#include <stdexcept>
 
 gr_adaptive_fir_ccc::gr_adaptive_fir_ccc(const char *name, int decimation,
 					 const std::vector<gr_complex> &taps)
@@ -33,7 +35,9 @@ gr_adaptive_fir_ccc::gr_adaptive_fir_ccc(const char *name, int decimation,
 		       gr_make_io_signature (1, 1, sizeof(gr_complex)),
 		       gr_make_io_signature (1, 1, sizeof(gr_complex)),
 		       decimation),
-    d_updated(false), d_taps(taps)
+    d_new_taps(taps), d_new_block_size(1),
+    d_lms(std::max((int) taps.size(), 1), decimation),
+    d_taps(taps)
 {
   set_history(d_taps.size());
 }
@@ -41,8 +45,16 @@ gr_adaptive_fir_ccc::gr_adaptive_fir_ccc(const char *name, int decimation,
 void
 gr_adaptive_fir_ccc::set_taps(const std::vector<gr_complex> &taps)
 {
-  d_new_taps = taps;
-  d_updated = true;
+  // Picked up by work at the start of its next call
+  d_new_taps.set(taps);
+}
+
+void
+gr_adaptive_fir_ccc::set_block_size(int block_size)
+{
+  if (block_size < 1)
+    throw std::invalid_argument("gr_adaptive_fir_ccc: block_size must be >= 1");
+  d_new_block_size.set(block_size);
 }
 
 gr_complex
@@ -64,25 +76,71 @@ gr_adaptive_fir_ccc::work(int noutput_items,
   gr_complex *in = (gr_complex *)input_items[0];
   gr_complex *out = (gr_complex *)output_items[0];
 
-  if (d_updated) {
-    d_taps = d_new_taps;
-    set_history(d_taps.size());
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
+  if (d_new_taps.update()) {
+    d_taps = d_new_taps.current();
+    if (history() != d_taps.size()) {
+      set_history(d_taps.size());
+      return 0;		     // history requirements have changed.
+    }
   }
 
+  if (d_new_block_size.update())
+    d_lms.set_block_size(d_new_block_size.current());
+
   int j = 0, k, l = d_taps.size();
-  for (int i = 0; i < noutput_items; i++) {
-    out[i] = filter(&in[j]);
+  if (l == 0 || d_lms.block_size() == 1) {
+    for (int i = 0; i < noutput_items; i++) {
+      out[i] = filter(&in[j]);
+
+      // Adjust taps
+      d_error = error(out[i]);
+      for (k = 0; k < l; k++) {
+	update_tap(d_taps[l-k-1], in[j+k]);
+      }
 
-    // Adjust taps
-    d_error = error(out[i]);
-    for (k = 0; k < l; k++) {
-      update_tap(d_taps[l-k-1], in[j+k]);
+      j += decimation();
     }
 
-    j += decimation();
+    return noutput_items;
   }
 
+  // Block LMS: filter a block with fixed taps, then adapt.  Without a
+  // linear_update the taps are adapted through update_tap.
+  gr_complex mu;
+  bool conj_input;
+  bool linear = linear_update(mu, conj_input);
+
+  int bs = d_lms.block_size();
+  d_errors.resize(bs);
+  if (linear)
+    d_lms.set_taps(d_taps);
+
+  for (int i = 0; i < noutput_items; i += bs) {
+    int n = std::min(bs, noutput_items - i);
+    const gr_complex *x = &in[i*decimation()];
+
+    if (!linear)
+      d_lms.set_taps(d_taps);
+    d_lms.filter(&out[i], x, n);
+
+    for (int m = 0; m < n; m++) {
+      d_error = error(out[i+m]);
+      d_errors[m] = d_error;
+    }
+
+    if (linear)
+      d_lms.update(x, &d_errors[0], n, mu, conj_input);
+    else {
+      for (int m = 0; m < n; m++) {
+	d_error = d_errors[m];
+	for (k = 0; k < l; k++)
+	  update_tap(d_taps[l-k-1], x[m*decimation()+k]);
+      }
+    }
+  }
+
+  if (linear)
+    d_lms.get_taps(d_taps);
+
   return noutput_items;
 }
@@ -25,6 +25,8 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_decimator.h>
+#include <gri_double_buffer.h>
+#include <gri_block_lms_ccc.h>
 
 /*!
  * \brief Adaptive FIR filter with gr_complex input, gr_complex output and float taps
@@ -33,8 +35,10 @@
 class GR_CORE_API gr_adaptive_fir_ccc : public gr_sync_decimator
 {
 private:
-  std::vector<gr_complex>  d_new_taps;
-  bool                     d_updated;
+  gri_double_buffer<std::vector<gr_complex> > d_new_taps;
+  gri_double_buffer<int>   d_new_block_size;
+  gri_block_lms_ccc        d_lms;
+  std::vector<gr_complex>  d_errors;
 
 protected:
   gr_complex	           d_error;
@@ -46,6 +50,15 @@ protected:
   // Override to calculate new weight from old, corresponding input
   virtual void update_tap(gr_complex &tap, const gr_complex &in) = 0;
 
+  /*!
+   * Override to let gri_block_lms_ccc update all the taps at once.  If
+   * update_tap(tap, in) is tap += mu * in * d_error, or
+   * tap += mu * conj(in) * d_error, set \p mu and \p conj_input to
+   * match and return true.  The default returns false, and update_tap
+   * is called for every tap after every output.
+   */
+  virtual bool linear_update(gr_complex &mu, bool &conj_input) { return false; }
+
   gr_complex filter(gr_complex *x);
 
   gr_adaptive_fir_ccc(const char *name, int decimation,
@@ -54,6 +67,17 @@ protected:
 public:
   void set_taps(const std::vector<gr_complex> &taps);
 
+  /*!
+   * \brief Adapt the taps once every \p block_size outputs (block LMS).
+   *
+   * Each block is filtered with the taps held fixed, then the taps
+   * take the sum of the block's updates.  Long filters with blocks
+   * about as long as the filter run in the frequency domain.  The
+   * default of 1 runs the per-sample filter and update_tap loop.
+   */
+  void set_block_size(int block_size);
+  int block_size() const { return d_new_block_size.latest(); }
+
   int work(int noutput_items,
            gr_vector_const_void_star &input_items,
            gr_vector_void_star &output_items);
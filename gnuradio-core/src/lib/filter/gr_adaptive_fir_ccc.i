@@ -28,4 +28,6 @@ protected:
 
 public:
   void set_taps(const std::vector<gr_complex> &taps);
+  void set_block_size(int block_size);
+  int block_size() const;
 };
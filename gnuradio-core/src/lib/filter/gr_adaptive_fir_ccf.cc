@@ -26,13 +26,16 @@
 
 #include <gr_adaptive_fir_ccf.h>
 #include <gr_io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <stdexcept>
 
 gr_adaptive_fir_ccf::gr_adaptive_fir_ccf(const char *name, int decimation, const std::vector<float> &taps)
   : gr_sync_decimator (name,
 		       gr_make_io_signature (1, 1, sizeof(gr_complex)),
 		       gr_make_io_signature (1, 1, sizeof(gr_complex)),
 		       decimation),
-    d_updated(false)
+    d_new_taps(taps), d_new_block_size(1)
 {
   d_taps = taps;
   set_history(d_taps.size());
@@ -40,8 +43,15 @@ gr_adaptive_fir_ccf::gr_adaptive_fir_ccf(const char *name, int decimation, const
 
 void gr_adaptive_fir_ccf::set_taps(const std::vector<float> &taps)
 {
-  d_new_taps = taps;
-  d_updated = true;
+  // Picked up by work at the start of its next call
+  d_new_taps.set(taps);
+}
+
+void gr_adaptive_fir_ccf::set_block_size(int block_size)
+{
+  if (block_size < 1)
+    throw std::invalid_argument("gr_adaptive_fir_ccf: block_size must be >= 1");
+  d_new_block_size.set(block_size);
 }
 
 int gr_adaptive_fir_ccf::work(int noutput_items,
@@ -51,14 +61,42 @@ int gr_adaptive_fir_ccf::work(int noutput_items,
   gr_complex *in = (gr_complex *)input_items[0];
   gr_complex *out = (gr_complex *)output_items[0];
 
-  if (d_updated) {
-    d_taps = d_new_taps;
-    set_history(d_taps.size());
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
+  if (d_new_taps.update()) {
+    d_taps = d_new_taps.current();
+    if (history() != d_taps.size()) {
+      set_history(d_taps.size());
+      return 0;		     // history requirements have changed.
+    }
   }
 
+  d_new_block_size.update();
+  int bs = d_new_block_size.current();
+
   int j = 0, k, l = d_taps.size();
+  if (bs > 1 && l > 0) {
+    // Block LMS: filter a block with fixed taps, then adapt
+    d_rtaps.resize(l);
+    d_errors.resize(bs);
+    for (int i = 0; i < noutput_items; i += bs) {
+      int n = std::min(bs, noutput_items - i);
+      const gr_complex *x = &in[i*decimation()];
+
+      for (k = 0; k < l; k++)
+	d_rtaps[k] = d_taps[l-k-1];
+      for (int m = 0; m < n; m++) {
+	volk_32fc_32f_dot_prod_32fc_u(&out[i+m], &x[m*decimation()], &d_rtaps[0], l);
+	d_errors[m] = error(out[i+m]);
+      }
+
+      for (int m = 0; m < n; m++) {
+	d_error = d_errors[m];
+	for (k = 0; k < l; k++)
+	  update_tap(d_taps[l-k-1], x[m*decimation()+k]);
+      }
+    }
+    return noutput_items;
+  }
+
   for (int i = 0; i < noutput_items; i++) {
     // Generic dot product of d_taps[] and in[]
     gr_complex sum(0.0, 0.0);
@@ -25,6 +25,7 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_decimator.h>
+#include <gri_double_buffer.h>
 
 /*!
  * \brief Adaptive FIR filter with gr_complex input, gr_complex output and float taps
@@ -33,8 +34,10 @@
 class GR_CORE_API gr_adaptive_fir_ccf : public gr_sync_decimator
 {
 private:
-  std::vector<float>  d_new_taps;
-  bool                d_updated;
+  gri_double_buffer<std::vector<float> > d_new_taps;
+  gri_double_buffer<int>   d_new_block_size;
+  std::vector<float>       d_rtaps;
+  std::vector<float>       d_errors;
 
 protected:
   float		      d_error;
@@ -51,6 +54,16 @@ protected:
 public:
   void set_taps(const std::vector<float> &taps);
 
+  /*!
+   * \brief Adapt the taps once every \p block_size outputs (block LMS).
+   *
+   * Each block is filtered with the taps held fixed, then update_tap
+   * is applied for each of its outputs.  The default of 1 adapts after
+   * every output.
+   */
+  void set_block_size(int block_size);
+  int block_size() const { return d_new_block_size.latest(); }
+
   int work(int noutput_items,
            gr_vector_const_void_star &input_items,
            gr_vector_void_star &output_items);
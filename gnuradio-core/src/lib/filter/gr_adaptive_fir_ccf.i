@@ -27,4 +27,6 @@ protected:
 
 public:
   void set_taps(const std::vector<float> &taps);
+  void set_block_size(int block_size);
+  int block_size() const;
 };
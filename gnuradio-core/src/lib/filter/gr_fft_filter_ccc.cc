@@ -57,7 +57,7 @@ gr_fft_filter_ccc::gr_fft_filter_ccc (int decimation,
 		       gr_make_io_signature (1, 1, sizeof (gr_complex)),
 		       gr_make_io_signature (1, 1, sizeof (gr_complex)),
 		       decimation),
-    d_updated(false)
+    d_new_taps(taps)
 {
   set_history(1);
 
@@ -67,7 +67,6 @@ gr_fft_filter_ccc::gr_fft_filter_ccc (int decimation,
   d_filter = new gri_fft_filter_ccc_sse(decimation, taps);
 #endif
 
-  d_new_taps = taps;
   d_nsamples = d_filter->set_taps(taps);
   set_output_multiple(d_nsamples);
 }
@@ -80,14 +79,14 @@ gr_fft_filter_ccc::~gr_fft_filter_ccc ()
 void
 gr_fft_filter_ccc::set_taps (const std::vector<gr_complex> &taps)
 {
-  d_new_taps = taps;
-  d_updated = true;
+  // Picked up by work at the start of its next call
+  d_new_taps.set(taps);
 }
 
 std::vector<gr_complex>
 gr_fft_filter_ccc::taps () const
 {
-  return d_new_taps;
+  return d_new_taps.latest();
 }
 
 void
@@ -115,11 +114,13 @@ gr_fft_filter_ccc::work (int noutput_items,
   const gr_complex *in = (const gr_complex *) input_items[0];
   gr_complex *out = (gr_complex *) output_items[0];
 
-  if (d_updated){
-    d_nsamples = d_filter->set_taps(d_new_taps);
-    d_updated = false;
-    set_output_multiple(d_nsamples);
-    return 0;				// output multiple may have changed
+  if (d_new_taps.update()){
+    int nsamples = d_filter->set_taps(d_new_taps.current());
+    if (nsamples != d_nsamples){
+      d_nsamples = nsamples;
+      set_output_multiple(d_nsamples);
+      return 0;				// output multiple has changed
+    }
   }
 
   assert(noutput_items % d_nsamples == 0);
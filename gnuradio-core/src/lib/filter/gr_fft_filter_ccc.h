@@ -24,6 +24,7 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_decimator.h>
+#include <gri_double_buffer.h>
 
 class gr_fft_filter_ccc;
 typedef boost::shared_ptr<gr_fft_filter_ccc> gr_fft_filter_ccc_sptr;
@@ -46,13 +47,12 @@ class GR_CORE_API gr_fft_filter_ccc : public gr_sync_decimator
 			    int nthreads);
 
   int			   d_nsamples;
-  bool			   d_updated;
 #if 1  // don't enable the sse version until handling it is worked out
   gri_fft_filter_ccc_generic  *d_filter;
 #else
   gri_fft_filter_ccc_sse  *d_filter;
 #endif
-  std::vector<gr_complex>  d_new_taps;
+  gri_double_buffer<std::vector<gr_complex> > d_new_taps;
 
   /*!
    * Construct a FFT filter with the given taps
@@ -49,7 +49,7 @@ gr_fft_filter_fff::gr_fft_filter_fff (int decimation,
 		       gr_make_io_signature (1, 1, sizeof (float)),
 		       gr_make_io_signature (1, 1, sizeof (float)),
 		       decimation),
-    d_updated(false)
+    d_new_taps(taps)
 {
   set_history(1);
 
@@ -59,7 +59,6 @@ gr_fft_filter_fff::gr_fft_filter_fff (int decimation,
     d_filter = new gri_fft_filter_fff_sse(decimation, taps);
 #endif
 
-  d_new_taps = taps;
   d_nsamples = d_filter->set_taps(taps);
   set_output_multiple(d_nsamples);
 }
@@ -72,14 +71,14 @@ gr_fft_filter_fff::~gr_fft_filter_fff ()
 void
 gr_fft_filter_fff::set_taps (const std::vector<float> &taps)
 {
-  d_new_taps = taps;
-  d_updated = true;
+  // Picked up by work at the start of its next call
+  d_new_taps.set(taps);
 }
 
 std::vector<float>
 gr_fft_filter_fff::taps () const
 {
-  return d_new_taps;
+  return d_new_taps.latest();
 }
 
 void
@@ -106,11 +105,13 @@ gr_fft_filter_fff::work (int noutput_items,
   const float *in = (const float *) input_items[0];
   float *out = (float *) output_items[0];
 
-  if (d_updated){
-    d_nsamples = d_filter->set_taps(d_new_taps);
-    d_updated = false;
-    set_output_multiple(d_nsamples);
-    return 0;				// output multiple may have changed
+  if (d_new_taps.update()){
+    int nsamples = d_filter->set_taps(d_new_taps.current());
+    if (nsamples != d_nsamples){
+      d_nsamples = nsamples;
+      set_output_multiple(d_nsamples);
+      return 0;				// output multiple has changed
+    }
   }
 
   assert(noutput_items % d_nsamples == 0);
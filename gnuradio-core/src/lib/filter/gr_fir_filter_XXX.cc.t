@@ -45,7 +45,7 @@
 		       gr_make_io_signature (1, 1, sizeof (@I_TYPE@)),
 		       gr_make_io_signature (1, 1, sizeof (@O_TYPE@)),
 		       decimation),
-    d_updated (false)
+    d_new_taps (taps)
 {
   d_fir = gr_fir_util::create_@FIR_TYPE@ (taps);
   set_history (d_fir->ntaps ());
@@ -59,14 +59,14 @@
 void
 @NAME@::set_taps (const std::vector<@TAP_TYPE@> &taps)
 {
-  d_new_taps = taps;
-  d_updated = true;
+  // Picked up by work at the start of its next call
+  d_new_taps.set (taps);
 }
 
 std::vector<@TAP_TYPE@>
 @NAME@::taps () const
 {
-  return d_new_taps;
+  return d_new_taps.latest ();
 }
 
 int
@@ -77,11 +77,12 @@ int
   @I_TYPE@ *in = (@I_TYPE@ *) input_items[0];
   @O_TYPE@ *out = (@O_TYPE@ *) output_items[0];
 
-  if (d_updated) {
-    d_fir->set_taps (d_new_taps);
-    set_history (d_fir->ntaps ());
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
+  if (d_new_taps.update ()) {
+    d_fir->set_taps (d_new_taps.current ());
+    if (history () != d_fir->ntaps ()) {
+      set_history (d_fir->ntaps ());
+      return 0;		     // history requirements have changed.
+    }
   }
 
   if (decimation() == 1)
@@ -30,6 +30,7 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_decimator.h>
+#include <gri_double_buffer.h>
 
 class @NAME@;
 typedef boost::shared_ptr<@NAME@> @SPTR_NAME@;
@@ -47,8 +48,7 @@ class GR_CORE_API @NAME@ : public gr_sync_decimator
   friend GR_CORE_API @SPTR_NAME@ gr_make_@BASE_NAME@ (int decimation, const std::vector<@TAP_TYPE@> &taps);
 
   @FIR_TYPE@		*d_fir;
-  std::vector<@TAP_TYPE@>	d_new_taps;
-  bool			d_updated;
+  gri_double_buffer<std::vector<@TAP_TYPE@> > d_new_taps;
 
   /*!
    * Construct a FIR filter with the given taps
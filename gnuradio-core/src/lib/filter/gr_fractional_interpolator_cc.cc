@@ -76,9 +76,14 @@ gr_fractional_interpolator_cc::general_work(int noutput_items,
   int 	ii = 0;				// input index
   int  	oo = 0;				// output index
 
-  while (oo < noutput_items) {
+  d_offsets.resize(noutput_items);
+  d_mus.resize(noutput_items);
 
-    out[oo++] = d_interp->interpolate(&in[ii], d_mu);
+  // The sample positions do not depend on the output values, so work
+  // them all out first and interpolate the whole batch in one call.
+  while (oo < noutput_items) {
+    d_offsets[oo] = ii;
+    d_mus[oo++] = d_mu;
 
     double s = d_mu + d_mu_inc;
     double f = floor (s);
@@ -87,6 +92,8 @@ gr_fractional_interpolator_cc::general_work(int noutput_items,
     ii += incr;
   }
 
+  d_interp->interpolate_n(out, in, &d_offsets[0], &d_mus[0], noutput_items);
+
   consume_each (ii);
 
   return noutput_items;
@@ -25,6 +25,7 @@
 
 #include <gr_core_api.h>
 #include <gr_block.h>
+#include <vector>
 
 class gri_mmse_fir_interpolator_cc;
 
@@ -60,6 +61,8 @@ private:
   float 			d_mu;
   float 			d_mu_inc;
   gri_mmse_fir_interpolator_cc 	*d_interp;
+  std::vector<int>		d_offsets;
+  std::vector<float>		d_mus;
 
   friend GR_CORE_API gr_fractional_interpolator_cc_sptr
   gr_make_fractional_interpolator_cc (float phase_shift, float interp_ratio);
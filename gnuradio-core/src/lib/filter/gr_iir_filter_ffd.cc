@@ -43,7 +43,7 @@ gr_iir_filter_ffd::gr_iir_filter_ffd (const std::vector<double> &fftaps,
 		   gr_make_io_signature (1, 1, sizeof (float)),
 		   gr_make_io_signature (1, 1, sizeof (float))),
     d_iir (fftaps, fbtaps),
-    d_updated (false)
+    d_new_taps (std::make_pair (fftaps, fbtaps))
 {
   // fprintf (stderr, "gr_iir_filter_ffd::ctor\n");
 }
@@ -57,10 +57,8 @@ void
 gr_iir_filter_ffd::set_taps (const std::vector<double> &fftaps,
 			     const std::vector<double> &fbtaps) throw (std::invalid_argument)
 {
-
-  d_new_fftaps = fftaps;
-  d_new_fbtaps = fbtaps;
-  d_updated = true;
+  // Picked up by work at the start of its next call
+  d_new_taps.set (std::make_pair (fftaps, fbtaps));
 }
 
 int
@@ -72,10 +70,8 @@ gr_iir_filter_ffd::work (int noutput_items,
   float *out = (float *) output_items[0];
 
 
-  if (d_updated){
-    d_iir.set_taps (d_new_fftaps, d_new_fbtaps);
-    d_updated = false;
-  }
+  if (d_new_taps.update ())
+    d_iir.set_taps (d_new_taps.current ().first, d_new_taps.current ().second);
 
   d_iir.filter_n (out, in, noutput_items);
   return noutput_items;
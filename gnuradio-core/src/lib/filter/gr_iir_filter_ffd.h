@@ -26,6 +26,7 @@
 #include <gr_core_api.h>
 #include <gr_sync_block.h>
 #include <gri_iir.h>
+#include <gri_double_buffer.h>
 #include <stdexcept>
 
 class gr_iir_filter_ffd;
@@ -75,9 +76,8 @@ class GR_CORE_API gr_iir_filter_ffd : public gr_sync_block
 			  const std::vector<double> &fbtaps) throw (std::invalid_argument);
 
   gri_iir<float,float,double>		d_iir;
-  std::vector<double>			d_new_fftaps;
-  std::vector<double>			d_new_fbtaps;
-  bool					d_updated;
+  // feed-forward and feedback taps from set_taps
+  gri_double_buffer<std::pair<std::vector<double>, std::vector<double> > > d_new_taps;
 
   /*!
    * Construct an IIR filter with the given taps
@@ -0,0 +1,74 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gr_iir_sos_filter_ccd.h>
+#include <gr_io_signature.h>
+
+gr_iir_sos_filter_ccd_sptr
+gr_make_iir_sos_filter_ccd (const std::vector<double> &fftaps,
+                            const std::vector<double> &fbtaps) throw (std::invalid_argument)
+{
+  return gnuradio::get_initial_sptr(new gr_iir_sos_filter_ccd (fftaps, fbtaps));
+}
+
+gr_iir_sos_filter_ccd::gr_iir_sos_filter_ccd (const std::vector<double> &fftaps,
+                                               const std::vector<double> &fbtaps) throw (std::invalid_argument)
+
+  : gr_sync_block ("iir_sos_filter_ccd",
+		   gr_make_io_signature (1, 1, sizeof (gr_complex)),
+		   gr_make_io_signature (1, 1, sizeof (gr_complex))),
+    d_new_sos (gri_iir_tf2sos (fftaps, fbtaps))
+{
+  d_iir.set_sos (d_new_sos.latest ());
+}
+
+gr_iir_sos_filter_ccd::~gr_iir_sos_filter_ccd ()
+{
+}
+
+void
+gr_iir_sos_filter_ccd::set_taps (const std::vector<double> &fftaps,
+                                 const std::vector<double> &fbtaps) throw (std::invalid_argument)
+{
+  // Factor here, so bad taps are reported to the caller, and let
+  // work pick the sections up at the start of its next call.
+  d_new_sos.set (gri_iir_tf2sos (fftaps, fbtaps));
+}
+
+int
+gr_iir_sos_filter_ccd::work (int noutput_items,
+                             gr_vector_const_void_star &input_items,
+                             gr_vector_void_star &output_items)
+{
+  const gr_complex *in = (const gr_complex *) input_items[0];
+  gr_complex *out = (gr_complex *) output_items[0];
+
+  if (d_new_sos.update ())
+    d_iir.set_sos (d_new_sos.current ());
+
+  d_iir.filter_n (out, in, noutput_items);
+  return noutput_items;
+}
@@ -0,0 +1,78 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GR_IIR_SOS_FILTER_FFD_H
+#define	INCLUDED_GR_IIR_SOS_FILTER_FFD_H
+
+#include <gr_core_api.h>
+#include <gr_sync_block.h>
+#include <gri_iir_sos.h>
+#include <gri_double_buffer.h>
+#include <gr_complex.h>
+#include <stdexcept>
+
+class gr_iir_sos_filter_ffd;
+typedef boost::shared_ptr<gr_iir_sos_filter_ffd> gr_iir_sos_filter_ffd_sptr;
+GR_CORE_API gr_iir_sos_filter_ffd_sptr
+gr_make_iir_sos_filter_ffd (const std::vector<double> &fftaps,
+                            const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+/*!
+ * \brief IIR filter with float input, float output and double taps,
+ * run as a cascade of second order sections
+ * \ingroup filter_blk
+ *
+ * Takes the same taps as gr_iir_filter_ffd and produces the same
+ * output, but factors the filter into second order sections with
+ * gri_iir_tf2sos and evaluates them one after another in double
+ * precision.  High order designs that are unstable or inaccurate as a
+ * single difference equation behave as designed this way.
+ */
+class GR_CORE_API gr_iir_sos_filter_ffd : public gr_sync_block
+{
+ private:
+  friend GR_CORE_API gr_iir_sos_filter_ffd_sptr
+  gr_make_iir_sos_filter_ffd (const std::vector<double> &fftaps,
+                              const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+  gri_iir_sos<float,float,double>	d_iir;
+  // sections from set_taps
+  gri_double_buffer<std::vector<double> > d_new_sos;
+
+  /*!
+   * Construct an IIR filter with the given taps
+   */
+  gr_iir_sos_filter_ffd (const std::vector<double> &fftaps,
+                        const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+ public:
+  ~gr_iir_sos_filter_ffd ();
+
+  void set_taps (const std::vector<double> &fftaps,
+		 const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+  int work (int noutput_items,
+	    gr_vector_const_void_star &input_items,
+	    gr_vector_void_star &output_items);
+};
+
+#endif
@@ -0,0 +1,111 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gr_iir_sos_filter_mc_ccd.h>
+#include <gr_io_signature.h>
+#include <gr_complex.h>
+#include <algorithm>
+
+// Frames filtered per call to gri_iir_sos_lanes::filter_n.
+static const int CHUNK = 512;
+
+gr_iir_sos_filter_mc_ccd_sptr
+gr_make_iir_sos_filter_mc_ccd (const std::vector<double> &fftaps,
+                               const std::vector<double> &fbtaps) throw (std::invalid_argument)
+{
+  return gnuradio::get_initial_sptr(new gr_iir_sos_filter_mc_ccd (fftaps, fbtaps));
+}
+
+gr_iir_sos_filter_mc_ccd::gr_iir_sos_filter_mc_ccd (const std::vector<double> &fftaps,
+                                                     const std::vector<double> &fbtaps) throw (std::invalid_argument)
+
+  : gr_sync_block ("iir_sos_filter_mc_ccd",
+		   gr_make_io_signature (1, gri_iir_sos_lanes::NLANES / 2, sizeof (gr_complex)),
+		   gr_make_io_signature (1, gri_iir_sos_lanes::NLANES / 2, sizeof (gr_complex))),
+    d_new_sos (gri_iir_tf2sos (fftaps, fbtaps)),
+    d_frames (CHUNK * gri_iir_sos_lanes::NLANES, 0)
+{
+  d_iir = new gri_iir_sos_lanes (d_new_sos.latest ());
+}
+
+gr_iir_sos_filter_mc_ccd::~gr_iir_sos_filter_mc_ccd ()
+{
+  delete d_iir;
+}
+
+bool
+gr_iir_sos_filter_mc_ccd::check_topology (int ninputs, int noutputs)
+{
+  return ninputs == noutputs;
+}
+
+void
+gr_iir_sos_filter_mc_ccd::set_taps (const std::vector<double> &fftaps,
+                                    const std::vector<double> &fbtaps) throw (std::invalid_argument)
+{
+  // Factor here, so bad taps are reported to the caller, and let
+  // work pick the sections up at the start of its next call.
+  d_new_sos.set (gri_iir_tf2sos (fftaps, fbtaps));
+}
+
+int
+gr_iir_sos_filter_mc_ccd::work (int noutput_items,
+                                gr_vector_const_void_star &input_items,
+                                gr_vector_void_star &output_items)
+{
+  const int L = gri_iir_sos_lanes::NLANES;
+  int nstreams = input_items.size ();
+
+  if (d_new_sos.update ())
+    d_iir->set_sos (d_new_sos.current ());
+
+  for (int start = 0; start < noutput_items; start += CHUNK){
+    int n = std::min (CHUNK, noutput_items - start);
+
+    // Filtering is in place, so feed zeros to the lanes with no
+    // channel behind them rather than their own previous outputs.
+    for (int i = 0; i < n; i++)
+      std::fill (&d_frames[i * L + 2 * nstreams], &d_frames[(i + 1) * L], 0.0f);
+
+    for (int c = 0; c < nstreams; c++){
+      const gr_complex *in = (const gr_complex *) input_items[c] + start;
+      for (int i = 0; i < n; i++){
+	d_frames[i * L + 2 * c] = in[i].real ();
+	d_frames[i * L + 2 * c + 1] = in[i].imag ();
+      }
+    }
+
+    d_iir->filter_n (&d_frames[0], &d_frames[0], n);
+
+    for (int c = 0; c < nstreams; c++){
+      gr_complex *out = (gr_complex *) output_items[c] + start;
+      for (int i = 0; i < n; i++)
+	out[i] = gr_complex (d_frames[i * L + 2 * c], d_frames[i * L + 2 * c + 1]);
+    }
+  }
+
+  return noutput_items;
+}
@@ -0,0 +1,80 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GR_IIR_SOS_FILTER_MC_FFD_H
+#define	INCLUDED_GR_IIR_SOS_FILTER_MC_FFD_H
+
+#include <gr_core_api.h>
+#include <gr_sync_block.h>
+#include <gri_iir_sos.h>
+#include <gri_double_buffer.h>
+#include <stdexcept>
+
+class gr_iir_sos_filter_mc_ffd;
+typedef boost::shared_ptr<gr_iir_sos_filter_mc_ffd> gr_iir_sos_filter_mc_ffd_sptr;
+GR_CORE_API gr_iir_sos_filter_mc_ffd_sptr
+gr_make_iir_sos_filter_mc_ffd (const std::vector<double> &fftaps,
+                               const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+/*!
+ * \brief Multichannel IIR filter with float inputs, float outputs and double taps,
+ * run as a cascade of second order sections
+ * \ingroup filter_blk
+ *
+ * Applies the same filter to each of its input streams, writing the
+ * result to the matching output.  The taps are factored with
+ * gri_iir_tf2sos and the streams are filtered side by side in the
+ * single precision lanes of gri_iir_sos_lanes, so filtering several
+ * streams costs little more than filtering one.
+ */
+class GR_CORE_API gr_iir_sos_filter_mc_ffd : public gr_sync_block
+{
+ private:
+  friend GR_CORE_API gr_iir_sos_filter_mc_ffd_sptr
+  gr_make_iir_sos_filter_mc_ffd (const std::vector<double> &fftaps,
+                                 const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+  gri_iir_sos_lanes	       *d_iir;
+  // sections from set_taps
+  gri_double_buffer<std::vector<double> > d_new_sos;
+  std::vector<float>		d_frames;	// interleaved lanes for d_iir
+
+  /*!
+   * Construct an IIR filter with the given taps
+   */
+  gr_iir_sos_filter_mc_ffd (const std::vector<double> &fftaps,
+                           const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+ public:
+  ~gr_iir_sos_filter_mc_ffd ();
+
+  bool check_topology (int ninputs, int noutputs);
+
+  void set_taps (const std::vector<double> &fftaps,
+		 const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+  int work (int noutput_items,
+	    gr_vector_const_void_star &input_items,
+	    gr_vector_void_star &output_items);
+};
+
+#endif
@@ -30,6 +30,7 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_interpolator.h>
+#include <gri_double_buffer.h>
 
 class @NAME@;
 typedef boost::shared_ptr<@NAME@> @SPTR_NAME@;
@@ -46,8 +47,7 @@ class GR_CORE_API @NAME@ : public gr_sync_interpolator
  private:
   friend GR_CORE_API @SPTR_NAME@ gr_make_@BASE_NAME@ (unsigned interpolation, const std::vector<@TAP_TYPE@> &taps);
 
-  std::vector<@TAP_TYPE@>	d_new_taps;
-  bool			d_updated;
+  gri_double_buffer<std::vector<@TAP_TYPE@> > d_new_taps;
   std::vector<@FIR_TYPE@ *> d_firs;
 
   /*!
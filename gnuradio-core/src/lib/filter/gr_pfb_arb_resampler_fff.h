@@ -26,6 +26,7 @@
 
 #include <gr_core_api.h>
 #include <gr_block.h>
+#include <gri_double_buffer.h>
 
 class gr_pfb_arb_resampler_fff;
 typedef boost::shared_ptr<gr_pfb_arb_resampler_fff> gr_pfb_arb_resampler_fff_sptr;
@@ -33,7 +34,7 @@ GR_CORE_API gr_pfb_arb_resampler_fff_sptr gr_make_pfb_arb_resampler_fff (float r
 							     const std::vector<float> &taps,
 							     unsigned int filter_size=32);
 
-class gr_fir_fff;
+class gri_pfb_arb_resampler_fff;
 
 /*!
  * \class gr_pfb_arb_resampler_fff
@@ -113,18 +114,9 @@ class GR_CORE_API gr_pfb_arb_resampler_fff : public gr_block
 								      const std::vector<float> &taps,
 								      unsigned int filter_size);
 
-  std::vector<gr_fir_fff*> d_filters;
-  std::vector<gr_fir_fff*> d_diff_filters;
-  std::vector< std::vector<float> > d_taps;
-  std::vector< std::vector<float> > d_dtaps;
-  unsigned int             d_int_rate;          // the number of filters (interpolation rate)
-  unsigned int             d_dec_rate;          // the stride through the filters (decimation rate)
-  float                    d_flt_rate;          // residual rate for the linear interpolation
-  float                    d_acc;
-  unsigned int             d_last_filter;
-  int                      d_start_index;
-  unsigned int             d_taps_per_filter;
-  bool			   d_updated;
+  gri_pfb_arb_resampler_fff *d_resamp;
+  gri_double_buffer<std::vector<float> > d_new_taps;  // set_taps -> work
+  gri_double_buffer<float> d_new_rate;                 // set_rate -> work
 
   /*!
    * Build the polyphase filterbank arbitray resampler.
@@ -139,35 +131,27 @@ class GR_CORE_API gr_pfb_arb_resampler_fff : public gr_block
 			    const std::vector<float> &taps,
 			    unsigned int filter_size);
 
-  void create_diff_taps(const std::vector<float> &newtaps,
-			std::vector<float> &difftaps);
-
-  /*!
-   * Resets the filterbank's filter taps with the new prototype filter
-   * \param newtaps    (vector of floats) The prototype filter to populate the filterbank.
-   *                   The taps should be generated at the interpolated sampling rate.
-   * \param ourtaps    (vector of floats) Reference to our internal member of holding the taps.
-   * \param ourfilter  (vector of filters) Reference to our internal filter to set the taps for.
-   */
-  void create_taps (const std::vector<float> &newtaps,
-		    std::vector< std::vector<float> > &ourtaps,
-		    std::vector<gr_fir_fff*> &ourfilter);
-
-
 public:
   ~gr_pfb_arb_resampler_fff ();
 
-  // FIXME: See about a set_taps function during runtime.
+  /*!
+   * Resets the filterbank's filter taps with the new prototype filter.
+   * The new taps are installed at the start of the next call to
+   * general_work.
+   * \param taps  (vector/list of floats) The prototype filter to populate the filterbank.
+   */
+  void set_taps (const std::vector<float> &taps);
 
   /*!
    * Print all of the filterbank taps to screen.
    */
   void print_taps();
-  void set_rate (float rate) {
-    d_dec_rate = (unsigned int)floor(d_int_rate/rate);
-    d_flt_rate = (d_int_rate/rate) - d_dec_rate;
-    set_relative_rate(rate);
-  }
+
+  /*!
+   * Sets the resampling rate; takes effect at the start of the next
+   * call to general_work.
+   */
+  void set_rate (float rate);
 
   int general_work (int noutput_items,
 		    gr_vector_int &ninput_items,
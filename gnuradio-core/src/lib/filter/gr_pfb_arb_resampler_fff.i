@@ -36,7 +36,7 @@ class gr_pfb_arb_resampler_fff : public gr_block
  public:
   ~gr_pfb_arb_resampler_fff ();
 
-  //void set_taps (const std::vector<float> &taps);
+  void set_taps (const std::vector<float> &taps);
   void print_taps();
   void set_rate (float rate);
 };
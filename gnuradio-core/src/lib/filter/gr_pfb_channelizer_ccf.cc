@@ -25,12 +25,13 @@
 #endif
 
 #include <gr_pfb_channelizer_ccf.h>
-#include <gr_fir_ccf.h>
-#include <gr_fir_util.h>
-#include <gri_fft.h>
+#include <gri_pfb_channelizer_ccf.h>
+#include <gri_pfb_partition_taps.h>
 #include <gr_io_signature.h>
 #include <cstdio>
 #include <cstring>
+#include <stdexcept>
+#include <algorithm>
 
 gr_pfb_channelizer_ccf_sptr gr_make_pfb_channelizer_ccf (unsigned int numchans,
 							 const std::vector<float> &taps,
@@ -47,7 +48,8 @@ gr_pfb_channelizer_ccf::gr_pfb_channelizer_ccf (unsigned int numchans,
   : gr_block ("pfb_channelizer_ccf",
 	      gr_make_io_signature (numchans, numchans, sizeof(gr_complex)),
 	      gr_make_io_signature (1, numchans, sizeof(gr_complex))),
-    d_updated (false), d_numchans(numchans), d_oversample_rate(oversample_rate)
+    d_numchans(numchans), d_oversample_rate(oversample_rate),
+    d_new_taps(taps)
 {
   // The over sampling rate must be rationally related to the number of channels
   // in that it must be N/i for i in [1,N], which gives an outputsample rate
@@ -61,94 +63,44 @@ gr_pfb_channelizer_ccf::gr_pfb_channelizer_ccf (unsigned int numchans,
 
   set_relative_rate(1.0/intp);
 
-  d_filters = std::vector<gr_fir_ccf*>(d_numchans);
-  d_channel_map.resize(d_numchans);
-
-  // Create an FIR filter for each channel and zero out the taps
-  std::vector<float> vtaps(0, d_numchans);
+  std::vector<int> map(d_numchans);
   for(unsigned int i = 0; i < d_numchans; i++) {
-    d_filters[i] = gr_fir_util::create_gr_fir_ccf(vtaps);
-    d_channel_map[i] = i;
+    map[i] = i;
   }
+  d_channel_map.set(map);
+  d_channel_map.update();
 
-  // Now, actually set the filters' taps
-  set_taps(taps);
-
-  // Create the FFT to handle the output de-spinning of the channels
-  d_fft = new gri_fft_complex (d_numchans, false);
+  int rate_ratio = (int)rintf(d_numchans / d_oversample_rate);
+  d_engine = new gri_pfb_channelizer_ccf(d_numchans, taps, rate_ratio);
 
-  // Although the filters change, we use this look up table
-  // to set the index of the FFT input buffer, which equivalently
-  // performs the FFT shift operation on every other turn.
-  d_rate_ratio = (int)rintf(d_numchans / d_oversample_rate);
-  d_idxlut = new int[d_numchans];
-  for(unsigned int i = 0; i < d_numchans; i++) {
-    d_idxlut[i] = d_numchans - ((i + d_rate_ratio) % d_numchans) - 1;
-  }
+  // Set the history to ensure enough input items for each filter
+  set_history (d_engine->taps_per_filter()+1);
 
-  // Calculate the number of filtering rounds to do to evenly
-  // align the input vectors with the output channels
-  d_output_multiple = 1;
-  while((d_output_multiple * d_rate_ratio) % d_numchans != 0)
-    d_output_multiple++;
-  set_output_multiple(d_output_multiple);
+  // Filter in whole rounds to evenly align the input vectors with
+  // the output channels
+  set_output_multiple(d_engine->output_multiple());
 }
 
 gr_pfb_channelizer_ccf::~gr_pfb_channelizer_ccf ()
 {
-  delete [] d_idxlut;
-
-  for(unsigned int i = 0; i < d_numchans; i++) {
-    delete d_filters[i];
-  }
+  delete d_engine;
 }
 
 void
 gr_pfb_channelizer_ccf::set_taps (const std::vector<float> &taps)
 {
-  gruel::scoped_lock guard(d_mutex);
-  unsigned int i,j;
-
-  unsigned int ntaps = taps.size();
-  d_taps_per_filter = (unsigned int)ceil((double)ntaps/(double)d_numchans);
-
-  // Create d_numchan vectors to store each channel's taps
-  d_taps.resize(d_numchans);
-
-  // Make a vector of the taps plus fill it out with 0's to fill
-  // each polyphase filter with exactly d_taps_per_filter
-  std::vector<float> tmp_taps;
-  tmp_taps = taps;
-  while((float)(tmp_taps.size()) < d_numchans*d_taps_per_filter) {
-    tmp_taps.push_back(0.0);
-  }
-
-  // Partition the filter
-  for(i = 0; i < d_numchans; i++) {
-    // Each channel uses all d_taps_per_filter with 0's if not enough taps to fill out
-    d_taps[i] = std::vector<float>(d_taps_per_filter, 0);
-    for(j = 0; j < d_taps_per_filter; j++) {
-      d_taps[i][j] = tmp_taps[i + j*d_numchans];  // add taps to channels in reverse order
-    }
-
-    // Build a filter for each channel and add it's taps to it
-    d_filters[i]->set_taps(d_taps[i]);
-  }
-
-  // Set the history to ensure enough input items for each filter
-  set_history (d_taps_per_filter+1);
-
-  d_updated = true;
+  d_new_taps.set(taps);
 }
 
 void
 gr_pfb_channelizer_ccf::print_taps()
 {
+  std::vector< std::vector<float> > t = taps();
   unsigned int i, j;
-  for(i = 0; i < d_numchans; i++) {
+  for(i = 0; i < t.size(); i++) {
     printf("filter[%d]: [", i);
-    for(j = 0; j < d_taps_per_filter; j++) {
-      printf(" %.4e", d_taps[i][j]);
+    for(j = 0; j < t[i].size(); j++) {
+      printf(" %.4e", t[i][j]);
     }
     printf("]\n\n");
   }
@@ -157,28 +109,26 @@ gr_pfb_channelizer_ccf::print_taps()
 std::vector< std::vector<float> >
 gr_pfb_channelizer_ccf::taps() const
 {
-  return d_taps;
+  return gri_pfb_partition_taps(d_new_taps.latest(), d_numchans);
 }
 
 void
 gr_pfb_channelizer_ccf::set_channel_map(const std::vector<int> &map)
 {
-  gruel::scoped_lock guard(d_mutex);
-
   if(map.size() > 0) {
     unsigned int max = (unsigned int)*std::max_element(map.begin(), map.end());
-    unsigned int min = (unsigned int)*std::min_element(map.begin(), map.end());
+    int min = *std::min_element(map.begin(), map.end());
     if((max >= d_numchans) || (min < 0)) {
       throw std::invalid_argument("gr_pfb_channelizer_ccf::set_channel_map: map range out of bounds.\n");
     }
-    d_channel_map = map;
+    d_channel_map.set(map);
   }
 }
 
 std::vector<int>
 gr_pfb_channelizer_ccf::channel_map() const
 {
-  return d_channel_map;
+  return d_channel_map.latest();
 }
 
 
@@ -188,51 +138,22 @@ gr_pfb_channelizer_ccf::general_work (int noutput_items,
 				      gr_vector_const_void_star &input_items,
 				      gr_vector_void_star &output_items)
 {
-  gruel::scoped_lock guard(d_mutex);
-
-  gr_complex *in = (gr_complex *) input_items[0];
-  gr_complex *out = (gr_complex *) output_items[0];
-
-  if (d_updated) {
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
-  }
-
-  size_t noutputs = output_items.size();
-
-  int n=1, i=-1, j=0, oo=0, last;
-  int toconsume = (int)rintf(noutput_items/d_oversample_rate);
-  while(n <= toconsume) {
-    j = 0;
-    i = (i + d_rate_ratio) % d_numchans;
-    last = i;
-    while(i >= 0) {
-      in = (gr_complex*)input_items[j];
-      d_fft->get_inbuf()[d_idxlut[j]] = d_filters[i]->filter(&in[n]);
-      j++;
-      i--;
+  // Pick up new taps; only a change in length needs new history
+  if(d_new_taps.update()) {
+    unsigned int old_taps_per_filter = d_engine->taps_per_filter();
+    d_engine->set_taps(d_new_taps.current());
+    if(d_engine->taps_per_filter() != old_taps_per_filter) {
+      set_history(d_engine->taps_per_filter()+1);
+      return 0;		     // history requirements have changed.
     }
-
-    i = d_numchans-1;
-    while(i > last) {
-      in = (gr_complex*)input_items[j];
-      d_fft->get_inbuf()[d_idxlut[j]] = d_filters[i]->filter(&in[n-1]);
-      j++;
-      i--;
-    }
-
-    n += (i+d_rate_ratio) >= (int)d_numchans;
-
-    // despin through FFT
-    d_fft->execute();
-
-    // Send to output channels
-    for(unsigned int nn = 0; nn < noutputs; nn++) {
-      out = (gr_complex*)output_items[nn];
-      out[oo] = d_fft->get_outbuf()[d_channel_map[nn]];
-    }
-    oo++;
   }
+  d_channel_map.update();
+
+  int toconsume = d_engine->filter((gr_complex * const *)&output_items[0],
+				   &d_channel_map.current()[0],
+				   output_items.size(),
+				   (const gr_complex * const *)&input_items[0],
+				   noutput_items);
 
   consume_each(toconsume);
   return noutput_items;
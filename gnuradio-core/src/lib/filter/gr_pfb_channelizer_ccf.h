@@ -26,7 +26,7 @@
 
 #include <gr_core_api.h>
 #include <gr_block.h>
-#include <gruel/thread.h>
+#include <gri_double_buffer.h>
 
 class gr_pfb_channelizer_ccf;
 typedef boost::shared_ptr<gr_pfb_channelizer_ccf> gr_pfb_channelizer_ccf_sptr;
@@ -34,8 +34,7 @@ GR_CORE_API gr_pfb_channelizer_ccf_sptr gr_make_pfb_channelizer_ccf (unsigned in
 							 const std::vector<float> &taps,
 							 float oversample_rate=1);
 
-class gr_fir_ccf;
-class gri_fft_complex;
+class gri_pfb_channelizer_ccf;
 
 
 /*!
@@ -60,8 +59,7 @@ class gri_fft_complex;
  * filters in the filterbank are filled out with 0's to make sure each
  * filter has the same number of taps.
  *
- * Each filter operates using the gr_fir filter classs of GNU Radio,
- * which takes the input stream at <EM>i</EM> and performs the inner
+ * Each filter takes the input stream at <EM>i</EM> and performs the inner
  * product calculation to <EM>i+(n-1)</EM> where <EM>n</EM> is the
  * number of filter taps. To efficiently handle this in the GNU Radio
  * structure, each filter input must come from its own input
@@ -105,6 +103,12 @@ class gri_fft_complex;
  * ratio is 6000 Hz, or 6 times the normal 1000 Hz. A rate of 6/5 = 1.2,
  * so the output rate would be 1200 Hz.
  *
+ * The filtering itself is done by gri_pfb_channelizer_ccf, which
+ * keeps all of the filters in one tap matrix and despins a whole
+ * batch of output vectors per FFT plan execution. New taps and
+ * channel maps are picked up at the start of the next call to
+ * general_work, so setting them never blocks the work thread.
+ *
  * The theory behind this block can be found in Chapter 6 of
  * the following book.
  *
@@ -137,18 +141,11 @@ class GR_CORE_API gr_pfb_channelizer_ccf : public gr_block
 								  const std::vector<float> &taps,
 								  float oversample_rate);
 
-  bool			   d_updated;
   unsigned int             d_numchans;
   float                    d_oversample_rate;
-  std::vector<gr_fir_ccf*> d_filters;
-  std::vector< std::vector<float> > d_taps;
-  unsigned int             d_taps_per_filter;
-  gri_fft_complex         *d_fft;
-  int                     *d_idxlut;
-  int                      d_rate_ratio;
-  int                      d_output_multiple;
-  std::vector<int>         d_channel_map;
-  gruel::mutex             d_mutex; // mutex to protect set/work access
+  gri_pfb_channelizer_ccf *d_engine;
+  gri_double_buffer<std::vector<float> > d_new_taps;  // set_taps -> work
+  gri_double_buffer<std::vector<int> > d_channel_map; // set_channel_map -> work
 
   /*!
    * Build the polyphase filterbank decimator.
@@ -58,7 +58,7 @@ gr_pfb_clock_sync_ccf::gr_pfb_clock_sync_ccf (double sps, float loop_bw,
   : gr_block ("pfb_clock_sync_ccf",
 	      gr_make_io_signature (1, 1, sizeof(gr_complex)),
 	      gr_make_io_signaturev (1, 4, iosig)),
-    d_updated (false), d_nfilters(filter_size),
+    d_new_taps (taps), d_nfilters(filter_size),
     d_max_dev(max_rate_deviation),
     d_osps(osps), d_error(0), d_out_idx(0)
 {
@@ -246,8 +246,13 @@ gr_pfb_clock_sync_ccf::set_taps (const std::vector<float> &newtaps,
 
   // Make sure there is enough output space for d_osps outputs/input.
   set_output_multiple(d_osps);
+}
 
-  d_updated = true;
+void
+gr_pfb_clock_sync_ccf::set_taps (const std::vector<float> &taps)
+{
+  // Picked up by general_work at the start of its next call
+  d_new_taps.set(taps);
 }
 
 void
@@ -367,9 +372,14 @@ gr_pfb_clock_sync_ccf::general_work (int noutput_items,
     outk = (float*)output_items[3];
   }
 
-  if (d_updated) {
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
+  if (d_new_taps.update()) {
+    unsigned int old_history = history();
+    std::vector<float> dtaps;
+    create_diff_taps(d_new_taps.current(), dtaps);
+    set_taps(d_new_taps.current(), d_taps, d_filters);
+    set_taps(dtaps, d_dtaps, d_diff_filters);
+    if (history() != old_history)
+      return 0;		     // history requirements have changed.
   }
 
   // We need this many to process one output
@@ -26,6 +26,7 @@
 
 #include <gr_core_api.h>
 #include <gr_block.h>
+#include <gri_double_buffer.h>
 
 class gr_pfb_clock_sync_ccf;
 typedef boost::shared_ptr<gr_pfb_clock_sync_ccf> gr_pfb_clock_sync_ccf_sptr;
@@ -174,7 +175,7 @@ class GR_CORE_API gr_pfb_clock_sync_ccf : public gr_block
 								float max_rate_deviation,
 								int osps);
 
-  bool			            d_updated;
+  gri_double_buffer<std::vector<float> > d_new_taps;
   double                            d_sps;
   double                            d_sample_num;
   float                             d_loop_bw;
@@ -225,7 +226,14 @@ public:
   void update_gains();
 
   /*!
-   * Resets the filterbank's filter taps with the new prototype filter
+   * Resets the filterbank's filter taps with the new prototype
+   * filter. The new taps and their derivative are installed at the
+   * start of the next call to general_work.
+   */
+  void set_taps (const std::vector<float> &taps);
+
+  /*!
+   * Partitions \p taps into \p ourtaps and loads them into \p ourfilter
    */
   void set_taps (const std::vector<float> &taps,
 		 std::vector< std::vector<float> > &ourtaps,
@@ -55,7 +55,7 @@ gr_pfb_clock_sync_fff::gr_pfb_clock_sync_fff (double sps, float gain,
   : gr_block ("pfb_clock_sync_fff",
 	      gr_make_io_signature (1, 1, sizeof(float)),
 	      gr_make_io_signaturev (1, 4, iosig)),
-    d_updated (false), d_nfilters(filter_size),
+    d_new_taps (taps), d_nfilters(filter_size),
     d_max_dev(max_rate_deviation)
 {
   d_nfilters = filter_size;
@@ -138,8 +138,13 @@ gr_pfb_clock_sync_fff::set_taps (const std::vector<float> &newtaps,
 
   // Set the history to ensure enough input items for each filter
   set_history (d_taps_per_filter + d_sps);
+}
 
-  d_updated = true;
+void
+gr_pfb_clock_sync_fff::set_taps (const std::vector<float> &taps)
+{
+  // Picked up by general_work at the start of its next call
+  d_new_taps.set(taps);
 }
 
 void
@@ -233,9 +238,14 @@ gr_pfb_clock_sync_fff::general_work (int noutput_items,
     outk = (float*)output_items[3];
   }
 
-  if (d_updated) {
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
+  if (d_new_taps.update()) {
+    unsigned int old_history = history();
+    std::vector<float> dtaps;
+    create_diff_taps(d_new_taps.current(), dtaps);
+    set_taps(d_new_taps.current(), d_taps, d_filters);
+    set_taps(dtaps, d_dtaps, d_diff_filters);
+    if (history() != old_history)
+      return 0;		     // history requirements have changed.
   }
 
   // We need this many to process one output
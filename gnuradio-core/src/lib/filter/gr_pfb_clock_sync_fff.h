@@ -26,6 +26,7 @@
 
 #include <gr_core_api.h>
 #include <gr_block.h>
+#include <gri_double_buffer.h>
 
 class gr_pfb_clock_sync_fff;
 typedef boost::shared_ptr<gr_pfb_clock_sync_fff> gr_pfb_clock_sync_fff_sptr;
@@ -171,7 +172,7 @@ class GR_CORE_API gr_pfb_clock_sync_fff : public gr_block
 								float init_phase,
 								float max_rate_deviation);
 
-  bool			   d_updated;
+  gri_double_buffer<std::vector<float> > d_new_taps;
   double                   d_sps;
   double                   d_sample_num;
   float                    d_alpha;
@@ -205,7 +206,14 @@ public:
   ~gr_pfb_clock_sync_fff ();
 
   /*!
-   * Resets the filterbank's filter taps with the new prototype filter
+   * Resets the filterbank's filter taps with the new prototype
+   * filter. The new taps and their derivative are installed at the
+   * start of the next call to general_work.
+   */
+  void set_taps (const std::vector<float> &taps);
+
+  /*!
+   * Partitions \p taps into \p ourtaps and loads them into \p ourfilter
    */
   void set_taps (const std::vector<float> &taps,
 		 std::vector< std::vector<float> > &ourtaps,
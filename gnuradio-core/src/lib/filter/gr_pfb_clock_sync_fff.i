@@ -40,6 +40,7 @@ class gr_pfb_clock_sync_fff : public gr_block
  public:
   ~gr_pfb_clock_sync_fff ();
 
+  void set_taps (const std::vector<float> &taps);
   void set_taps (const std::vector<float> &taps,
 		 std::vector< std::vector<float> > &ourtaps,
 		 std::vector<gr_fir_fff*> &ourfilter);
@@ -46,7 +46,7 @@ gr_pfb_decimator_ccf::gr_pfb_decimator_ccf (unsigned int decim,
   : gr_sync_block ("pfb_decimator_ccf",
 		   gr_make_io_signature (decim, decim, sizeof(gr_complex)),
 		   gr_make_io_signature (1, 1, sizeof(gr_complex))),
-    d_updated (false)
+    d_new_taps (taps)
 {
   d_rate = decim;
   d_filters = std::vector<gr_fir_ccf*>(d_rate);
@@ -61,7 +61,7 @@ gr_pfb_decimator_ccf::gr_pfb_decimator_ccf (unsigned int decim,
   }
 
   // Now, actually set the filters' taps
-  set_taps(taps);
+  install_taps(taps);
 
   // Create the FFT to handle the output de-spinning of the channels
   d_fft = new gri_fft_complex (d_rate, false);
@@ -76,6 +76,13 @@ gr_pfb_decimator_ccf::~gr_pfb_decimator_ccf ()
 
 void
 gr_pfb_decimator_ccf::set_taps (const std::vector<float> &taps)
+{
+  // Picked up by work at the start of its next call
+  d_new_taps.set(taps);
+}
+
+void
+gr_pfb_decimator_ccf::install_taps (const std::vector<float> &taps)
 {
   unsigned int i,j;
 
@@ -107,8 +114,6 @@ gr_pfb_decimator_ccf::set_taps (const std::vector<float> &taps)
 
   // Set the history to ensure enough input items for each filter
   set_history (d_taps_per_filter);
-
-  d_updated = true;
 }
 
 void
@@ -134,9 +139,11 @@ gr_pfb_decimator_ccf::work (int noutput_items,
   gr_complex *in;
   gr_complex *out = (gr_complex *) output_items[0];
 
-  if (d_updated) {
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
+  if (d_new_taps.update()) {
+    unsigned int old_history = history();
+    install_taps(d_new_taps.current());
+    if (history() != old_history)
+      return 0;		     // history requirements have changed.
   }
 
   int i;
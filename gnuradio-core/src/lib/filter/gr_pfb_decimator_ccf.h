@@ -26,6 +26,7 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_block.h>
+#include <gri_double_buffer.h>
 
 class gr_pfb_decimator_ccf;
 typedef boost::shared_ptr<gr_pfb_decimator_ccf> gr_pfb_decimator_ccf_sptr;
@@ -113,7 +114,7 @@ class GR_CORE_API gr_pfb_decimator_ccf : public gr_sync_block
   unsigned int             d_rate;
   unsigned int             d_chan;
   unsigned int             d_taps_per_filter;
-  bool			   d_updated;
+  gri_double_buffer<std::vector<float> > d_new_taps;
   gr_complex              *d_rotator;
 
   /*!
@@ -126,6 +127,8 @@ class GR_CORE_API gr_pfb_decimator_ccf : public gr_sync_block
 			const std::vector<float> &taps,
 			unsigned int channel);
 
+  void install_taps (const std::vector<float> &taps);
+
 public:
   ~gr_pfb_decimator_ccf ();
 
@@ -43,7 +43,7 @@ gr_pfb_interpolator_ccf::gr_pfb_interpolator_ccf (unsigned int interp,
 			  gr_make_io_signature (1, 1, sizeof(gr_complex)),
 			  gr_make_io_signature (1, 1, sizeof(gr_complex)),
 			  interp),
-    d_updated (false)
+    d_new_taps (taps)
 {
   d_rate = interp;
   d_filters = std::vector<gr_fir_ccf*>(d_rate);
@@ -55,7 +55,7 @@ gr_pfb_interpolator_ccf::gr_pfb_interpolator_ccf (unsigned int interp,
   }
 
   // Now, actually set the filters' taps
-  set_taps(taps);
+  install_taps(taps);
 }
 
 gr_pfb_interpolator_ccf::~gr_pfb_interpolator_ccf ()
@@ -67,6 +67,13 @@ gr_pfb_interpolator_ccf::~gr_pfb_interpolator_ccf ()
 
 void
 gr_pfb_interpolator_ccf::set_taps (const std::vector<float> &taps)
+{
+  // Picked up by work at the start of its next call
+  d_new_taps.set(taps);
+}
+
+void
+gr_pfb_interpolator_ccf::install_taps (const std::vector<float> &taps)
 {
   unsigned int i,j;
 
@@ -99,8 +106,6 @@ gr_pfb_interpolator_ccf::set_taps (const std::vector<float> &taps)
 
   // Set the history to ensure enough input items for each filter
   set_history (d_taps_per_filter);
-
-  d_updated = true;
 }
 
 void
@@ -124,9 +129,11 @@ gr_pfb_interpolator_ccf::work (int noutput_items,
   gr_complex *in = (gr_complex *) input_items[0];
   gr_complex *out = (gr_complex *) output_items[0];
 
-  if (d_updated) {
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
+  if (d_new_taps.update()) {
+    unsigned int old_history = history();
+    install_taps(d_new_taps.current());
+    if (history() != old_history)
+      return 0;		     // history requirements have changed.
   }
 
   int i = 0, count = 0;
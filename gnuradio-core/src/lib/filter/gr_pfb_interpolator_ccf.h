@@ -26,6 +26,7 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_interpolator.h>
+#include <gri_double_buffer.h>
 
 class gr_pfb_interpolator_ccf;
 typedef boost::shared_ptr<gr_pfb_interpolator_ccf> gr_pfb_interpolator_ccf_sptr;
@@ -97,7 +98,7 @@ class GR_CORE_API gr_pfb_interpolator_ccf : public gr_sync_interpolator
   std::vector< std::vector<float> > d_taps;
   unsigned int             d_rate;
   unsigned int             d_taps_per_filter;
-  bool			   d_updated;
+  gri_double_buffer<std::vector<float> > d_new_taps;
 
   /*!
    * Construct a Polyphase filterbank interpolator
@@ -108,6 +109,8 @@ class GR_CORE_API gr_pfb_interpolator_ccf : public gr_sync_interpolator
   gr_pfb_interpolator_ccf (unsigned int interp,
 			   const std::vector<float> &taps);
 
+  void install_taps (const std::vector<float> &taps);
+
 public:
   ~gr_pfb_interpolator_ccf ();
 
@@ -26,6 +26,7 @@
 
 #include <gr_pfb_synthesizer_ccf.h>
 #include <gri_fft.h>
+#include <gri_pfb_partition_taps.h>
 #include <gr_io_signature.h>
 #include <cstdio>
 #include <cstring>
@@ -44,7 +45,7 @@ gr_pfb_synthesizer_ccf::gr_pfb_synthesizer_ccf
 			  gr_make_io_signature (1, numchans, sizeof(gr_complex)),
 			  gr_make_io_signature (1, 1, sizeof(gr_complex)),
 			  numchans),
-    d_updated (false), d_numchans(numchans), d_state(0)
+    d_numchans(numchans), d_state(0), d_new_taps(taps)
 {
   // set up 2x multiplier; if twox==True, set to 2, otherwise to 1
   d_twox = (twox ? 2 : 1);
@@ -53,17 +54,19 @@ gr_pfb_synthesizer_ccf::gr_pfb_synthesizer_ccf
   }
 
   d_filters = std::vector<gri_fir_filter_with_buffer_ccf*>(d_twox*d_numchans);
-  d_channel_map.resize(d_twox*d_numchans);
+  std::vector<int> map(d_twox*d_numchans);
 
   // Create an FIR filter for each channel and zero out the taps
   std::vector<float> vtaps(0, d_twox*d_numchans);
   for(unsigned int i = 0; i < d_twox*d_numchans; i++) {
     d_filters[i] = new gri_fir_filter_with_buffer_ccf(vtaps);
-    d_channel_map[i] = i;
+    map[i] = i;
   }
+  d_channel_map.set(map);
+  d_channel_map.update();
 
   // Now, actually set the filters' taps
-  set_taps(taps);
+  install_taps(taps);
 
   // Create the IFFT to handle the input channel rotations
   d_fft = new gri_fft_complex (d_twox*d_numchans, false);
@@ -82,110 +85,52 @@ gr_pfb_synthesizer_ccf::~gr_pfb_synthesizer_ccf ()
 void
 gr_pfb_synthesizer_ccf::set_taps(const std::vector<float> &taps)
 {
-  gruel::scoped_lock guard(d_mutex);
-  if(d_twox == 1)
-    set_taps1(taps);
-  else
-    set_taps2(taps);
+  // Picked up by work at the start of its next call
+  d_new_taps.set(taps);
 }
 
 void
-gr_pfb_synthesizer_ccf::set_taps1(const std::vector<float> &taps)
+gr_pfb_synthesizer_ccf::install_taps(const std::vector<float> &taps)
 {
-  unsigned int i,j;
-
-  unsigned int ntaps = taps.size();
-  d_taps_per_filter = (unsigned int)ceil((double)ntaps/(double)d_numchans);
-
-  // Create d_numchan vectors to store each channel's taps
-  d_taps.resize(d_numchans);
-
-  // Make a vector of the taps plus fill it out with 0's to fill
-  // each polyphase filter with exactly d_taps_per_filter
-  std::vector<float> tmp_taps;
-  tmp_taps = taps;
-  while((float)(tmp_taps.size()) < d_numchans*d_taps_per_filter) {
-    tmp_taps.push_back(0.0);
-  }
-
-  // Partition the filter
-  for(i = 0; i < d_numchans; i++) {
-    // Each channel uses all d_taps_per_filter with 0's if not enough taps to fill out
-    d_taps[i] = std::vector<float>(d_taps_per_filter, 0);
-    for(j = 0; j < d_taps_per_filter; j++) {
-      d_taps[i][j] = tmp_taps[i + j*d_numchans];  // add taps to channels in reverse order
-    }
+  std::vector< std::vector<float> > parts = partition_taps(taps);
+  d_taps_per_filter = parts[0].size();
 
-    // Build a filter for each channel and add it's taps to it
-    d_filters[i]->set_taps(d_taps[i]);
-  }
+  // Build a filter for each channel and add it's taps to it
+  for(unsigned int i = 0; i < parts.size(); i++)
+    d_filters[i]->set_taps(parts[i]);
 
   // Set the history to ensure enough input items for each filter
   set_history (d_taps_per_filter+1);
-
-  d_updated = true;
 }
 
-void
-gr_pfb_synthesizer_ccf::set_taps2 (const std::vector<float> &taps)
+std::vector< std::vector<float> >
+gr_pfb_synthesizer_ccf::partition_taps(const std::vector<float> &taps) const
 {
-  unsigned int i,j;
-  int state = 0;
-
-  unsigned int ntaps = taps.size();
-  d_taps_per_filter = (unsigned int)ceil((double)ntaps/(double)d_numchans);
-
-  // Create d_numchan vectors to store each channel's taps
-  d_taps.resize(d_twox*d_numchans);
-
-  // Make a vector of the taps plus fill it out with 0's to fill
-  // each polyphase filter with exactly d_taps_per_filter
-  std::vector<float> tmp_taps;
-  tmp_taps = taps;
-  while((float)(tmp_taps.size()) < d_numchans*d_taps_per_filter) {
-    tmp_taps.push_back(0.0);
-  }
-
-  // Partition the filter
-  for(i = 0; i < d_numchans; i++) {
-    // Each channel uses all d_taps_per_filter with 0's if not enough taps to fill out
-    d_taps[i] = std::vector<float>(d_taps_per_filter, 0);
-    d_taps[d_numchans+i] = std::vector<float>(d_taps_per_filter, 0);
-    state = 0;
-    for(j = 0; j < d_taps_per_filter; j++) {
-      // add taps to channels in reverse order
-      // Zero out every other tap
-      if(state == 0) {
-	d_taps[i][j] = tmp_taps[i + j*d_numchans];
-	d_taps[d_numchans + i][j] = 0;
-	state = 1;
-      }
-      else {
-	d_taps[i][j] = 0;
-	d_taps[d_numchans + i][j] = tmp_taps[i + j*d_numchans];
-	state = 0;
-      }
+  std::vector< std::vector<float> > parts = gri_pfb_partition_taps(taps, d_numchans);
+  if(d_twox == 1)
+    return parts;
+
+  // Filter numchans+i takes the odd taps of arm i, which keeps the even ones
+  parts.resize(2*d_numchans);
+  for(unsigned int i = 0; i < d_numchans; i++) {
+    parts[d_numchans+i] = std::vector<float>(parts[i].size(), 0);
+    for(unsigned int j = 1; j < parts[i].size(); j += 2) {
+      parts[d_numchans+i][j] = parts[i][j];
+      parts[i][j] = 0;
     }
-
-    // Build a filter for each channel and add it's taps to it
-    d_filters[i]->set_taps(d_taps[i]);
-    d_filters[d_numchans + i]->set_taps(d_taps[d_numchans + i]);
   }
-
-  // Set the history to ensure enough input items for each filter
-  set_history (d_taps_per_filter+1);
-
-  d_updated = true;
+  return parts;
 }
 
 void
 gr_pfb_synthesizer_ccf::print_taps()
 {
+  std::vector< std::vector<float> > t = taps();
   unsigned int i, j;
-  for(i = 0; i < d_twox*d_numchans; i++) {
+  for(i = 0; i < t.size(); i++) {
     printf("filter[%d]: [", i);
-    for(j = 0; j < d_taps_per_filter; j++) {
-      printf(" %.4e", d_taps[i][j]);
+    for(j = 0; j < t[i].size(); j++) {
+      printf(" %.4e", t[i][j]);
     }
     printf("]\n\n");
   }
@@ -195,31 +140,26 @@ gr_pfb_synthesizer_ccf::print_taps()
 std::vector< std::vector<float> >
 gr_pfb_synthesizer_ccf::taps() const
 {
-  return d_taps;
+  return partition_taps(d_new_taps.latest());
 }
 
 void
 gr_pfb_synthesizer_ccf::set_channel_map(const std::vector<int> &map)
 {
-  gruel::scoped_lock guard(d_mutex);
-
   if(map.size() > 0) {
     unsigned int max = (unsigned int)*std::max_element(map.begin(), map.end());
-    unsigned int min = (unsigned int)*std::min_element(map.begin(), map.end());
+    int min = *std::min_element(map.begin(), map.end());
     if((max >= d_twox*d_numchans) || (min < 0)) {
       throw std::invalid_argument("gr_pfb_synthesizer_ccf::set_channel_map: map range out of bounds.\n");
     }
-    d_channel_map = map;
-
-    // Zero out fft buffer so that unused channels are always 0
-    memset(d_fft->get_inbuf(), 0,d_twox*d_numchans*sizeof(gr_complex));
+    d_channel_map.set(map);
   }
 }
 
 std::vector<int>
 gr_pfb_synthesizer_ccf::channel_map() const
 {
-  return d_channel_map;
+  return d_channel_map.latest();
 }
 
 int
@@ -227,15 +167,21 @@ gr_pfb_synthesizer_ccf::work (int noutput_items,
 			      gr_vector_const_void_star &input_items,
 			      gr_vector_void_star &output_items)
 {
-  gruel::scoped_lock guard(d_mutex);
-
   gr_complex *in = (gr_complex*) input_items[0];
   gr_complex *out = (gr_complex *) output_items[0];
 
-  if (d_updated) {
-    d_updated = false;
-    return 0;		     // history requirements may have changed.
+  if (d_new_taps.update()) {
+    unsigned int old_history = history();
+    install_taps(d_new_taps.current());
+    if (history() != old_history)
+      return 0;		     // history requirements have changed.
+  }
+
+  if (d_channel_map.update()) {
+    // Zero out fft buffer so that unused channels are always 0
+    memset(d_fft->get_inbuf(), 0, d_twox*d_numchans*sizeof(gr_complex));
   }
+  const std::vector<int> &channel_map = d_channel_map.current();
 
   unsigned int n, i;
   size_t ninputs = input_items.size();
@@ -245,7 +191,7 @@ gr_pfb_synthesizer_ccf::work (int noutput_items,
     for(n = 0; n < noutput_items/d_numchans; n++) {
       for(i = 0; i < ninputs; i++) {
 	in = (gr_complex*)input_items[i];
-	d_fft->get_inbuf()[d_channel_map[i]] = in[n];
+	d_fft->get_inbuf()[channel_map[i]] = in[n];
       }
 
       // spin through IFFT
@@ -263,7 +209,7 @@ gr_pfb_synthesizer_ccf::work (int noutput_items,
     for(n = 0; n < noutput_items/d_numchans; n++) {
       for(i = 0; i < ninputs; i++) {
 	in = (gr_complex*)input_items[i];
-	d_fft->get_inbuf()[d_channel_map[i]] = in[n];
+	d_fft->get_inbuf()[channel_map[i]] = in[n];
       }
 
       // spin through IFFT
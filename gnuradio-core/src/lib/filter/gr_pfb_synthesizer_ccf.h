@@ -27,7 +27,7 @@
 #include <gr_core_api.h>
 #include <gr_sync_interpolator.h>
 #include <gri_fir_filter_with_buffer_ccf.h>
-#include <gruel/thread.h>
+#include <gri_double_buffer.h>
 
 class gr_pfb_synthesizer_ccf;
 typedef boost::shared_ptr<gr_pfb_synthesizer_ccf> gr_pfb_synthesizer_ccf_sptr;
@@ -61,26 +61,28 @@ class GR_CORE_API gr_pfb_synthesizer_ccf : public gr_sync_interpolator
   friend GR_CORE_API gr_pfb_synthesizer_ccf_sptr gr_make_pfb_synthesizer_ccf
     (unsigned int numchans, const std::vector<float> &taps, bool twox);
 
-  bool			   d_updated;
   unsigned int             d_numchans;
   unsigned int             d_taps_per_filter;
   gri_fft_complex         *d_fft;
   std::vector< gri_fir_filter_with_buffer_ccf*> d_filters;
-  std::vector< std::vector<float> > d_taps;
   int              d_state;
-  std::vector<int> d_channel_map;
   unsigned int     d_twox;
-  gruel::mutex     d_mutex; // mutex to protect set/work access
+  gri_double_buffer<std::vector<float> > d_new_taps;  // set_taps -> work
+  gri_double_buffer<std::vector<int> > d_channel_map; // set_channel_map -> work
 
   /*!
-   * \brief Tap setting algorithm for critically sampled channels
+   * \brief Partition \p taps into the filterbank
    */
-  void set_taps1(const std::vector<float> &taps);
+  void install_taps(const std::vector<float> &taps);
 
   /*!
-   * \brief Tap setting algorithm for 2x over-sampled channels
+   * \brief Split \p taps into the filterbank's polyphase filters.
+   *
+   * For 2x over-sampled channels the second half of the filters gets
+   * every other tap, and the first half the rest.
    */
-  void set_taps2(const std::vector<float> &taps);
+  std::vector< std::vector<float> >
+    partition_taps(const std::vector<float> &taps) const;
 
   /*!
    * Build the polyphase synthesis filterbank.
@@ -0,0 +1,197 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gr_pfb_xlating_decimator_ccf.h>
+#include <gr_fir_ccf.h>
+#include <gr_fir_util.h>
+#include <gri_pfb_partition_taps.h>
+#include <gr_io_signature.h>
+#include <gr_expj.h>
+#include <volk/volk.h>
+#include <cstdio>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+gr_pfb_xlating_decimator_ccf_sptr gr_make_pfb_xlating_decimator_ccf (unsigned int decim,
+								     const std::vector<float> &taps,
+								     double center_freq,
+								     double sampling_freq)
+{
+  return gnuradio::get_initial_sptr(new gr_pfb_xlating_decimator_ccf (decim, taps,
+								      center_freq,
+								      sampling_freq));
+}
+
+
+gr_pfb_xlating_decimator_ccf::gr_pfb_xlating_decimator_ccf (unsigned int decim,
+							    const std::vector<float> &taps,
+							    double center_freq,
+							    double sampling_freq)
+  : gr_sync_decimator ("pfb_xlating_decimator_ccf",
+		       gr_make_io_signature (1, 1, sizeof(gr_complex)),
+		       gr_make_io_signature (1, 1, sizeof(gr_complex)),
+		       decim),
+    d_rate(decim), d_taps_per_filter(0), d_sampling_freq(sampling_freq),
+    d_new_taps(taps), d_center_freq(center_freq)
+{
+  if(decim == 0)
+    throw std::invalid_argument("gr_pfb_xlating_decimator_ccf: decimation must be > 0");
+
+  d_filters = std::vector<gr_fir_ccf*>(d_rate);
+  d_arms.resize(d_rate);
+
+  // Create an FIR filter for each arm and zero out the taps
+  std::vector<float> vtaps(0, d_rate);
+  for(unsigned int i = 0; i < d_rate; i++) {
+    d_filters[i] = gr_fir_util::create_gr_fir_ccf(vtaps);
+  }
+
+  // The arms need the decim-1 samples that precede each output
+  d_mixed.resize(d_rate - 1, 0);
+
+  // Now, actually set the filters' taps and the NCO
+  install_taps(taps);
+  install_center_freq(center_freq);
+}
+
+gr_pfb_xlating_decimator_ccf::~gr_pfb_xlating_decimator_ccf ()
+{
+  for(unsigned int i = 0; i < d_rate; i++) {
+    delete d_filters[i];
+  }
+}
+
+void
+gr_pfb_xlating_decimator_ccf::set_taps (const std::vector<float> &taps)
+{
+  // Picked up by work at the start of its next call
+  d_new_taps.set(taps);
+}
+
+void
+gr_pfb_xlating_decimator_ccf::install_taps (const std::vector<float> &taps)
+{
+  std::vector< std::vector<float> > parts = gri_pfb_partition_taps(taps, d_rate);
+  d_taps_per_filter = parts[0].size();
+
+  for(unsigned int i = 0; i < d_rate; i++) {
+    d_filters[i]->set_taps(parts[i]);
+
+    // Keep the most recent samples of the arm's history; the filter
+    // state lives here, so there is no need to touch set_history.
+    std::vector<gr_complex> &arm = d_arms[i];
+    unsigned int hist = d_taps_per_filter - 1;
+    if(arm.size() > hist)
+      arm.erase(arm.begin(), arm.end() - hist);
+    else
+      arm.insert(arm.begin(), hist - arm.size(), gr_complex(0,0));
+  }
+}
+
+void
+gr_pfb_xlating_decimator_ccf::set_center_freq (double center_freq)
+{
+  d_center_freq.set(center_freq);
+}
+
+void
+gr_pfb_xlating_decimator_ccf::install_center_freq (double center_freq)
+{
+  d_r.set_phase_incr(gr_expj(-2*M_PI*center_freq/d_sampling_freq));
+}
+
+std::vector< std::vector<float> >
+gr_pfb_xlating_decimator_ccf::taps() const
+{
+  return gri_pfb_partition_taps(d_new_taps.latest(), d_rate);
+}
+
+void
+gr_pfb_xlating_decimator_ccf::print_taps()
+{
+  std::vector< std::vector<float> > t = taps();
+  unsigned int i, j;
+  for(i = 0; i < t.size(); i++) {
+    printf("filter[%d]: [", i);
+    for(j = 0; j < t[i].size(); j++) {
+      printf(" %.4e", t[i][j]);
+    }
+    printf("]\n\n");
+  }
+}
+
+int
+gr_pfb_xlating_decimator_ccf::work (int noutput_items,
+				    gr_vector_const_void_star &input_items,
+				    gr_vector_void_star &output_items)
+{
+  if(d_new_taps.update())
+    install_taps(d_new_taps.current());
+  if(d_center_freq.update())
+    install_center_freq(d_center_freq.current());
+
+  const gr_complex *in = (const gr_complex *) input_items[0];
+  gr_complex *out = (gr_complex *) output_items[0];
+
+  unsigned int n = noutput_items;
+  unsigned int hist = d_taps_per_filter - 1;
+
+  // Mix the whole block down to baseband behind the decim-1 samples
+  // carried over from the last call.
+  d_mixed.resize(d_rate - 1 + n*d_rate);
+  d_r.rotateN(&d_mixed[d_rate - 1], in, n*d_rate);
+
+  // Output m is sum_k h[k] x[m*D - k]; with k = q*D + p arm p sees
+  // the sequence x[m*D - p] and filters it with h[q*D + p].
+  d_arm_out.resize(n);
+  for(unsigned int p = 0; p < d_rate; p++) {
+    std::vector<gr_complex> &arm = d_arms[p];
+    arm.resize(hist + n);
+
+    const gr_complex *x = &d_mixed[d_rate - 1 - p];
+    for(unsigned int m = 0; m < n; m++) {
+      arm[hist + m] = x[m*d_rate];
+    }
+
+    if(p == 0) {
+      d_filters[p]->filterN(out, &arm[0], n);
+    }
+    else {
+      d_filters[p]->filterN(&d_arm_out[0], &arm[0], n);
+      volk_32f_x2_add_32f_u((float*)out, (const float*)out,
+			    (const float*)&d_arm_out[0], 2*n);
+    }
+
+    // Keep the arm's history for the next call
+    arm.erase(arm.begin(), arm.begin() + n);
+  }
+
+  // Keep the last decim-1 mixed samples for the next call
+  d_mixed.erase(d_mixed.begin(), d_mixed.begin() + n*d_rate);
+
+  return noutput_items;
+}
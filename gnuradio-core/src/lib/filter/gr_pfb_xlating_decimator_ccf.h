@@ -0,0 +1,145 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GR_PFB_XLATING_DECIMATOR_CCF_H
+#define	INCLUDED_GR_PFB_XLATING_DECIMATOR_CCF_H
+
+#include <gr_core_api.h>
+#include <gr_sync_decimator.h>
+#include <gr_rotator.h>
+#include <gri_double_buffer.h>
+
+class gr_pfb_xlating_decimator_ccf;
+typedef boost::shared_ptr<gr_pfb_xlating_decimator_ccf> gr_pfb_xlating_decimator_ccf_sptr;
+GR_CORE_API gr_pfb_xlating_decimator_ccf_sptr gr_make_pfb_xlating_decimator_ccf (unsigned int decim,
+									     const std::vector<float> &taps,
+									     double center_freq,
+									     double sampling_freq);
+
+class gr_fir_ccf;
+
+/*!
+ * \class gr_pfb_xlating_decimator_ccf
+ *
+ * \brief Frequency translating polyphase decimator with gr_complex
+ *        input, gr_complex output and float taps
+ *
+ * \ingroup filter_blk
+ * \ingroup pfb_blk
+ *
+ * This block does the same job as gr_freq_xlating_fir_filter_ccf:
+ * it shifts \p center_freq down to zero Hz, low-pass filters with
+ * the prototype \p taps and decimates by \p decim.
+ *
+ * Instead of folding the frequency shift into a set of complex
+ * composite taps, the input is mixed down by an NCO (a gr_rotator
+ * run over the whole input block) and then fed to a polyphase
+ * decimator built from the real prototype taps. The prototype is
+ * split into <EM>decim</EM> arms of ceil(taps.size()/decim) taps
+ * each, and each arm runs at the output rate on its own
+ * deinterleaved input, so only the outputs that are kept are ever
+ * computed and each one costs taps.size() real-by-complex MACs
+ * instead of complex-by-complex ones.
+ *
+ * Because the taps never depend on the frequency, set_center_freq()
+ * only changes the NCO phase increment. The change is phase
+ * continuous and takes effect on the next call to work without
+ * rebuilding any filters or changing the block's history.
+ * The filter history is kept internally, so set_taps() does not
+ * stall the block either.
+ */
+
+class GR_CORE_API gr_pfb_xlating_decimator_ccf : public gr_sync_decimator
+{
+ private:
+  /*!
+   * Build the frequency translating polyphase decimator.
+   * \param decim         (unsigned integer) Specifies the decimation rate to use
+   * \param taps          (vector/list of floats) The prototype low-pass filter.
+   * \param center_freq   (double) The frequency to translate down to zero Hz.
+   * \param sampling_freq (double) The input sampling rate.
+   */
+  friend GR_CORE_API gr_pfb_xlating_decimator_ccf_sptr gr_make_pfb_xlating_decimator_ccf (unsigned int decim,
+										      const std::vector<float> &taps,
+										      double center_freq,
+										      double sampling_freq);
+
+  std::vector<gr_fir_ccf*> d_filters;
+  unsigned int             d_rate;
+  unsigned int             d_taps_per_filter;
+  gr_rotator               d_r;
+  double                   d_sampling_freq;
+  gri_double_buffer<std::vector<float> > d_new_taps;  // set_taps -> work
+  gri_double_buffer<double> d_center_freq;             // set_center_freq -> work
+
+  std::vector<gr_complex>  d_mixed;    // last decim-1 mixed samples + this call's samples
+  std::vector< std::vector<gr_complex> > d_arms; // per-arm history + this call's samples
+  std::vector<gr_complex>  d_arm_out;  // output of one arm for this call
+
+  void install_taps (const std::vector<float> &taps);
+  void install_center_freq (double center_freq);
+
+  /*!
+   * Build the frequency translating polyphase decimator.
+   * \param decim         (unsigned integer) Specifies the decimation rate to use
+   * \param taps          (vector/list of floats) The prototype low-pass filter.
+   * \param center_freq   (double) The frequency to translate down to zero Hz.
+   * \param sampling_freq (double) The input sampling rate.
+   */
+  gr_pfb_xlating_decimator_ccf (unsigned int decim,
+				const std::vector<float> &taps,
+				double center_freq,
+				double sampling_freq);
+
+public:
+  ~gr_pfb_xlating_decimator_ccf ();
+
+  /*!
+   * Resets the filterbank's filter taps with the new prototype filter
+   * \param taps    (vector/list of floats) The prototype filter to populate the filterbank.
+   */
+  void set_taps (const std::vector<float> &taps);
+
+  /*!
+   * Retunes the NCO; the filterbank is left untouched.
+   * \param center_freq   (double) The frequency to translate down to zero Hz.
+   */
+  void set_center_freq (double center_freq);
+
+  double center_freq () const { return d_center_freq.latest(); }
+
+  /*!
+   * Return a vector<vector<>> of the filterbank taps
+   */
+  std::vector< std::vector<float> > taps() const;
+
+  /*!
+   * Print all of the filterbank taps to screen.
+   */
+  void print_taps();
+
+  int work (int noutput_items,
+	    gr_vector_const_void_star &input_items,
+	    gr_vector_void_star &output_items);
+};
+
+#endif
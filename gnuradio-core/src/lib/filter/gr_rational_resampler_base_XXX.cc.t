@@ -52,7 +52,7 @@ gr_make_@BASE_NAME@ (unsigned interpolation,
 	      gr_make_io_signature (1, 1, sizeof (@O_TYPE@))),
     d_history(1),
     d_interpolation(interpolation), d_decimation(decimation),
-    d_ctr(0), d_updated(false),
+    d_ctr(0),
     d_firs(interpolation)
 {
   if (interpolation == 0)
@@ -69,7 +69,8 @@ gr_make_@BASE_NAME@ (unsigned interpolation,
     d_firs[i] = gr_fir_util::create_@FIR_TYPE@ (dummy_taps);
 
   set_taps (taps);
-  install_taps (d_new_taps);
+  d_new_taps.update ();
+  install_taps (d_new_taps.current ());
 }
 
 @NAME@::~@NAME@ ()
@@ -82,18 +83,20 @@ gr_make_@BASE_NAME@ (unsigned interpolation,
 void
 @NAME@::set_taps (const std::vector<@TAP_TYPE@> &taps)
 {
-  d_new_taps = taps;
-  d_updated = true;
+  std::vector<@TAP_TYPE@> new_taps = taps;
 
   // round up length to a multiple of the interpolation factor
   int n = taps.size () % interpolation ();
   if (n > 0){
     n = interpolation () - n;
     while (n-- > 0)
-      d_new_taps.insert(d_new_taps.begin(), 0);
+      new_taps.insert(new_taps.begin(), 0);
   }
 
-  assert (d_new_taps.size () % interpolation () == 0);
+  assert (new_taps.size () % interpolation () == 0);
+
+  // Picked up by general_work at the start of its next call
+  d_new_taps.set (new_taps);
 }
 
 
@@ -117,7 +120,6 @@ void
     d_firs[n]->set_taps (xtaps[n]);
 
   set_history (nt);
-  d_updated = false;
 
 #if 0
   for (int i = 0; i < nfilters; i++){
@@ -149,9 +151,11 @@ int
   const @I_TYPE@ *in = (const @I_TYPE@ *) input_items[0];
   @O_TYPE@ *out = (@O_TYPE@ *) output_items[0];
 
-  if (d_updated) {
-    install_taps (d_new_taps);
-    return 0;		// history requirement may have increased.
+  if (d_new_taps.update ()) {
+    unsigned old_history = history ();
+    install_taps (d_new_taps.current ());
+    if (history () != old_history)
+      return 0;		// history requirement has changed.
   }
 
   unsigned int ctr = d_ctr;
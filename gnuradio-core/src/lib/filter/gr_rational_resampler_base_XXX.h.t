@@ -31,6 +31,7 @@
 
 #include <gr_core_api.h>
 #include <gr_block.h>
+#include <gri_double_buffer.h>
 
 class @NAME@;
 typedef boost::shared_ptr<@NAME@> @SPTR_NAME@;
@@ -51,8 +52,7 @@ class GR_CORE_API @NAME@ : public gr_block
   unsigned 			d_history;
   unsigned 			d_interpolation, d_decimation;
   unsigned 			d_ctr;
-  std::vector<@TAP_TYPE@>	d_new_taps;
-  bool				d_updated;
+  gri_double_buffer<std::vector<@TAP_TYPE@> > d_new_taps;
   std::vector<@FIR_TYPE@ *> d_firs;
 
   friend GR_CORE_API @SPTR_NAME@
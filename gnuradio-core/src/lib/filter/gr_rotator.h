@@ -25,6 +25,7 @@
 
 #include <gr_core_api.h>
 #include <gr_complex.h>
+#include <volk/volk.h>
 
 class GR_CORE_API gr_rotator {
   gr_complex	d_phase;
@@ -49,6 +50,26 @@ class GR_CORE_API gr_rotator {
     return z;
   }
 
+  /*!
+   * \brief rotate \p n samples of \p in into \p out.
+   *
+   * Equivalent to calling rotate() on each sample in turn, but runs
+   * the phasor recursion in a SIMD kernel that renormalizes it
+   * every few hundred samples.  \p in and \p out may be the same
+   * array.
+   */
+  void rotateN (gr_complex *out, const gr_complex *in, int n){
+    volk_32fc_s32fc_x2_rotator_32fc_u (out, in, d_phase_incr, &d_phase, n);
+
+    // The kernel only renormalizes within a call; keep short calls
+    // from drifting too.
+    d_counter += n;
+    if (d_counter >= 512){
+      d_phase /= abs(d_phase);
+      d_counter = 0;
+    }
+  }
+
 };
 
 #endif /* _GR_ROTATOR_H_ */
@@ -0,0 +1,200 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_block_lms_ccc.h>
+#include <gri_fft.h>
+#include <volk/volk.h>
+#include <stdexcept>
+#include <algorithm>
+#include <string.h>
+#include <math.h>
+
+static const int MIN_FFT_TAPS = 32;
+
+gri_block_lms_ccc::gri_block_lms_ccc (int ntaps, int decimation, int block_size)
+  : d_ntaps(ntaps), d_decimation(decimation), d_block_size(block_size),
+    d_fftsize(0), d_fwdfft(0), d_invfft(0)
+{
+  if (ntaps < 1)
+    throw std::invalid_argument ("gri_block_lms_ccc: ntaps must be >= 1");
+  if (decimation < 1)
+    throw std::invalid_argument ("gri_block_lms_ccc: decimation must be >= 1");
+  if (block_size < 1)
+    throw std::invalid_argument ("gri_block_lms_ccc: block_size must be >= 1");
+  configure ();
+}
+
+gri_block_lms_ccc::~gri_block_lms_ccc ()
+{
+  delete d_fwdfft;
+  delete d_invfft;
+}
+
+void
+gri_block_lms_ccc::set_taps (const std::vector<gr_complex> &taps)
+{
+  if ((int) taps.size () != d_ntaps){
+    if (taps.empty ())
+      throw std::invalid_argument ("gri_block_lms_ccc: need at least one tap");
+    d_ntaps = taps.size ();
+    configure ();
+  }
+  for (int k = 0; k < d_ntaps; k++)
+    d_rtaps[k] = taps[d_ntaps-1-k];
+}
+
+void
+gri_block_lms_ccc::get_taps (std::vector<gr_complex> &taps) const
+{
+  taps.resize (d_ntaps);
+  for (int k = 0; k < d_ntaps; k++)
+    taps[d_ntaps-1-k] = d_rtaps[k];
+}
+
+void
+gri_block_lms_ccc::set_block_size (int block_size)
+{
+  if (block_size < 1)
+    throw std::invalid_argument ("gri_block_lms_ccc: block_size must be >= 1");
+  d_block_size = block_size;
+  configure ();
+}
+
+void
+gri_block_lms_ccc::configure ()
+{
+  d_rtaps.resize (d_ntaps);
+
+  delete d_fwdfft;
+  delete d_invfft;
+  d_fwdfft = 0;
+  d_invfft = 0;
+
+  // Every output of a block and every tap update needs the same
+  // (B-1)*D + l input samples, so an FFT of that size does the whole
+  // block without wrapping around.
+  int span = (d_block_size - 1) * d_decimation + d_ntaps;
+  int fftsize = 1;
+  while (fftsize < span)
+    fftsize *= 2;
+
+  // Five transforms of about 5 N log2(N) flops per block, against two
+  // passes over the taps of 8 flops per tap for every output.  Short
+  // filters stay in the time domain, where the fixed cost of running
+  // the transforms would dominate.
+  double fd_cost = 5.0 * 5 * fftsize * log2 ((double) fftsize);
+  double td_cost = 2.0 * 8 * d_block_size * d_ntaps;
+
+  if (d_ntaps >= MIN_FFT_TAPS && fd_cost < td_cost){
+    d_fftsize = fftsize;
+    d_fwdfft = new gri_fft_complex (d_fftsize, true);
+    d_invfft = new gri_fft_complex (d_fftsize, false);
+    d_xform.resize (d_fftsize);
+  }
+  else {
+    d_fftsize = 0;
+    d_xform.clear ();
+  }
+}
+
+void
+gri_block_lms_ccc::filter (gr_complex *out, const gr_complex *x, int n)
+{
+  if (!d_fwdfft){
+    for (int i = 0; i < n; i++)
+      volk_32fc_x2_dot_prod_32fc_u (&out[i], &x[i*d_decimation], &d_rtaps[0], d_ntaps);
+    return;
+  }
+
+  // sum_k rtaps[k] x[m+k] is the correlation of x with conj(rtaps)
+  int len = (n - 1) * d_decimation + d_ntaps;
+  gr_complex *in = d_fwdfft->get_inbuf ();
+  memcpy (in, x, len * sizeof (gr_complex));
+  std::fill (&in[len], &in[d_fftsize], gr_complex (0, 0));
+  d_fwdfft->execute ();
+  memcpy (&d_xform[0], d_fwdfft->get_outbuf (), d_fftsize * sizeof (gr_complex));
+
+  for (int k = 0; k < d_ntaps; k++)
+    in[k] = conj (d_rtaps[k]);
+  std::fill (&in[d_ntaps], &in[d_fftsize], gr_complex (0, 0));
+  d_fwdfft->execute ();
+
+  volk_32fc_x2_multiply_conjugate_32fc_u (d_invfft->get_inbuf (), &d_xform[0],
+					  d_fwdfft->get_outbuf (), d_fftsize);
+  d_invfft->execute ();
+
+  const gr_complex *y = d_invfft->get_outbuf ();
+  float scale = 1.0f / d_fftsize;
+  for (int i = 0; i < n; i++)
+    out[i] = y[i*d_decimation] * scale;
+}
+
+void
+gri_block_lms_ccc::update (const gr_complex *x, const gr_complex *err, int n,
+			   gr_complex mu, bool conj_input)
+{
+  float *w = (float *) &d_rtaps[0];
+
+  if (!d_fwdfft){
+    // rtaps[k] += mu * err[i] * x'[i*D+k], in floats so that it vectorizes
+    for (int i = 0; i < n; i++){
+      gr_complex e = mu * err[i];
+      float er = e.real (), ei = e.imag ();
+      const float *xp = (const float *) &x[i*d_decimation];
+      if (conj_input){
+	for (int k = 0; k < d_ntaps; k++){
+	  w[2*k]   += er * xp[2*k] + ei * xp[2*k+1];
+	  w[2*k+1] += ei * xp[2*k] - er * xp[2*k+1];
+	}
+      }
+      else {
+	for (int k = 0; k < d_ntaps; k++){
+	  w[2*k]   += er * xp[2*k] - ei * xp[2*k+1];
+	  w[2*k+1] += ei * xp[2*k] + er * xp[2*k+1];
+	}
+      }
+    }
+    return;
+  }
+
+  // The errors sit at every D'th sample of the block.  Correlating x
+  // with them gives sum_i err[i] x[i*D+k] for every k at once; for
+  // conj(x), correlate with conj(err) and conjugate the result.
+  gr_complex *in = d_fwdfft->get_inbuf ();
+  std::fill (&in[0], &in[d_fftsize], gr_complex (0, 0));
+  for (int i = 0; i < n; i++)
+    in[i*d_decimation] = conj_input ? err[i] : conj (err[i]);
+  d_fwdfft->execute ();
+
+  volk_32fc_x2_multiply_conjugate_32fc_u (d_invfft->get_inbuf (), &d_xform[0],
+					  d_fwdfft->get_outbuf (), d_fftsize);
+  d_invfft->execute ();
+
+  const gr_complex *g = d_invfft->get_outbuf ();
+  gr_complex scale = mu / (float) d_fftsize;
+  for (int k = 0; k < d_ntaps; k++)
+    d_rtaps[k] += scale * (conj_input ? conj (g[k]) : g[k]);
+}
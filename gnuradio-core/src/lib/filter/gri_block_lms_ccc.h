@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifndef INCLUDED_GRI_BLOCK_LMS_CCC_H
+#define INCLUDED_GRI_BLOCK_LMS_CCC_H
+
+#include <gr_core_api.h>
+#include <gr_complex.h>
+#include <vector>
+
+class gri_fft_complex;
+
+/*!
+ * \brief Block LMS engine for adaptive FIR filters with complex taps
+ * \ingroup filter
+ *
+ * Filters a block of outputs with the taps held fixed, then moves every
+ * tap by the correlation of the block's errors with the input:
+ *
+ *   out[i] = sum_k taps[l-1-k] * x[i*D+k]
+ *   taps[l-1-k] += mu * sum_i err[i] * x'[i*D+k]
+ *
+ * where l is the number of taps, D the decimation and x' is x or
+ * conj(x).  The tap order is that of gr_adaptive_fir_ccc.  With a block
+ * size of 1 this is the usual per-sample LMS update.
+ *
+ * Short filters use volk dot products and a vectorized update.  Long
+ * filters with large enough blocks do both the filtering and the
+ * correlation with FFTs (frequency domain block LMS), which costs
+ * O(log(l)) per output instead of O(l).
+ */
+class GR_CORE_API gri_block_lms_ccc
+{
+public:
+  gri_block_lms_ccc (int ntaps, int decimation, int block_size = 1);
+  ~gri_block_lms_ccc ();
+
+  void set_taps (const std::vector<gr_complex> &taps);
+  void get_taps (std::vector<gr_complex> &taps) const;
+  int ntaps () const { return d_ntaps; }
+
+  void set_block_size (int block_size);
+  int block_size () const { return d_block_size; }
+
+  //! True if the current configuration runs in the frequency domain
+  bool frequency_domain () const { return d_fwdfft != 0; }
+
+  /*!
+   * \brief Compute \p n <= block_size() outputs.
+   * \p x must hold (n-1)*D + ntaps() samples.
+   */
+  void filter (gr_complex *out, const gr_complex *x, int n);
+
+  /*!
+   * \brief Update the taps from the errors of the last filter() call.
+   * \p x and \p n must be those given to filter().
+   */
+  void update (const gr_complex *x, const gr_complex *err, int n,
+	       gr_complex mu, bool conj_input);
+
+private:
+  int d_ntaps;
+  int d_decimation;
+  int d_block_size;
+  std::vector<gr_complex> d_rtaps;	// taps in input order: d_rtaps[k] = taps[l-1-k]
+
+  int d_fftsize;
+  gri_fft_complex *d_fwdfft;
+  gri_fft_complex *d_invfft;
+  std::vector<gr_complex> d_xform;	// transform of the last filter input
+
+  void configure ();
+};
+
+#endif /* INCLUDED_GRI_BLOCK_LMS_CCC_H */
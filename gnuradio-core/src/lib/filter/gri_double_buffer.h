@@ -0,0 +1,103 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GRI_DOUBLE_BUFFER_H
+#define INCLUDED_GRI_DOUBLE_BUFFER_H
+
+#include <gruel/thread.h>
+
+/*!
+ * \brief Double buffer for handing settings (e.g. filter taps) from
+ * a control thread to a block's work thread.
+ * \ingroup filter
+ *
+ * The control thread calls set() to publish a new value.  The work
+ * thread calls update() at the top of each call to work and then
+ * reads current() freely for the rest of the call; a new value is
+ * only picked up at that call boundary.
+ *
+ * update() never waits: if a set() happens to be in progress it
+ * leaves current() alone and the new value is picked up on the next
+ * call instead.  So the work path never blocks behind a control
+ * thread, and the control thread never sees a half-used value.
+ *
+ * current() belongs to the work thread.  Other threads should use
+ * latest(), which returns the most recently published value.
+ */
+template <class T>
+class gri_double_buffer
+{
+  T                     d_front;    // used by the work thread
+  T                     d_back;     // last value passed to set()
+  volatile bool         d_pending;
+  mutable gruel::mutex  d_mutex;    // protects d_back
+
+public:
+  gri_double_buffer (const T &value = T())
+    : d_front(value), d_back(value), d_pending(false) {}
+
+  /*!
+   * \brief Publish \p value; called from the control thread.
+   */
+  void set (const T &value)
+  {
+    gruel::scoped_lock guard(d_mutex);
+    d_back = value;
+    d_pending = true;
+  }
+
+  /*!
+   * \brief Most recently published value; safe from any thread.
+   */
+  T latest () const
+  {
+    gruel::scoped_lock guard(d_mutex);
+    return d_back;
+  }
+
+  /*!
+   * \brief Pick up a newly published value, if any; called from the
+   * work thread at the start of a call to work.
+   *
+   * \returns true if current() changed.
+   */
+  bool update ()
+  {
+    if (!d_pending)
+      return false;
+
+    gruel::scoped_lock guard(d_mutex, boost::try_to_lock);
+    if (!guard.owns_lock())
+      return false;   // set() in progress; try again next call
+
+    d_front = d_back;
+    d_pending = false;
+    return true;
+  }
+
+  /*!
+   * \brief The value in use by the work thread.
+   */
+  const T &current () const { return d_front; }
+};
+
+#endif /* INCLUDED_GRI_DOUBLE_BUFFER_H */
@@ -0,0 +1,373 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_iir_sos.h>
+#include <gri_fft.h>
+#include <gr_complex.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// ----------------------------------------------------------------
+// Designer
+
+// Roots of c[0] z^n + c[1] z^(n-1) + ... + c[n], c[0] != 0, by
+// Aberth-Ehrlich iteration.
+static std::vector<gr_complexd>
+poly_roots (const std::vector<double> &c)
+{
+  int n = c.size () - 1;
+  std::vector<gr_complexd> z (n);
+  if (n <= 0)
+    return z;
+
+  // Start on a circle that encloses all the roots (Cauchy bound),
+  // off the real axis so that conjugate pairs can separate.
+  double radius = 0;
+  for (int i = 1; i <= n; i++)
+    radius = std::max (radius, std::abs (c[i] / c[0]));
+  radius = std::min (1.0 + radius, 2.0);
+  for (int i = 0; i < n; i++)
+    z[i] = std::polar (radius, 2 * M_PI * (i + 0.25) / n + 0.4);
+
+  for (int iter = 0; iter < 500; iter++){
+    double max_step = 0;
+    for (int i = 0; i < n; i++){
+      gr_complexd p = c[0], dp = 0;
+      for (int k = 1; k <= n; k++){
+	dp = dp * z[i] + p;
+	p = p * z[i] + c[k];
+      }
+      if (p == 0.0)
+	continue;
+
+      gr_complexd ratio = p / dp;
+      gr_complexd sum = 0;
+      for (int j = 0; j < n; j++)
+	if (j != i)
+	  sum += 1.0 / (z[i] - z[j]);
+
+      gr_complexd step = ratio / (1.0 - ratio * sum);
+      z[i] -= step;
+      max_step = std::max (max_step, std::abs (step) / std::max (1.0, std::abs (z[i])));
+    }
+    if (max_step < 1e-15)
+      break;
+  }
+  return z;
+}
+
+// One first order factor (c0 + c1 z^-1).  A root r gives (1, -r); a
+// pure delay gives (0, 1).
+struct factor {
+  gr_complexd c0, c1;
+};
+
+// Group roots into conjugate pairs (or pairs of nearby real roots),
+// then pair up the extra factors and pad with \p pad to \p npairs.
+// Pairing greedily with the root nearest the conjugate, rather than
+// by testing for a zero imaginary part, copes with clustered roots
+// that come back slightly off the real axis.
+static std::vector<std::pair<factor, factor> >
+pair_factors (const std::vector<gr_complexd> &roots,
+	      const std::vector<factor> &extra, const factor &pad, unsigned npairs)
+{
+  std::vector<gr_complexd> left (roots);
+  std::vector<factor> singles;
+  std::vector<std::pair<factor, factor> > pairs;
+
+  while (left.size () > 1){
+    unsigned i = 0;
+    for (unsigned k = 1; k < left.size (); k++)
+      if (std::abs (left[k].imag ()) > std::abs (left[i].imag ()))
+	i = k;
+    gr_complexd r = left[i];
+    left.erase (left.begin () + i);
+
+    unsigned j = 0;
+    for (unsigned k = 1; k < left.size (); k++)
+      if (std::abs (left[k] - std::conj (r)) < std::abs (left[j] - std::conj (r)))
+	j = k;
+    factor f1 = { 1.0, -r };
+    factor f2 = { 1.0, -left[j] };
+    left.erase (left.begin () + j);
+    pairs.push_back (std::make_pair (f1, f2));
+  }
+  if (left.size ()){
+    factor f = { 1.0, -left[0] };
+    singles.push_back (f);
+  }
+  singles.insert (singles.end (), extra.begin (), extra.end ());
+
+  for (unsigned i = 0; i < singles.size (); i += 2)
+    pairs.push_back (std::make_pair (singles[i],
+				     i + 1 < singles.size () ? singles[i + 1] : pad));
+  while (pairs.size () < npairs)
+    pairs.push_back (std::make_pair (pad, pad));
+
+  return pairs;
+}
+
+// The root of a factor; delays and padding are roots at infinity / 0.
+static gr_complexd
+factor_root (const factor &f)
+{
+  if (f.c0 == 0.0)
+    return gr_complexd (1e300, 0);
+  return -f.c1 / f.c0;
+}
+
+// Strip leading and trailing zeros, returning the polynomial and the
+// number of zeros removed from each end.
+static std::vector<double>
+strip (const std::vector<double> &p, unsigned &nlead, unsigned &ntrail)
+{
+  unsigned b = 0, e = p.size ();
+  while (b < e && p[b] == 0)
+    b++;
+  while (e > b && p[e - 1] == 0)
+    e--;
+  nlead = b;
+  ntrail = p.size () - e;
+  return std::vector<double> (p.begin () + b, p.begin () + e);
+}
+
+// Divide out the roots at z = +1 and z = -1 of c[0] z^n + ... + c[n],
+// returning how many of each were removed.  Classic designs put all
+// their zeros there, and as repeated roots they are only found to a
+// few digits by poly_roots.
+static std::vector<double>
+deflate_unit_roots (const std::vector<double> &c, std::vector<gr_complexd> &roots)
+{
+  std::vector<double> p (c);
+  double scale = 0;
+  for (unsigned k = 0; k < c.size (); k++)
+    scale += std::abs (c[k]);
+
+  for (int sign = -1; sign <= 1; sign += 2){
+    while (p.size () > 1){
+      // synthetic division by (z - sign)
+      std::vector<double> q (p.size () - 1);
+      double acc = 0;
+      for (unsigned k = 0; k < q.size (); k++){
+	acc = acc * sign + p[k];
+	q[k] = acc;
+      }
+      double rem = acc * sign + p.back ();
+      if (std::abs (rem) > 1e-9 * scale)
+	break;
+      p = q;
+      roots.push_back (gr_complexd (sign, 0));
+    }
+  }
+  return p;
+}
+
+static gr_complexd
+polyval_zinv (const std::vector<double> &p, gr_complexd zinv)
+{
+  gr_complexd acc = 0;
+  for (int k = p.size () - 1; k >= 0; k--)
+    acc = acc * zinv + p[k];
+  return acc;
+}
+
+std::vector<double>
+gri_iir_tf2sos (const std::vector<double> &fftaps,
+		const std::vector<double> &fbtaps) throw (std::invalid_argument)
+{
+  // Numerator and denominator as polynomials in z^-1.
+  std::vector<double> num (fftaps);
+  std::vector<double> den (1, 1.0);
+  for (unsigned k = 1; k < fbtaps.size (); k++)
+    den.push_back (-fbtaps[k]);
+
+  unsigned nlead, ntrail, dlead, dtrail;
+  std::vector<double> n = strip (num, nlead, ntrail);
+  std::vector<double> d = strip (den, dlead, dtrail);
+  if (n.empty ())
+    throw std::invalid_argument ("gri_iir_tf2sos: feed-forward taps are all zero");
+
+  double gain = n[0];
+  std::vector<gr_complexd> zeros, poles;
+  std::vector<gr_complexd> zrest = poly_roots (deflate_unit_roots (n, zeros));
+  std::vector<gr_complexd> prest = poly_roots (deflate_unit_roots (d, poles));
+  zeros.insert (zeros.end (), zrest.begin (), zrest.end ());
+  poles.insert (poles.end (), prest.begin (), prest.end ());
+
+  // Leading zeros of num are delays; trailing zeros of num or den are
+  // roots at z = 0.
+  std::vector<factor> zextra, pextra;
+  factor delay = { 0.0, 1.0 };
+  factor unity = { 1.0, 0.0 };
+  for (unsigned i = 0; i < nlead; i++)
+    zextra.push_back (delay);
+  for (unsigned i = 0; i < ntrail; i++)
+    zextra.push_back (unity);
+  for (unsigned i = 0; i < dtrail; i++)
+    pextra.push_back (unity);
+
+  unsigned nzf = zeros.size () + zextra.size ();
+  unsigned npf = poles.size () + pextra.size ();
+  unsigned nsec = std::max (1u, (std::max (nzf, npf) + 1) / 2);
+
+  std::vector<std::pair<factor, factor> > zpairs =
+    pair_factors (zeros, zextra, unity, nsec);
+  std::vector<std::pair<factor, factor> > ppairs =
+    pair_factors (poles, pextra, unity, nsec);
+
+  // Least resonant pole pairs first, so the most resonant sections
+  // see the least gain ahead of them.
+  std::vector<std::pair<double, unsigned> > order;
+  for (unsigned i = 0; i < ppairs.size (); i++){
+    double r = std::max (std::abs (-ppairs[i].first.c1), std::abs (-ppairs[i].second.c1));
+    order.push_back (std::make_pair (r, i));
+  }
+  std::sort (order.begin (), order.end ());
+
+  // Match zeros to poles starting from the most resonant pole pair.
+  std::vector<int> zfor (ppairs.size (), -1);
+  std::vector<bool> used (zpairs.size (), false);
+  for (int oi = order.size () - 1; oi >= 0; oi--){
+    unsigned pi = order[oi].second;
+    gr_complexd p = std::abs (ppairs[pi].first.c1) >= std::abs (ppairs[pi].second.c1)
+      ? -ppairs[pi].first.c1 : -ppairs[pi].second.c1;
+    int best = -1;
+    double best_dist = 0;
+    for (unsigned zi = 0; zi < zpairs.size (); zi++){
+      if (used[zi])
+	continue;
+      double dist = std::min (std::abs (factor_root (zpairs[zi].first) - p),
+			      std::abs (factor_root (zpairs[zi].second) - p));
+      if (best < 0 || dist < best_dist){
+	best = zi;
+	best_dist = dist;
+      }
+    }
+    used[best] = true;
+    zfor[pi] = best;
+  }
+
+  std::vector<double> sos;
+  for (unsigned oi = 0; oi < order.size (); oi++){
+    unsigned pi = order[oi].second;
+    const std::pair<factor, factor> &zp = zpairs[zfor[pi]];
+    const std::pair<factor, factor> &pp = ppairs[pi];
+
+    gr_complexd b0 = zp.first.c0 * zp.second.c0;
+    gr_complexd b1 = zp.first.c0 * zp.second.c1 + zp.first.c1 * zp.second.c0;
+    gr_complexd b2 = zp.first.c1 * zp.second.c1;
+    gr_complexd a1 = pp.first.c1 + pp.second.c1;
+    gr_complexd a2 = pp.first.c1 * pp.second.c1;
+
+    sos.push_back (b0.real ());
+    sos.push_back (b1.real ());
+    sos.push_back (b2.real ());
+    sos.push_back (-a1.real ());
+    sos.push_back (-a2.real ());
+  }
+
+  // Any other repeated roots are only found to a few digits, so set
+  // the gain by matching the original response where it is largest
+  // rather than trusting the leading coefficient.
+  double best_mag = 0, scale = gain;
+  for (int i = 0; i <= 64; i++){
+    gr_complexd zinv = std::polar (1.0, -M_PI * i / 64);
+    gr_complexd h = polyval_zinv (num, zinv) / polyval_zinv (den, zinv);
+    if (std::abs (h) > best_mag){
+      gr_complexd hs = 1.0;
+      for (unsigned s = 0; s < nsec; s++){
+	std::vector<double> bs (&sos[5 * s], &sos[5 * s + 3]);
+	std::vector<double> as (1, 1.0);
+	as.push_back (-sos[5 * s + 3]);
+	as.push_back (-sos[5 * s + 4]);
+	hs *= polyval_zinv (bs, zinv) / polyval_zinv (as, zinv);
+      }
+      if (std::abs (hs) > 0){
+	best_mag = std::abs (h);
+	scale = std::abs (h) / std::abs (hs) * (gain < 0 ? -1 : 1);
+      }
+    }
+  }
+
+  for (int k = 0; k < 3; k++)
+    sos[k] *= scale;
+
+  return sos;
+}
+
+// ----------------------------------------------------------------
+// Lanes
+
+gri_iir_sos_lanes::gri_iir_sos_lanes (const std::vector<double> &sos) throw (std::invalid_argument)
+  : d_state (0)
+{
+  set_sos (sos);
+}
+
+gri_iir_sos_lanes::~gri_iir_sos_lanes ()
+{
+  gri_fft_free (d_state);
+}
+
+void
+gri_iir_sos_lanes::set_sos (const std::vector<double> &sos) throw (std::invalid_argument)
+{
+  if (sos.size () % 5 != 0)
+    throw std::invalid_argument ("gri_iir_sos_lanes: need 5 coefficients per section");
+
+  d_coeffs.assign (sos.begin (), sos.end ());
+
+  gri_fft_free (d_state);
+  d_state = gri_fft_malloc_float (std::max (1u, 2 * nsections ()) * NLANES);
+  memset (d_state, 0, std::max (1u, 2 * nsections ()) * NLANES * sizeof (float));
+}
+
+void
+gri_iir_sos_lanes::filter_n (float output[], const float input[], long nframes)
+{
+  const unsigned nsec = nsections ();
+
+  for (long i = 0; i < nframes; i++){
+    float x[NLANES];
+    memcpy (x, &input[i * NLANES], sizeof (x));
+
+    const float *c = nsec ? &d_coeffs[0] : 0;
+    float *s0 = d_state;
+    for (unsigned k = 0; k < nsec; k++, c += 5, s0 += 2 * NLANES){
+      const float b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+      float *s1 = s0 + NLANES;
+      for (int l = 0; l < NLANES; l++){
+	float y = b0 * x[l] + s0[l];
+	s0[l] = b1 * x[l] + a1 * y + s1[l];
+	s1[l] = b2 * x[l] + a2 * y;
+	x[l] = y;
+      }
+    }
+
+    memcpy (&output[i * NLANES], x, sizeof (x));
+  }
+}
@@ -0,0 +1,170 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GRI_IIR_SOS_H
+#define INCLUDED_GRI_IIR_SOS_H
+
+#include <gr_core_api.h>
+#include <vector>
+#include <stdexcept>
+
+/*!
+ * \brief Factor an IIR transfer function into second order sections.
+ * \ingroup filter
+ *
+ * \p fftaps and \p fbtaps use the same convention as gri_iir:
+ * y[n] = sum_k fftaps[k] x[n-k] + sum_{k>=1} fbtaps[k] y[n-k].
+ *
+ * The result holds five coefficients per section, {b0, b1, b2, a1, a2},
+ * in the same sign convention, so each section computes
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2].
+ * Complex conjugate poles and zeros are kept together, each pole
+ * pair is matched with the nearest remaining zero pair, and the most
+ * resonant sections come last.  The overall gain goes into the first
+ * section.
+ */
+GR_CORE_API std::vector<double>
+gri_iir_tf2sos (const std::vector<double> &fftaps,
+		const std::vector<double> &fbtaps) throw (std::invalid_argument);
+
+/*!
+ * \brief Cascade of second order IIR sections (biquads)
+ * \ingroup filter
+ *
+ * Each section is evaluated in Transposed Direct Form II.  Unlike a
+ * single high order difference equation (gri_iir), the cascade keeps
+ * its poles where they were designed regardless of the order of the
+ * filter.  \p sos is laid out as described for gri_iir_tf2sos.
+ */
+template<class i_type, class o_type, class acc_type>
+class gri_iir_sos {
+public:
+  gri_iir_sos (const std::vector<double> &sos) throw (std::invalid_argument)
+  {
+    set_sos (sos);
+  }
+
+  gri_iir_sos () { }
+
+  ~gri_iir_sos () { }
+
+  /*!
+   * \brief compute a single output value.
+   * \returns the filtered input value.
+   */
+  o_type filter (const i_type input);
+
+  /*!
+   * \brief compute an array of N output values.
+   * \p input must have N valid entries.
+   */
+  void filter_n (o_type output[], const i_type input[], long n);
+
+  /*!
+   * \return number of second order sections.
+   */
+  unsigned nsections () const { return d_sos.size () / 5; }
+
+  /*!
+   * \brief install new sections and clear the filter state.
+   */
+  void set_sos (const std::vector<double> &sos) throw (std::invalid_argument)
+  {
+    if (sos.size () % 5 != 0)
+      throw std::invalid_argument ("gri_iir_sos: need 5 coefficients per section");
+
+    d_sos = sos;
+    d_state.assign (2 * nsections (), acc_type (0));
+  }
+
+protected:
+  std::vector<double>	d_sos;
+  std::vector<acc_type>	d_state;	// two delay elements per section
+};
+
+template<class i_type, class o_type, class acc_type>
+o_type
+gri_iir_sos<i_type, o_type, acc_type>::filter (const i_type input)
+{
+  const double *c = d_sos.size () ? &d_sos[0] : 0;
+  acc_type *s = d_state.size () ? &d_state[0] : 0;
+  acc_type x = input;
+
+  for (unsigned k = nsections (); k > 0; k--, c += 5, s += 2){
+    acc_type y = c[0] * x + s[0];
+    s[0] = c[1] * x + c[3] * y + s[1];
+    s[1] = c[2] * x + c[4] * y;
+    x = y;
+  }
+  return (o_type) x;
+}
+
+template<class i_type, class o_type, class acc_type>
+void
+gri_iir_sos<i_type, o_type, acc_type>::filter_n (o_type output[],
+						 const i_type input[],
+						 long n)
+{
+  for (int i = 0; i < n; i++)
+    output[i] = filter (input[i]);
+}
+
+/*!
+ * \brief Second order section cascade applied to NLANES independent
+ * float streams at once.
+ * \ingroup filter
+ *
+ * Every lane runs the same sections with its own state.  Samples are
+ * processed a frame at a time, a frame holding one sample of each
+ * lane, and the per-section arithmetic is written as a loop across
+ * the lanes of a frame so that the compiler turns it into vector
+ * instructions.
+ */
+class GR_CORE_API gri_iir_sos_lanes {
+public:
+  static const int NLANES = 8;
+
+  gri_iir_sos_lanes (const std::vector<double> &sos) throw (std::invalid_argument);
+  ~gri_iir_sos_lanes ();
+
+  /*!
+   * \brief install new sections and clear the filter state.
+   */
+  void set_sos (const std::vector<double> &sos) throw (std::invalid_argument);
+
+  unsigned nsections () const { return d_coeffs.size () / 5; }
+
+  /*!
+   * \brief filter \p nframes frames.  Frame i of \p input and
+   * \p output is input[i*NLANES] .. input[i*NLANES + NLANES - 1].
+   */
+  void filter_n (float output[], const float input[], long nframes);
+
+private:
+  std::vector<float>	d_coeffs;	// {b0, b1, b2, a1, a2} per section
+  float		       *d_state;	// two rows of NLANES per section
+
+  gri_iir_sos_lanes (const gri_iir_sos_lanes &);
+  gri_iir_sos_lanes &operator= (const gri_iir_sos_lanes &);
+};
+
+#endif /* INCLUDED_GRI_IIR_SOS_H */
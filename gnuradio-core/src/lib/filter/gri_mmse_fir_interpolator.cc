@@ -24,26 +24,26 @@
 #include <config.h>
 #endif
 #include <gri_mmse_fir_interpolator.h>
-#include <gr_fir_util.h>
-#include <gr_fir_fff.h>
+#include <gri_fft.h>
+#include <volk/volk.h>
 #include <assert.h>
 #include <cmath>
 #include "interpolator_taps.h"
 
 gri_mmse_fir_interpolator::gri_mmse_fir_interpolator ()
 {
-  filters.resize (NSTEPS + 1);
+  // One contiguous table, taps reversed so that row imu can be applied
+  // directly as a dot product against input[0] .. input[NTAPS - 1].
+  d_taps = gri_fft_malloc_float ((NSTEPS + 1) * NTAPS);
 
-  for (int i = 0; i < NSTEPS + 1; i++){
-    std::vector<float> t (&taps[i][0], &taps[i][NTAPS]);
-    filters[i] = gr_fir_util::create_gr_fir_fff (t);
-  }
+  for (int i = 0; i < NSTEPS + 1; i++)
+    for (int j = 0; j < NTAPS; j++)
+      d_taps[i * NTAPS + j] = taps[i][NTAPS - 1 - j];
 }
 
 gri_mmse_fir_interpolator::~gri_mmse_fir_interpolator ()
 {
-  for (int i = 0; i < NSTEPS + 1; i++)
-    delete filters[i];
+  gri_fft_free (d_taps);
 }
 
 unsigned
@@ -66,6 +66,28 @@ gri_mmse_fir_interpolator::interpolate (const float input[], float mu) const
   assert (imu >= 0);
   assert (imu <= NSTEPS);
 
-  float r = filters[imu]->filter (input);
+  float r;
+  volk_32f_x2_dot_prod_32f_u (&r, input, &d_taps[imu * NTAPS], NTAPS);
   return r;
 }
+
+void
+gri_mmse_fir_interpolator::interpolate_n (float output[], const float input[],
+                                          const int offset[], const float mu[], int n) const
+{
+  // NTAPS is a compile time constant, so the inner loop is fully
+  // unrolled and no per-output dispatch is paid.
+  for (int i = 0; i < n; i++){
+    int	imu = (int) rint (mu[i] * NSTEPS);
+
+    assert (imu >= 0);
+    assert (imu <= NSTEPS);
+
+    const float *row = &d_taps[imu * NTAPS];
+    const float *in = &input[offset[i]];
+    float acc = 0;
+    for (int j = 0; j < NTAPS; j++)
+      acc += row[j] * in[j];
+    output[i] = acc;
+  }
+}
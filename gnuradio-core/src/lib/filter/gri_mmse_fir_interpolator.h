@@ -23,9 +23,6 @@
 #define _GRI_MMSE_FIR_INTERPOLATOR_H_
 
 #include <gr_core_api.h>
-#include <vector>
-
-class gr_fir_fff;
 
 /*!
  * \brief Compute intermediate samples between signal samples x(k*Ts)
@@ -63,8 +60,18 @@ public:
    */
   float interpolate (const float input[], float mu) const;
 
+  /*!
+   * \brief compute \p n interpolated output values.
+   *
+   * output[i] = interpolate (&input[offset[i]], mu[i]) for 0 <= i < n.
+   * The positions and fractional delays are supplied up front so that
+   * the whole batch is evaluated in one pass over the tap table.
+   */
+  void interpolate_n (float output[], const float input[],
+		      const int offset[], const float mu[], int n) const;
+
 protected:
-  std::vector<gr_fir_fff *>	filters;
+  float		*d_taps;	// (nsteps() + 1) rows of ntaps() reversed taps
 };
 
 
@@ -24,26 +24,26 @@
 #include <config.h>
 #endif
 #include <gri_mmse_fir_interpolator_cc.h>
-#include <gr_fir_util.h>
-#include <gr_fir_ccf.h>
+#include <gri_fft.h>
+#include <volk/volk.h>
 #include <assert.h>
 #include <cmath>
 #include "interpolator_taps.h"
 
 gri_mmse_fir_interpolator_cc::gri_mmse_fir_interpolator_cc ()
 {
-  filters.resize (NSTEPS + 1);
+  // One contiguous table, taps reversed so that row imu can be applied
+  // directly as a dot product against input[0] .. input[NTAPS - 1].
+  d_taps = gri_fft_malloc_float ((NSTEPS + 1) * NTAPS);
 
-  for (int i = 0; i < NSTEPS + 1; i++){
-    std::vector<float> t (&taps[i][0], &taps[i][NTAPS]);
-    filters[i] = gr_fir_util::create_gr_fir_ccf (t);
-  }
+  for (int i = 0; i < NSTEPS + 1; i++)
+    for (int j = 0; j < NTAPS; j++)
+      d_taps[i * NTAPS + j] = taps[i][NTAPS - 1 - j];
 }
 
 gri_mmse_fir_interpolator_cc::~gri_mmse_fir_interpolator_cc ()
 {
-  for (int i = 0; i < NSTEPS + 1; i++)
-    delete filters[i];
+  gri_fft_free (d_taps);
 }
 
 unsigned
@@ -59,13 +59,38 @@ gri_mmse_fir_interpolator_cc::nsteps () const
 }
 
 gr_complex
-gri_mmse_fir_interpolator_cc::interpolate (const gr_complex input[], float mu)
+gri_mmse_fir_interpolator_cc::interpolate (const gr_complex input[], float mu) const
 {
   int	imu = (int) rint (mu * NSTEPS);
 
   assert (imu >= 0);
   assert (imu <= NSTEPS);
 
-  gr_complex r = filters[imu]->filter (input);
+  gr_complex r;
+  volk_32fc_32f_dot_prod_32fc_u (&r, (const lv_32fc_t *) input, &d_taps[imu * NTAPS], NTAPS);
   return r;
 }
+
+void
+gri_mmse_fir_interpolator_cc::interpolate_n (gr_complex output[], const gr_complex input[],
+                                             const int offset[], const float mu[], int n) const
+{
+  // NTAPS is a compile time constant, so the inner loop is fully
+  // unrolled and no per-output dispatch is paid.
+  for (int i = 0; i < n; i++){
+    int	imu = (int) rint (mu[i] * NSTEPS);
+
+    assert (imu >= 0);
+    assert (imu <= NSTEPS);
+
+    const float *row = &d_taps[imu * NTAPS];
+    const float *in = (const float *) &input[offset[i]];
+    float acc_i = 0;
+    float acc_q = 0;
+    for (int j = 0; j < NTAPS; j++){
+      acc_i += row[j] * in[2 * j];
+      acc_q += row[j] * in[2 * j + 1];
+    }
+    output[i] = gr_complex (acc_i, acc_q);
+  }
+}
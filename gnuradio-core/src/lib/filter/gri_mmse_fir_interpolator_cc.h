@@ -24,9 +24,6 @@
 
 #include <gr_core_api.h>
 #include <gr_complex.h>
-#include <vector>
-
-class gr_fir_ccf;
 
 /*!
  * \brief Compute intermediate samples between signal samples x(k*Ts)
@@ -56,18 +53,27 @@ public:
   /*!
    * \brief compute a single interpolated output value.
    *
-   * \p input must have ntaps() valid entries and be 8-byte aligned.
+   * \p input must have ntaps() valid entries.
    * input[0] .. input[ntaps() - 1] are referenced to compute the output value.
-   * \throws std::invalid_argument if input is not 8-byte aligned.
    *
    * \p mu must be in the range [0, 1] and specifies the fractional delay.
    *
    * \returns the interpolated input value.
    */
-  gr_complex interpolate (const gr_complex input[], float mu);
+  gr_complex interpolate (const gr_complex input[], float mu) const;
+
+  /*!
+   * \brief compute \p n interpolated output values.
+   *
+   * output[i] = interpolate (&input[offset[i]], mu[i]) for 0 <= i < n.
+   * The positions and fractional delays are supplied up front so that
+   * the whole batch is evaluated in one pass over the tap table.
+   */
+  void interpolate_n (gr_complex output[], const gr_complex input[],
+		      const int offset[], const float mu[], int n) const;
 
 protected:
-  std::vector<gr_fir_ccf *>	filters;
+  float		*d_taps;	// (nsteps() + 1) rows of ntaps() reversed taps
 };
 
 
@@ -0,0 +1,146 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_pfb_arb_resampler.h>
+#include <gri_fft.h>
+#include <gri_pfb_partition_taps.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+
+gri_pfb_arb_resampler::gri_pfb_arb_resampler (float rate,
+					      const std::vector<float> &taps,
+					      unsigned int filter_size)
+  : d_int_rate(filter_size), d_acc(0), d_last_filter(0), d_start_index(0),
+    d_taps_per_filter(0), d_row_stride(0), d_bank(NULL)
+{
+  if(filter_size == 0)
+    throw std::invalid_argument("gri_pfb_arb_resampler: filter_size must be > 0");
+
+  /* The number of filters is specified by the user as the filter size;
+     this is also the interpolation rate of the filter. We use it and the
+     rate provided to determine the decimation rate. This acts as a
+     rational resampler. The flt_rate is calculated as the residual
+     between the integer decimation rate and the real decimation rate and
+     will be used to determine to interpolation point of the resampling
+     process.
+  */
+  set_rate(rate);
+  set_taps(taps);
+}
+
+gri_pfb_arb_resampler::~gri_pfb_arb_resampler ()
+{
+  gri_fft_free(d_bank);
+}
+
+void
+gri_pfb_arb_resampler::create_diff_taps (const std::vector<float> &newtaps,
+					 std::vector<float> &difftaps)
+{
+  float tap = 0;
+  difftaps.clear();
+  for(unsigned int i = 0; i+1 < newtaps.size(); i++) {
+    tap = newtaps[i+1] - newtaps[i];
+    difftaps.push_back(tap);
+  }
+  difftaps.push_back(tap);
+}
+
+void
+gri_pfb_arb_resampler::partition_taps (const std::vector<float> &newtaps,
+				       std::vector< std::vector<float> > &ourtaps)
+{
+  // filter i lives in ourtaps[d_int_rate-1-i]
+  ourtaps = gri_pfb_partition_taps(newtaps, d_int_rate);
+  std::reverse(ourtaps.begin(), ourtaps.end());
+  d_taps_per_filter = ourtaps[0].size();
+}
+
+void
+gri_pfb_arb_resampler::set_taps (const std::vector<float> &taps)
+{
+  std::vector<float> dtaps;
+  create_diff_taps(taps, dtaps);
+  partition_taps(taps, d_taps);
+  partition_taps(dtaps, d_dtaps);
+
+  // Each row holds d_taps_per_filter (tap, derivative tap) pairs,
+  // padded to a multiple of 4 floats so every row is aligned
+  unsigned int row_stride = std::max(4u, (2*d_taps_per_filter + 3) & ~3u);
+  if(d_bank == NULL || row_stride != d_row_stride) {
+    gri_fft_free(d_bank);
+    d_row_stride = row_stride;
+    d_bank = gri_fft_malloc_float(d_int_rate * d_row_stride);
+    if(d_bank == NULL)
+      throw std::runtime_error("gri_pfb_arb_resampler: can't allocate taps");
+    memset(d_bank, 0, sizeof(float) * d_int_rate * d_row_stride);
+  }
+
+  // Store the taps reversed so each output is a straight dot product
+  // with the oldest sample first.
+  for(unsigned int i = 0; i < d_int_rate; i++) {
+    const std::vector<float> &h = d_taps[d_int_rate-1-i];
+    const std::vector<float> &d = d_dtaps[d_int_rate-1-i];
+    float *row = &d_bank[i * d_row_stride];
+    for(unsigned int k = 0; k < d_taps_per_filter; k++) {
+      row[2*k]   = h[d_taps_per_filter-1-k];
+      row[2*k+1] = d[d_taps_per_filter-1-k];
+    }
+  }
+}
+
+void
+gri_pfb_arb_resampler::set_rate (float rate)
+{
+  d_dec_rate = (unsigned int)floor(d_int_rate/rate);
+  d_flt_rate = (d_int_rate/rate) - d_dec_rate;
+}
+
+void
+gri_pfb_arb_resampler::dot_prod (gr_complex &o, gr_complex &d,
+				 const gr_complex *in, unsigned int j) const
+{
+  gr_complex od[2];
+  volk_32fc_x2_dual_dot_prod_32fc_u(od, in,
+				    (const lv_32fc_t*)&d_bank[j * d_row_stride],
+				    d_taps_per_filter);
+  o = od[0];
+  d = od[1];
+}
+
+void
+gri_pfb_arb_resampler::dot_prod (float &o, float &d,
+				 const float *in, unsigned int j) const
+{
+  gr_complex od;
+  volk_32fc_32f_dot_prod_32fc_u(&od, (const lv_32fc_t*)&d_bank[j * d_row_stride],
+				in, d_taps_per_filter);
+  o = od.real();
+  d = od.imag();
+}
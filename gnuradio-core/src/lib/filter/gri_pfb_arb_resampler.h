@@ -0,0 +1,154 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GRI_PFB_ARB_RESAMPLER_H
+#define INCLUDED_GRI_PFB_ARB_RESAMPLER_H
+
+#include <gr_core_api.h>
+#include <gr_complex.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+/*!
+ * \brief Polyphase filterbank arbitrary resampler engine, common to
+ *        all sample types
+ * \ingroup filter
+ *
+ * The filterbank and its derivative filterbank share one aligned
+ * matrix, one row per filter, with each filter tap stored next to
+ * the matching derivative tap.  A single dot product over a row gives
+ * both the filter and the derivative output that the linear
+ * interpolation between filters needs.  gri_pfb_arb_resampler_ccf
+ * and gri_pfb_arb_resampler_fff supply the dot product for their
+ * sample type.
+ *
+ * The engine is not thread safe; its owner serializes set_taps() and
+ * set_rate() with filtering.
+ */
+class GR_CORE_API gri_pfb_arb_resampler
+{
+ private:
+  unsigned int             d_int_rate;	     // the number of filters (interpolation rate)
+  unsigned int             d_dec_rate;	     // the stride through the filters (decimation rate)
+  float                    d_flt_rate;	     // residual rate for the linear interpolation
+  float                    d_acc;
+  unsigned int             d_last_filter;
+  int                      d_start_index;
+  std::vector< std::vector<float> > d_taps;
+  std::vector< std::vector<float> > d_dtaps;
+  unsigned int             d_taps_per_filter;
+  unsigned int             d_row_stride;     // floats between rows of d_bank
+  float                   *d_bank;	     // reversed (tap, derivative tap) pairs, one row per filter
+
+  void partition_taps (const std::vector<float> &newtaps,
+		       std::vector< std::vector<float> > &ourtaps);
+
+  // filter and derivative filter outputs of row j over in[0..taps_per_filter-1]
+  void dot_prod (gr_complex &o, gr_complex &d, const gr_complex *in, unsigned int j) const;
+  void dot_prod (float &o, float &d, const float *in, unsigned int j) const;
+
+ protected:
+  gri_pfb_arb_resampler (float rate,
+			 const std::vector<float> &taps,
+			 unsigned int filter_size);
+  ~gri_pfb_arb_resampler ();
+
+  /*!
+   * \brief Resample as much of \p input as \p noutput_items allows.
+   * See gri_pfb_arb_resampler_ccf::filter.
+   */
+  template <class T>
+  int resample (T *output, const T *input,
+		int noutput_items, int ninput_items, int &nitems_read);
+
+ public:
+  /*!
+   * \brief Calculate the derivative filter by taking the difference
+   * between consecutive taps, duplicating the last one so that both
+   * filters have the same length.
+   */
+  static void create_diff_taps (const std::vector<float> &newtaps,
+				std::vector<float> &difftaps);
+
+  /*!
+   * \brief Resets the filterbank with a new prototype filter.
+   */
+  void set_taps (const std::vector<float> &taps);
+
+  /*!
+   * \brief Sets the resampling rate.
+   */
+  void set_rate (float rate);
+
+  const std::vector< std::vector<float> > &taps () const { return d_taps; }
+  const std::vector< std::vector<float> > &diff_taps () const { return d_dtaps; }
+  unsigned int taps_per_filter () const { return d_taps_per_filter; }
+  unsigned int interpolation_rate () const { return d_int_rate; }
+};
+
+template <class T>
+int
+gri_pfb_arb_resampler::resample (T *output, const T *input,
+				 int noutput_items, int ninput_items,
+				 int &nitems_read)
+{
+  int i = 0, count = d_start_index;
+  unsigned int j;
+  T o, d;
+
+  // Restore the last filter position
+  j = d_last_filter;
+
+  // produce output as long as we can and there are enough input samples
+  int max_input = ninput_items-(int)d_taps_per_filter;
+  while((i < noutput_items) && (count < max_input)) {
+    // start j by wrapping around mod the number of channels
+    while((j < d_int_rate) && (i < noutput_items)) {
+      // Take the current filter and derivative filter output in one pass
+      dot_prod(o, d, &input[count], j);
+
+      output[i] = o + d*d_acc;           // linearly interpolate between samples
+      i++;
+
+      // Adjust accumulator and index into filterbank
+      d_acc += d_flt_rate;
+      j += d_dec_rate + (int)floor(d_acc);
+      d_acc = fmodf(d_acc, 1.0);
+    }
+    if(i < noutput_items) {              // keep state for next entry
+      float ss = (int)(j / d_int_rate);  // number of items to skip ahead by
+      count += ss;                       // we have fully consumed another input
+      j = j % d_int_rate;                // roll filter around
+    }
+  }
+
+  // Store the current filter position and start of next sample
+  d_last_filter = j;
+  d_start_index = std::max(0, count - ninput_items);
+
+  // consume all we've processed but no more than we can
+  nitems_read = std::min(count, ninput_items);
+  return i;
+}
+
+#endif /* INCLUDED_GRI_PFB_ARB_RESAMPLER_H */
@@ -0,0 +1,42 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_pfb_arb_resampler_fff.h>
+
+gri_pfb_arb_resampler_fff::gri_pfb_arb_resampler_fff (float rate,
+						      const std::vector<float> &taps,
+						      unsigned int filter_size)
+  : gri_pfb_arb_resampler(rate, taps, filter_size)
+{
+}
+
+int
+gri_pfb_arb_resampler_fff::filter (float *output, const float *input,
+				   int noutput_items, int ninput_items,
+				   int &nitems_read)
+{
+  return resample(output, input, noutput_items, ninput_items, nitems_read);
+}
@@ -0,0 +1,67 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GRI_PFB_ARB_RESAMPLER_FFF_H
+#define INCLUDED_GRI_PFB_ARB_RESAMPLER_FFF_H
+
+#include <gri_pfb_arb_resampler.h>
+
+/*!
+ * \brief Polyphase filterbank arbitrary resampler engine with float
+ *        input, float output and float taps
+ * \ingroup filter
+ *
+ * This is the filtering core of gr_pfb_arb_resampler_fff; each row of
+ * the filterbank is run with one pass of volk_32fc_32f_dot_prod_32fc.
+ * See gri_pfb_arb_resampler.
+ */
+class GR_CORE_API gri_pfb_arb_resampler_fff : public gri_pfb_arb_resampler
+{
+ public:
+  /*!
+   * \brief Build the arbitrary resampler engine.
+   * \param rate        The resampling rate
+   * \param taps        The prototype filter, designed at filter_size
+   *                    times the input rate
+   * \param filter_size The number of filters in the filterbank
+   */
+  gri_pfb_arb_resampler_fff (float rate,
+			     const std::vector<float> &taps,
+			     unsigned int filter_size);
+
+  /*!
+   * \brief Resample as much of \p input as \p noutput_items allows.
+   *
+   * \param output        output buffer
+   * \param input         input buffer, with taps_per_filter() items of
+   *                      history
+   * \param noutput_items space available in \p output
+   * \param ninput_items  items available in \p input
+   * \param nitems_read   set to the number of input items consumed
+   *
+   * \returns the number of output items produced.
+   */
+  int filter (float *output, const float *input,
+	      int noutput_items, int ninput_items, int &nitems_read);
+};
+
+#endif /* INCLUDED_GRI_PFB_ARB_RESAMPLER_FFF_H */
@@ -0,0 +1,201 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_pfb_channelizer_ccf.h>
+#include <gri_fft.h>
+#include <gri_pfb_partition_taps.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+
+// Keep a batch of FFT input vectors around 64 kB
+static const unsigned int MAX_BATCH_ITEMS = 8192;
+static const unsigned int MAX_BATCH = 64;
+
+gri_pfb_channelizer_ccf::gri_pfb_channelizer_ccf (unsigned int numchans,
+						  const std::vector<float> &taps,
+						  int rate_ratio)
+  : d_numchans(numchans), d_rate_ratio(rate_ratio),
+    d_taps_per_filter(0), d_row_stride(0), d_taps_matrix(NULL)
+{
+  if(numchans == 0)
+    throw std::invalid_argument("gri_pfb_channelizer_ccf: numchans must be > 0");
+  if(rate_ratio <= 0 || rate_ratio > (int)numchans)
+    throw std::invalid_argument("gri_pfb_channelizer_ccf: rate_ratio must be in [1, numchans]");
+
+  build_schedule();
+  set_taps(taps);
+
+  d_batch = std::max(1u, std::min(MAX_BATCH, MAX_BATCH_ITEMS / d_numchans));
+  d_fft_batch = new gri_fft_complex (d_numchans, false, 1, d_batch);
+  d_fft = new gri_fft_complex (d_numchans, false);
+}
+
+gri_pfb_channelizer_ccf::~gri_pfb_channelizer_ccf ()
+{
+  delete d_fft_batch;
+  delete d_fft;
+  gri_fft_free(d_taps_matrix);
+}
+
+void
+gri_pfb_channelizer_ccf::build_schedule()
+{
+  // Although the filters change, we use this look up table
+  // to set the index of the FFT input buffer, which equivalently
+  // performs the FFT shift operation on every other turn.
+  d_idxlut.resize(d_numchans);
+  for(unsigned int i = 0; i < d_numchans; i++) {
+    d_idxlut[i] = d_numchans - ((i + d_rate_ratio) % d_numchans) - 1;
+  }
+
+  // Calculate the number of filtering rounds to do to evenly
+  // align the input vectors with the output channels
+  d_period = 1;
+  while((d_period * d_rate_ratio) % d_numchans != 0)
+    d_period++;
+
+  // Walk the arms over the input streams for one period.  With an
+  // oversampled output the arm that filters a stream rotates from
+  // vector to vector, and the streams past the last arm to wrap
+  // still use the previous sample.
+  d_sched_filter.resize(d_period * d_numchans);
+  d_sched_offset.resize(d_period * d_numchans);
+
+  int n = 1, i = -1, j, last;
+  for(unsigned int v = 0; v < d_period; v++) {
+    unsigned int *filt = &d_sched_filter[v * d_numchans];
+    unsigned int *off = &d_sched_offset[v * d_numchans];
+
+    j = 0;
+    i = (i + d_rate_ratio) % d_numchans;
+    last = i;
+    while(i >= 0) {
+      filt[j] = i;
+      off[j] = n;
+      j++;
+      i--;
+    }
+
+    i = d_numchans-1;
+    while(i > last) {
+      filt[j] = i;
+      off[j] = n-1;
+      j++;
+      i--;
+    }
+
+    n += (i+d_rate_ratio) >= (int)d_numchans;
+  }
+  d_period_consume = n - 1;
+}
+
+void
+gri_pfb_channelizer_ccf::set_taps (const std::vector<float> &taps)
+{
+  d_taps = gri_pfb_partition_taps(taps, d_numchans);
+  unsigned int taps_per_filter = d_taps[0].size();
+
+  if(d_taps_matrix == NULL || taps_per_filter != d_taps_per_filter) {
+    gri_fft_free(d_taps_matrix);
+    d_taps_per_filter = taps_per_filter;
+
+    // Pad each row to a multiple of 4 floats so every row is aligned
+    d_row_stride = std::max(4u, (d_taps_per_filter + 3) & ~3u);
+    d_taps_matrix = gri_fft_malloc_float(d_numchans * d_row_stride);
+    if(d_taps_matrix == NULL)
+      throw std::runtime_error("gri_pfb_channelizer_ccf: can't allocate taps");
+    memset(d_taps_matrix, 0, sizeof(float) * d_numchans * d_row_stride);
+  }
+
+  // Store the taps reversed so each output is a straight dot product
+  // with the oldest sample first.
+  for(unsigned int i = 0; i < d_numchans; i++) {
+    std::reverse_copy(d_taps[i].begin(), d_taps[i].end(),
+		      &d_taps_matrix[i * d_row_stride]);
+  }
+}
+
+void
+gri_pfb_channelizer_ccf::load_vectors(gr_complex *fftin,
+				      const gr_complex * const input[],
+				      unsigned int first, unsigned int count)
+{
+  for(unsigned int j = 0; j < d_numchans; j++) {
+    const gr_complex *in = input[j];
+    gr_complex *dst = &fftin[d_idxlut[j]];
+
+    for(unsigned int b = 0; b < count; b++) {
+      unsigned int v = first + b;
+      unsigned int phase = v % d_period;
+      unsigned int idx = phase * d_numchans + j;
+      unsigned int n = (v / d_period) * d_period_consume + d_sched_offset[idx];
+      const float *row = &d_taps_matrix[d_sched_filter[idx] * d_row_stride];
+
+      volk_32fc_32f_dot_prod_32fc_u(&dst[b * d_numchans], &in[n],
+				    row, d_taps_per_filter);
+    }
+  }
+}
+
+int
+gri_pfb_channelizer_ccf::filter (gr_complex * const output[],
+				 const int channel_map[],
+				 unsigned int noutputs,
+				 const gr_complex * const input[],
+				 int noutput_items)
+{
+  unsigned int nvectors = noutput_items;
+  unsigned int v = 0;
+
+  while(v < nvectors) {
+    gri_fft_complex *fft = d_fft_batch;
+    unsigned int count = d_batch;
+    if(nvectors - v < d_batch) {
+      fft = d_fft;
+      count = 1;
+    }
+
+    load_vectors(fft->get_inbuf(), input, v, count);
+
+    // despin all of the vectors through one FFT plan execution
+    fft->execute();
+
+    // Send to output channels
+    const gr_complex *fftout = fft->get_outbuf();
+    for(unsigned int b = 0; b < count; b++) {
+      for(unsigned int nn = 0; nn < noutputs; nn++) {
+	output[nn][v + b] = fftout[b * d_numchans + channel_map[nn]];
+      }
+    }
+
+    v += count;
+  }
+
+  return (nvectors / d_period) * d_period_consume;
+}
@@ -0,0 +1,116 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GRI_PFB_CHANNELIZER_CCF_H
+#define INCLUDED_GRI_PFB_CHANNELIZER_CCF_H
+
+#include <gr_core_api.h>
+#include <gr_complex.h>
+#include <vector>
+
+class gri_fft_complex;
+
+/*!
+ * \brief Polyphase filterbank channelizer engine with gr_complex
+ *        input, gr_complex output and float taps
+ * \ingroup filter
+ *
+ * This is the filtering core of gr_pfb_channelizer_ccf.  All of the
+ * polyphase arms live in one aligned tap matrix, one row per arm,
+ * and the engine produces output vectors in batches: each arm is run
+ * over every vector of a batch before moving on to the next arm, so
+ * an arm's taps stay in cache while its input stream is swept with
+ * a SIMD dot product.  The batch is then despun with one FFTW plan
+ * execution that covers all of its transforms.
+ *
+ * The engine is not thread safe; its owner serializes set_taps()
+ * with filter().
+ */
+class GR_CORE_API gri_pfb_channelizer_ccf
+{
+ private:
+  unsigned int             d_numchans;
+  int                      d_rate_ratio;
+  unsigned int             d_period;	      // output vectors per stream/arm pattern
+  unsigned int             d_period_consume;  // input items consumed per pattern
+  std::vector<unsigned int> d_sched_filter;   // arm used on stream j for vector v
+  std::vector<unsigned int> d_sched_offset;   // sample of stream j used for vector v
+  std::vector<unsigned int> d_idxlut;	      // FFT bin fed by stream j
+  std::vector< std::vector<float> > d_taps;
+  unsigned int             d_taps_per_filter;
+  unsigned int             d_row_stride;      // floats between rows of d_taps_matrix
+  float                   *d_taps_matrix;     // reversed taps, one row per arm
+  unsigned int             d_batch;
+  gri_fft_complex         *d_fft_batch;	      // d_batch transforms per execute
+  gri_fft_complex         *d_fft;	      // one transform, for the leftovers
+
+  void build_schedule();
+  void load_vectors(gr_complex *fftin, const gr_complex * const input[],
+		    unsigned int first, unsigned int count);
+
+ public:
+  /*!
+   * \brief Build the channelizer engine.
+   * \param numchans   Number of channels <EM>M</EM>
+   * \param taps       The prototype filter
+   * \param rate_ratio Input samples (over all <EM>M</EM> streams)
+   *                   consumed per output vector;
+   *                   numchans / oversample_rate.
+   */
+  gri_pfb_channelizer_ccf (unsigned int numchans,
+			   const std::vector<float> &taps,
+			   int rate_ratio);
+  ~gri_pfb_channelizer_ccf ();
+
+  /*!
+   * \brief Resets the filterbank with a new prototype filter.
+   */
+  void set_taps (const std::vector<float> &taps);
+
+  const std::vector< std::vector<float> > &taps () const { return d_taps; }
+  unsigned int taps_per_filter () const { return d_taps_per_filter; }
+
+  /*!
+   * \brief The number of output vectors after which the assignment of
+   * arms to input streams repeats.  noutput_items passed to filter()
+   * must be a multiple of this.
+   */
+  unsigned int output_multiple () const { return d_period; }
+
+  /*!
+   * \brief Run the filterbank.
+   *
+   * \param output       one buffer per output stream
+   * \param channel_map  channel written to each output stream
+   * \param noutputs     number of output streams
+   * \param input        the <EM>M</EM> deinterleaved input streams, each
+   *                     with taps_per_filter() items of history
+   * \param noutput_items number of output vectors to produce
+   *
+   * \returns the number of items consumed from each input stream.
+   */
+  int filter (gr_complex * const output[], const int channel_map[],
+	      unsigned int noutputs, const gr_complex * const input[],
+	      int noutput_items);
+};
+
+#endif /* INCLUDED_GRI_PFB_CHANNELIZER_CCF_H */
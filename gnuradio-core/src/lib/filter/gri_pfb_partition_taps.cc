@@ -0,0 +1,40 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gri_pfb_partition_taps.h>
+#include <algorithm>
+
+std::vector< std::vector<float> >
+gri_pfb_partition_taps (const std::vector<float> &taps, unsigned int nfilts)
+{
+  unsigned int ntaps = taps.size();
+  unsigned int taps_per_filter = std::max(1u, (ntaps + nfilts - 1) / nfilts);
+
+  std::vector< std::vector<float> > parts(nfilts, std::vector<float>(taps_per_filter, 0));
+  for(unsigned int k = 0; k < ntaps; k++)
+    parts[k % nfilts][k / nfilts] = taps[k];
+  return parts;
+}
@@ -0,0 +1,39 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GRI_PFB_PARTITION_TAPS_H
+#define INCLUDED_GRI_PFB_PARTITION_TAPS_H
+
+#include <gr_core_api.h>
+#include <vector>
+
+/*!
+ * \brief Split the prototype filter \p taps into \p nfilts polyphase
+ * arms; tap j of arm i is taps[i + j*nfilts].
+ *
+ * The taps are padded with 0's so that all arms have the same length,
+ * and every arm gets at least one tap.
+ */
+GR_CORE_API std::vector< std::vector<float> >
+gri_pfb_partition_taps (const std::vector<float> &taps, unsigned int nfilts);
+
+#endif /* INCLUDED_GRI_PFB_PARTITION_TAPS_H */
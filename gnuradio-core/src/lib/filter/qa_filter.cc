@@ -33,8 +33,12 @@
 #include <qa_gr_fir_scc.h>
 #include <qa_gr_firdes.h>
 #include <qa_dotprod.h>
+#include <qa_gri_block_lms_ccc.h>
+#include <qa_gri_iir_sos.h>
 #include <qa_gri_mmse_fir_interpolator.h>
 #include <qa_gri_mmse_fir_interpolator_cc.h>
+#include <qa_gri_pfb_arb_resampler.h>
+#include <qa_gri_pfb_channelizer_ccf.h>
 #include <qa_gr_rotator.h>
 #include <qa_gri_fir_filter_with_buffer_ccf.h>
 #include <qa_gri_fir_filter_with_buffer_ccc.h>
@@ -54,8 +58,12 @@ qa_filter::suite ()
   s->addTest (qa_gr_fir_fcc::suite ());
   s->addTest (qa_gr_fir_scc::suite ());
   s->addTest (qa_gr_fir_ccf::suite ());
+  s->addTest (qa_gri_block_lms_ccc::suite ());
+  s->addTest (qa_gri_iir_sos::suite ());
   s->addTest (qa_gri_mmse_fir_interpolator::suite ());
   s->addTest (qa_gri_mmse_fir_interpolator_cc::suite ());
+  s->addTest (qa_gri_pfb_arb_resampler::suite ());
+  s->addTest (qa_gri_pfb_channelizer_ccf::suite ());
   s->addTest (qa_gr_rotator::suite ());
   s->addTest (qa_gri_fir_filter_with_buffer_ccf::suite ());
   s->addTest (qa_gri_fir_filter_with_buffer_ccc::suite ());
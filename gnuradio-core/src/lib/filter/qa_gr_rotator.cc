@@ -31,6 +31,7 @@
 #include <stdio.h>
 #include <cmath>
 #include <gr_expj.h>
+#include <algorithm>
 
 
 // error vector magnitude
@@ -73,3 +74,74 @@ qa_gr_rotator::t1 ()
       phase -= 2*M_PI;
   }
 }
+
+void
+qa_gr_rotator::t2 ()
+{
+  static const unsigned	int N = 100000;
+
+  gr_rotator	r;
+  gr_complex	*input = new gr_complex[N];
+  gr_complex	*output = new gr_complex[N];
+
+  double phase_incr = 2*M_PI / 1003;
+  double phase = 0;
+
+  r.set_phase(gr_complex(1,0));
+  r.set_phase_incr(gr_expj(phase_incr));
+
+  for (unsigned i = 0; i < N; i++)
+    input[i] = gr_complex(1, 0);
+
+  // Rotate in uneven pieces to make sure the phase carries over
+  unsigned int n = 0;
+  for (unsigned int len = 1; n < N; len = 2*len + 1){
+    unsigned int this_len = std::min(len, N - n);
+    r.rotateN(&output[n], &input[n], this_len);
+    n += this_len;
+  }
+
+  for (unsigned i = 0; i < N; i++){
+    gr_complex expected = gr_expj(phase);
+    CPPUNIT_ASSERT_COMPLEXES_EQUAL(expected, output[i], 0.0001);
+
+    phase += phase_incr;
+    if (phase >= 2*M_PI)
+      phase -= 2*M_PI;
+  }
+
+  delete [] input;
+  delete [] output;
+}
+
+void
+qa_gr_rotator::t3 ()
+{
+  static const unsigned	int N = 1000000;
+
+  gr_rotator	r;
+  gr_complex	*input = new gr_complex[N];
+  gr_complex	*output = new gr_complex[N];
+
+  double phase_incr = 2*M_PI / 1003;
+
+  r.set_phase(gr_complex(1,0));
+  r.set_phase_incr(gr_expj(phase_incr));
+
+  for (unsigned i = 0; i < N; i++)
+    input[i] = gr_complex(1, 0);
+
+  // One long call, then single samples; the magnitude must not drift
+  // in either case.
+  r.rotateN(output, input, N);
+  for (unsigned i = 0; i < N; i += 1024)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, abs(output[i]), 0.0001);
+
+  for (unsigned i = 0; i < N; i++)
+    r.rotateN(&output[i], &input[i], 1);
+  for (unsigned i = 0; i < N; i += 1024)
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, abs(output[i]), 0.0001);
+
+  delete [] input;
+  delete [] output;
+}
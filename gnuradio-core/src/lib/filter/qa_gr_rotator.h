@@ -29,10 +29,14 @@ class qa_gr_rotator : public CppUnit::TestCase {
 
   CPPUNIT_TEST_SUITE (qa_gr_rotator);
   CPPUNIT_TEST (t1);
+  CPPUNIT_TEST (t2);
+  CPPUNIT_TEST (t3);
   CPPUNIT_TEST_SUITE_END ();
 
  private:
   void t1 ();
+  void t2 ();
+  void t3 ();
 
 };
 
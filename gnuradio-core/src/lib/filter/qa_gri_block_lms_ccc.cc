@@ -0,0 +1,111 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cppunit/TestAssert.h>
+#include <qa_gri_block_lms_ccc.h>
+#include <gri_block_lms_ccc.h>
+#include <algorithm>
+#include <random.h>
+
+static gr_complex
+uniform()
+{
+  return gr_complex(2.0 * ((float) random() / RANDOM_MAX - 0.5),
+		    2.0 * ((float) random() / RANDOM_MAX - 0.5));
+}
+
+// Run the engine next to a direct block LMS over random input, with
+// the error taken against a constant reference.
+static void
+test_block_lms(int ntaps, int decimation, int block_size,
+	       bool conj_input, bool frequency_domain)
+{
+  const int NOUT = 300;
+  const gr_complex mu(0.005, 0.001);
+
+  std::vector<gr_complex> x((NOUT - 1) * decimation + ntaps);
+  std::vector<gr_complex> taps(ntaps);
+  for(size_t i = 0; i < x.size(); i++)
+    x[i] = uniform();
+  for(int k = 0; k < ntaps; k++)
+    taps[k] = uniform();
+
+  gri_block_lms_ccc lms(ntaps, decimation, block_size);
+  lms.set_taps(taps);
+  CPPUNIT_ASSERT_EQUAL(frequency_domain, lms.frequency_domain());
+
+  std::vector<gr_complex> out(block_size), err(block_size);
+  for(int i = 0; i < NOUT; i += block_size) {
+    int n = std::min(block_size, NOUT - i);
+    const gr_complex *xb = &x[i * decimation];
+
+    lms.filter(&out[0], xb, n);
+    for(int m = 0; m < n; m++) {
+      gr_complex expected = 0;
+      for(int k = 0; k < ntaps; k++)
+	expected += taps[ntaps-1-k] * xb[m*decimation + k];
+      CPPUNIT_ASSERT(abs(expected - out[m]) < 1e-4);
+      err[m] = gr_complex(1, 0) - expected;
+    }
+
+    lms.update(xb, &err[0], n, mu, conj_input);
+    for(int m = 0; m < n; m++) {
+      for(int k = 0; k < ntaps; k++) {
+	gr_complex in = xb[m*decimation + k];
+	taps[ntaps-1-k] += mu * err[m] * (conj_input ? conj(in) : in);
+      }
+    }
+  }
+
+  std::vector<gr_complex> result;
+  lms.get_taps(result);
+  for(int k = 0; k < ntaps; k++)
+    CPPUNIT_ASSERT(abs(taps[k] - result[k]) < 1e-4);
+}
+
+// time domain, including the per-sample (block size 1) update
+void
+qa_gri_block_lms_ccc::t1()
+{
+  static const int block_sizes[] = { 1, 7, 16 };
+  for(int b = 0; b < 3; b++) {
+    for(int decimation = 1; decimation <= 2; decimation++) {
+      test_block_lms(11, decimation, block_sizes[b], false, false);
+      test_block_lms(11, decimation, block_sizes[b], true, false);
+    }
+  }
+}
+
+// frequency domain
+void
+qa_gri_block_lms_ccc::t2()
+{
+  for(int decimation = 1; decimation <= 2; decimation++) {
+    test_block_lms(64, decimation, 64, false, true);
+    test_block_lms(64, decimation, 64, true, true);
+    test_block_lms(40, decimation, 37, true, true);
+  }
+}
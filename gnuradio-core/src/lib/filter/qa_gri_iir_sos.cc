@@ -0,0 +1,153 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cppunit/TestAssert.h>
+#include <qa_gri_iir_sos.h>
+#include <gri_iir_sos.h>
+#include <gri_iir.h>
+#include <gr_complex.h>
+#include <cmath>
+#include <random.h>
+
+static float
+uniform()
+{
+  return 2.0 * ((float) random() / RANDOM_MAX - 0.5);	// uniformly (-1, 1)
+}
+
+// multiply the polynomial p (in z^-1) by (1 - r z^-1)
+static void
+poly_mul_root(std::vector<gr_complexd> &p, gr_complexd r)
+{
+  p.push_back(0);
+  for(int k = p.size() - 1; k > 0; k--)
+    p[k] -= r * p[k-1];
+}
+
+// Butterworth lowpass of the given order, by the bilinear transform,
+// with taps in the gri_iir convention.
+static void
+butterworth(int order, double fc,
+	    std::vector<double> &fftaps, std::vector<double> &fbtaps)
+{
+  double wc = 2 * tan(M_PI * fc);
+  std::vector<gr_complexd> num(1, 1.0), den(1, 1.0);
+
+  for(int k = 0; k < order; k++) {
+    gr_complexd s = std::polar(wc, M_PI * (2*k + order + 1) / (2*order));
+    poly_mul_root(den, (1.0 + s/2.0) / (1.0 - s/2.0));
+    poly_mul_root(num, -1.0);
+  }
+
+  // unity gain at DC
+  gr_complexd nsum = 0, dsum = 0;
+  for(int k = 0; k <= order; k++) {
+    nsum += num[k];
+    dsum += den[k];
+  }
+
+  fftaps.resize(order + 1);
+  fbtaps.resize(order + 1);
+  for(int k = 0; k <= order; k++) {
+    fftaps[k] = (num[k] * dsum / nsum).real();
+    fbtaps[k] = -den[k].real();
+  }
+}
+
+static void
+check_impulse_response(const std::vector<double> &fftaps,
+		       const std::vector<double> &fbtaps, double tol)
+{
+  gri_iir<double,double,double> df(fftaps, fbtaps);
+  gri_iir_sos<double,double,double> sos(gri_iir_tf2sos(fftaps, fbtaps));
+
+  for(int i = 0; i < 400; i++) {
+    double x = (i == 0) ? 1.0 : 0.0;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(df.filter(x), sos.filter(x), tol);
+  }
+}
+
+/*
+ * A 6th order Butterworth lowpass, with all its zeros at z = -1
+ */
+void
+qa_gri_iir_sos::t1()
+{
+  std::vector<double> fftaps, fbtaps;
+  butterworth(6, 0.1, fftaps, fbtaps);
+
+  CPPUNIT_ASSERT_EQUAL((size_t) 15, gri_iir_tf2sos(fftaps, fbtaps).size());
+  check_impulse_response(fftaps, fbtaps, 1e-6);
+}
+
+/*
+ * Odd orders, a pure delay and a single pole
+ */
+void
+qa_gri_iir_sos::t2()
+{
+  std::vector<double> fftaps, fbtaps;
+  butterworth(5, 0.23, fftaps, fbtaps);
+  check_impulse_response(fftaps, fbtaps, 1e-6);
+
+  double ff[] = { 0.0, 0.5, 0.3 };
+  double fb[] = { 0.0, 0.5 };
+  check_impulse_response(std::vector<double>(ff, ff + 3),
+			 std::vector<double>(fb, fb + 2), 1e-9);
+
+  double ff2[] = { 2.0, -1.0 };
+  check_impulse_response(std::vector<double>(ff2, ff2 + 2),
+			 std::vector<double>(1, 0.0), 1e-9);
+}
+
+/*
+ * Each lane of gri_iir_sos_lanes matches the scalar cascade
+ */
+void
+qa_gri_iir_sos::t3()
+{
+  const int L = gri_iir_sos_lanes::NLANES;
+  const int N = 300;
+
+  std::vector<double> fftaps, fbtaps;
+  butterworth(4, 0.05, fftaps, fbtaps);
+  std::vector<double> sos = gri_iir_tf2sos(fftaps, fbtaps);
+
+  gri_iir_sos_lanes lanes(sos);
+  std::vector<float> in(N * L), out(N * L);
+  for(int i = 0; i < N * L; i++)
+    in[i] = uniform();
+
+  // in two chunks to check the state carries over
+  lanes.filter_n(&out[0], &in[0], N/3);
+  lanes.filter_n(&out[N/3 * L], &in[N/3 * L], N - N/3);
+
+  for(int l = 0; l < L; l++) {
+    gri_iir_sos<float,float,double> ref(sos);
+    for(int i = 0; i < N; i++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(ref.filter(in[i*L + l]), out[i*L + l], 1e-4);
+  }
+}
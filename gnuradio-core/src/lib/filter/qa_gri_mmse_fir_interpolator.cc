@@ -64,3 +64,34 @@ qa_gri_mmse_fir_interpolator::t1 ()
   }
 }
 
+
+/*
+ * Check the batch interface against interpolate with irregular
+ * positions and fractional delays.
+ */
+void
+qa_gri_mmse_fir_interpolator::t2 ()
+{
+  static const int N = 100;
+  float input[N + 10];
+  float actual[N];
+  int offset[N];
+  float mu[N];
+
+  for (unsigned i = 0; i < NELEM(input); i++)
+    input[i] = test_fcn ((double) i);
+
+  gri_mmse_fir_interpolator	intr;
+
+  for (int i = 0; i < N; i++){
+    offset[i] = (i * 7) % N;
+    mu[i] = (i % 13) / 12.0;
+  }
+
+  intr.interpolate_n (actual, input, offset, mu, N);
+
+  for (int i = 0; i < N; i++){
+    float expected = intr.interpolate (&input[offset[i]], mu[i]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL (expected, actual[i], 1e-5);
+  }
+}
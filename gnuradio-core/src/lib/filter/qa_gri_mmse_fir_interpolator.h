@@ -29,10 +29,12 @@ class qa_gri_mmse_fir_interpolator : public CppUnit::TestCase {
 
   CPPUNIT_TEST_SUITE (qa_gri_mmse_fir_interpolator);
   CPPUNIT_TEST (t1);
+  CPPUNIT_TEST (t2);
   CPPUNIT_TEST_SUITE_END ();
 
  private:
   void t1 ();
+  void t2 ();
 
 };
 
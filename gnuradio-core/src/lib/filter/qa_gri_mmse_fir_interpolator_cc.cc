@@ -122,3 +122,34 @@ qa_gri_mmse_fir_interpolator_cc::t2()
 {
   CPPUNIT_ASSERT_THROW(t2_body(), std::invalid_argument);
 }
+
+/*
+ * Check the batch interface against interpolate with irregular
+ * positions and fractional delays.
+ */
+void
+qa_gri_mmse_fir_interpolator_cc::t3()
+{
+  static const int N = 100;
+  gr_complex input[N + 10];
+  gr_complex actual[N];
+  int offset[N];
+  float mu[N];
+
+  for (unsigned i = 0; i < NELEM(input); i++)
+    input[i] = test_fcn ((double) i);
+
+  gri_mmse_fir_interpolator_cc	intr;
+
+  for (int i = 0; i < N; i++){
+    offset[i] = (i * 7) % N;
+    mu[i] = (i % 13) / 12.0;
+  }
+
+  intr.interpolate_n (actual, input, offset, mu, N);
+
+  for (int i = 0; i < N; i++){
+    gr_complex expected = intr.interpolate (&input[offset[i]], mu[i]);
+    CPPUNIT_ASSERT_COMPLEXES_EQUAL (expected, actual[i], 1e-5);
+  }
+}
@@ -0,0 +1,189 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cppunit/TestAssert.h>
+#include <qa_gri_pfb_arb_resampler.h>
+#include <gri_pfb_arb_resampler_ccf.h>
+#include <gri_pfb_arb_resampler_fff.h>
+#include <gr_complex.h>
+#include <algorithm>
+#include <cmath>
+#include <random.h>
+
+static float
+uniform()
+{
+  return 2.0 * ((float) random() / RANDOM_MAX - 0.5);	// uniformly (-1, 1)
+}
+
+template <class T>
+static T
+arm_filter(const std::vector<float> &arm, const T *in)
+{
+  unsigned int ntaps = arm.size();
+  T acc = 0;
+  for(unsigned int t = 0; t < ntaps; t++)
+    acc += in[t] * arm[ntaps-1-t];
+  return acc;
+}
+
+/*
+ * Straightforward resampler: a filter and a derivative filter per
+ * output, following the original gr_pfb_arb_resampler_ccf work loop.
+ */
+template <class T>
+class reference_resampler
+{
+  unsigned int d_int_rate, d_dec_rate;
+  float d_flt_rate, d_acc;
+  unsigned int d_last_filter;
+  int d_start_index;
+  std::vector< std::vector<float> > d_taps, d_dtaps;
+
+public:
+  reference_resampler(float rate, const std::vector<float> &taps,
+		      const std::vector<float> &dtaps, unsigned int filter_size)
+    : d_int_rate(filter_size), d_acc(0), d_last_filter(0), d_start_index(0),
+      d_taps(filter_size), d_dtaps(filter_size)
+  {
+    d_dec_rate = (unsigned int)floor(d_int_rate/rate);
+    d_flt_rate = (d_int_rate/rate) - d_dec_rate;
+
+    unsigned int ntaps = (unsigned int)ceil((double)taps.size()/filter_size);
+    for(unsigned int i = 0; i < filter_size; i++) {
+      d_taps[i].resize(ntaps, 0);
+      d_dtaps[i].resize(ntaps, 0);
+      for(unsigned int j = 0; j < ntaps; j++) {
+	if(i + j*filter_size < taps.size()) {
+	  d_taps[i][j] = taps[i + j*filter_size];
+	  d_dtaps[i][j] = dtaps[i + j*filter_size];
+	}
+      }
+    }
+  }
+
+  int filter(T *out, const T *in, int noutput_items, int ninput_items,
+	     int &nitems_read)
+  {
+    int i = 0, count = d_start_index;
+    unsigned int j = d_last_filter;
+    int max_input = ninput_items - (int)d_taps[0].size();
+    while((i < noutput_items) && (count < max_input)) {
+      while((j < d_int_rate) && (i < noutput_items)) {
+	T o0 = arm_filter(d_taps[j], &in[count]);
+	T o1 = arm_filter(d_dtaps[j], &in[count]);
+	out[i++] = o0 + o1*d_acc;
+	d_acc += d_flt_rate;
+	j += d_dec_rate + (int)floor(d_acc);
+	d_acc = fmodf(d_acc, 1.0);
+      }
+      if(i < noutput_items) {
+	count += (int)(j / d_int_rate);
+	j = j % d_int_rate;
+      }
+    }
+    d_last_filter = j;
+    d_start_index = std::max(0, count - ninput_items);
+    nitems_read = std::min(count, ninput_items);
+    return i;
+  }
+};
+
+static float
+abs_diff(float a, float b)
+{
+  return std::abs(a - b);
+}
+
+static float
+abs_diff(const gr_complex &a, const gr_complex &b)
+{
+  return std::abs(a - b);
+}
+
+template <class T, class RESAMP>
+static void
+test_resampler(float rate, unsigned int filter_size, unsigned int ntaps,
+	       T (*gen)())
+{
+  std::vector<float> taps(ntaps);
+  for(unsigned int i = 0; i < taps.size(); i++)
+    taps[i] = uniform();
+  std::vector<float> dtaps;
+  RESAMP::create_diff_taps(taps, dtaps);
+
+  RESAMP resamp(rate, taps, filter_size);
+  reference_resampler<T> ref(rate, taps, dtaps, filter_size);
+  CPPUNIT_ASSERT_EQUAL((unsigned int)ceil((double)ntaps/filter_size),
+		       resamp.taps_per_filter());
+
+  std::vector<T> input(2000);
+  for(unsigned int k = 0; k < input.size(); k++)
+    input[k] = gen();
+
+  // Feed both in uneven chunks so the state carried between calls
+  // is exercised too.
+  std::vector<T> out(1000), expected(1000);
+  int nin = 0, nin_ref = 0;
+  for(int chunk = 1; nin + 50 < (int)input.size(); chunk = chunk*7 % 97) {
+    int avail = std::min((int)input.size() - nin, 3*chunk + 20);
+    int nread, nread_ref;
+    int nout = resamp.filter(&out[0], &input[nin], chunk, avail, nread);
+    int nout_ref = ref.filter(&expected[0], &input[nin_ref], chunk, avail, nread_ref);
+
+    CPPUNIT_ASSERT_EQUAL(nout_ref, nout);
+    CPPUNIT_ASSERT_EQUAL(nread_ref, nread);
+    for(int k = 0; k < nout; k++)
+      CPPUNIT_ASSERT(abs_diff(expected[k], out[k]) < 1e-4);
+
+    nin += nread;
+    nin_ref += nread_ref;
+  }
+}
+
+static gr_complex
+complex_sample()
+{
+  return gr_complex(uniform(), uniform());
+}
+
+void
+qa_gri_pfb_arb_resampler::t1()
+{
+  test_resampler<gr_complex, gri_pfb_arb_resampler_ccf>(1.0, 32, 32*9, complex_sample);
+  test_resampler<gr_complex, gri_pfb_arb_resampler_ccf>(0.7341, 32, 32*9+5, complex_sample);
+  test_resampler<gr_complex, gri_pfb_arb_resampler_ccf>(2.4816, 16, 100, complex_sample);
+  test_resampler<gr_complex, gri_pfb_arb_resampler_ccf>(5.0, 8, 8*4, complex_sample);
+}
+
+void
+qa_gri_pfb_arb_resampler::t2()
+{
+  test_resampler<float, gri_pfb_arb_resampler_fff>(1.0, 32, 32*9, uniform);
+  test_resampler<float, gri_pfb_arb_resampler_fff>(0.7341, 32, 32*9+5, uniform);
+  test_resampler<float, gri_pfb_arb_resampler_fff>(2.4816, 16, 100, uniform);
+  test_resampler<float, gri_pfb_arb_resampler_fff>(5.0, 8, 8*4, uniform);
+}
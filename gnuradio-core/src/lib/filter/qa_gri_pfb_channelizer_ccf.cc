@@ -0,0 +1,139 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cppunit/TestAssert.h>
+#include <qa_gri_pfb_channelizer_ccf.h>
+#include <gri_pfb_channelizer_ccf.h>
+#include <gri_pfb_partition_taps.h>
+#include <gr_expj.h>
+#include <cmath>
+#include <random.h>
+
+static float
+uniform()
+{
+  return 2.0 * ((float) random() / RANDOM_MAX - 0.5);	// uniformly (-1, 1)
+}
+
+static gr_complex
+arm_filter(const std::vector<float> &arm, const gr_complex *in)
+{
+  unsigned int T = arm.size();
+  gr_complex acc = 0;
+  for(unsigned int t = 0; t < T; t++)
+    acc += in[t] * arm[T-1-t];
+  return acc;
+}
+
+/*
+ * Straightforward channelizer: one dot product per arm per output
+ * vector followed by a direct DFT, following the arm and stream
+ * rotation of the original gr_pfb_channelizer_ccf work loop.
+ */
+static void
+test_channelizer(unsigned int M, int R, int nrounds)
+{
+  std::vector<float> taps(7*M + 3);
+  for(unsigned int i = 0; i < taps.size(); i++)
+    taps[i] = uniform();
+
+  gri_pfb_channelizer_ccf chan(M, taps, R);
+  unsigned int T = chan.taps_per_filter();
+  int nout = nrounds * chan.output_multiple();
+
+  std::vector< std::vector<gr_complex> > streams(M);
+  std::vector<const gr_complex*> in(M);
+  for(unsigned int j = 0; j < M; j++) {
+    streams[j].resize(nout + T + 1);
+    for(unsigned int k = 0; k < streams[j].size(); k++)
+      streams[j][k] = gr_complex(uniform(), uniform());
+    in[j] = &streams[j][0];
+  }
+
+  std::vector< std::vector<gr_complex> > outs(M, std::vector<gr_complex>(nout));
+  std::vector<gr_complex*> out(M);
+  std::vector<int> map(M);
+  for(unsigned int j = 0; j < M; j++) {
+    out[j] = &outs[j][0];
+    map[j] = j;
+  }
+
+  int consumed = chan.filter(&out[0], &map[0], M, &in[0], nout);
+
+  std::vector< std::vector<float> > arms =
+    gri_pfb_partition_taps(taps, M);
+  std::vector<gr_complex> bins(M);
+  int toconsume = (int)rintf(nout / ((float)M / R));
+  CPPUNIT_ASSERT_EQUAL(toconsume, consumed);
+
+  int n = 1, i = -1, j, last, oo = 0;
+  while(n <= toconsume) {
+    j = 0;
+    i = (i + R) % M;
+    last = i;
+    while(i >= 0) {
+      bins[M - ((j + R) % M) - 1] = arm_filter(arms[i], &in[j][n]);
+      j++;
+      i--;
+    }
+
+    i = M-1;
+    while(i > last) {
+      bins[M - ((j + R) % M) - 1] = arm_filter(arms[i], &in[j][n-1]);
+      j++;
+      i--;
+    }
+
+    n += (i + R) >= (int)M;
+
+    for(unsigned int k = 0; k < M; k++) {
+      gr_complex expected = 0;
+      for(unsigned int m = 0; m < M; m++)
+	expected += bins[m] * gr_expj(2*M_PI*k*m/M);
+      CPPUNIT_ASSERT_COMPLEXES_EQUAL(expected, outs[k][oo], 1e-3);
+    }
+    oo++;
+  }
+  CPPUNIT_ASSERT_EQUAL(nout, oo);
+}
+
+void
+qa_gri_pfb_channelizer_ccf::t1()
+{
+  // critically sampled; long enough to use the batched FFTs
+  test_channelizer(4, 4, 100);
+  test_channelizer(16, 16, 100);
+  test_channelizer(5, 5, 3);
+}
+
+void
+qa_gri_pfb_channelizer_ccf::t2()
+{
+  // oversampled outputs
+  test_channelizer(6, 3, 50);
+  test_channelizer(6, 5, 50);
+  test_channelizer(8, 1, 20);
+}
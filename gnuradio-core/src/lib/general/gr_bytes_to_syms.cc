@@ -27,6 +27,7 @@
 #include <gr_bytes_to_syms.h>
 #include <gr_io_signature.h>
 #include <assert.h>
+#include <volk/volk.h>
 
 static const int BITS_PER_BYTE = 8;
 
@@ -54,17 +55,17 @@ gr_bytes_to_syms::work (int noutput_items,
 
   assert (noutput_items % BITS_PER_BYTE == 0);
 
-  for (int i = 0; i < noutput_items / BITS_PER_BYTE; i++){
-    int x = in[i];
+  // unpack a chunk of bytes into bits, then make them +/-1
+  static const int CHUNK = 256;
+  unsigned char bits[CHUNK * BITS_PER_BYTE];
+  for (int i = 0; i < noutput_items / BITS_PER_BYTE; i += CHUNK){
+    int n = noutput_items / BITS_PER_BYTE - i;
+    if (n > CHUNK)
+      n = CHUNK;
 
-    *out++ = (((x >> 7) & 0x1) << 1) - 1;
-    *out++ = (((x >> 6) & 0x1) << 1) - 1;
-    *out++ = (((x >> 5) & 0x1) << 1) - 1;
-    *out++ = (((x >> 4) & 0x1) << 1) - 1;
-    *out++ = (((x >> 3) & 0x1) << 1) - 1;
-    *out++ = (((x >> 2) & 0x1) << 1) - 1;
-    *out++ = (((x >> 1) & 0x1) << 1) - 1;
-    *out++ = (((x >> 0) & 0x1) << 1) - 1;
+    volk_8u_unpack_k_bits_8u_u(bits, &in[i], BITS_PER_BYTE, n);
+    for (int j = 0; j < n * BITS_PER_BYTE; j++)
+      *out++ = (bits[j] << 1) - 1;
   }
 
   return noutput_items;
@@ -270,11 +270,7 @@ gr_complex_to_arg::work (int noutput_items,
   float *out = (float *) output_items[0];
   int noi = noutput_items * d_vlen;
 
-  // The fast_atan2f is faster than Volk
-  for (int i = 0; i < noi; i++){
-    //    out[i] = std::arg (in[i]);
-    out[i] = gr_fast_atan2f(in[i]);
-  }
+  volk_32fc_s32f_atan2_32f_u(out, in, 1.0, noi);
 
   return noutput_items;
 }
@@ -41,6 +41,7 @@ gr_copy::gr_copy(size_t itemsize)
     d_itemsize(itemsize),
     d_enabled(true)
 {
+  set_output_aliases_input(true);
 }
 
 bool
@@ -62,7 +63,8 @@ gr_copy::general_work(int noutput_items,
   int j = 0;
 
   if (d_enabled) {
-    memcpy(out, in, n*d_itemsize);
+    if (out != in)
+      memmove(out, in, n*d_itemsize);
     j = n;
   }
 
@@ -27,9 +27,9 @@
 #include <gr_correlate_access_code_tag_bb.h>
 #include <gr_io_signature.h>
 #include <stdexcept>
-#include <gr_count_bits.h>
 #include <cstdio>
 #include <iostream>
+#include <string.h>
 
 #define VERBOSE 0
 
@@ -46,7 +46,6 @@ gr_correlate_access_code_tag_bb::gr_correlate_access_code_tag_bb (
   : gr_sync_block ("correlate_access_code_tag_bb",
 		   gr_make_io_signature (1, 1, sizeof(char)),
 		   gr_make_io_signature (1, 1, sizeof(char))),
-    d_data_reg(0), d_mask(0),
     d_threshold(threshold), d_len(0)
 
 {
@@ -73,16 +72,14 @@ gr_correlate_access_code_tag_bb::set_access_code(
   if (d_len > 64)
     return false;
 
-  // set len top bits to 1.
-  d_mask = ((~0ULL) >> (64 - d_len)) << (64 - d_len);
-
-  d_access_code = 0;
+  unsigned long long code = 0;
   for (unsigned i=0; i < 64; i++){
-    d_access_code <<= 1;
+    code <<= 1;
     if (i < d_len)
-      d_access_code |= access_code[i] & 1;	// look at LSB only
+      code |= access_code[i] & 1;	// look at LSB only
   }
 
+  d_correlator.set_access_code(code, d_len, d_threshold);
   return true;
 }
 
@@ -96,32 +93,20 @@ gr_correlate_access_code_tag_bb::work (int noutput_items,
 
   uint64_t abs_out_sample_cnt = nitems_written(0);
 
-  for (int i = 0; i < noutput_items; i++){
-
-    out[i] = in[i];
-
-    // compute hamming distance between desired access code and current data
-    unsigned long long wrong_bits = 0;
-    unsigned int nwrong = d_threshold+1;
-    int new_flag = 0;
-
-    wrong_bits  = (d_data_reg ^ d_access_code) & d_mask;
-    nwrong = gr_count_bits64(wrong_bits);
+  memcpy(out, in, noutput_items);
 
-    // test for access code with up to threshold errors
-    new_flag = (nwrong <= d_threshold);
+  // positions where the access code ended just before in[i]
+  d_correlator.search(in, noutput_items, d_hits);
 
-    // shift in new data and new flag
-    d_data_reg = (d_data_reg << 1) | (in[i] & 0x1);
-    if (new_flag) {
-      if(VERBOSE) std::cout << "writing tag at sample " << abs_out_sample_cnt + i << std::endl;
-      add_item_tag(0, //stream ID
-	    abs_out_sample_cnt + i - 64 + d_len, //sample
-	    d_key,      //frame info
-	    pmt::pmt_t(), //data (unused)
-        d_me        //block src id
-      );
-    }
+  for (size_t h = 0; h < d_hits.size(); h++) {
+    int i = d_hits[h];
+    if(VERBOSE) std::cout << "writing tag at sample " << abs_out_sample_cnt + i << std::endl;
+    add_item_tag(0, //stream ID
+	  abs_out_sample_cnt + i - 64 + d_len, //sample
+	  d_key,      //frame info
+	  pmt::pmt_t(), //data (unused)
+	  d_me        //block src id
+    );
   }
 
   return noutput_items;
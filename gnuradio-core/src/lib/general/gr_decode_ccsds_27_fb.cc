@@ -24,6 +24,7 @@
 
 #include <gr_decode_ccsds_27_fb.h>
 #include <gr_io_signature.h>
+#include <algorithm>
 
 gr_decode_ccsds_27_fb_sptr
 gr_make_decode_ccsds_27_fb()
@@ -42,11 +43,12 @@ gr_decode_ccsds_27_fb::gr_decode_ccsds_27_fb()
     float esn0 = RATE*pow(10.0, ebn0/10.0);
 
     gen_met(d_mettab, 100, esn0, 0.0, 256);
-    viterbi_chunks_init(d_state0);
+    d_viterbi = new gri_viterbi_27(d_mettab);
 }
 
 gr_decode_ccsds_27_fb::~gr_decode_ccsds_27_fb()
 {
+  delete d_viterbi;
 }
 
 int
@@ -57,29 +59,26 @@ gr_decode_ccsds_27_fb::work(int noutput_items,
   const float *in = (const float *)input_items[0];
   unsigned char *out = (unsigned char *)output_items[0];
 
-  for (int i = 0; i < noutput_items*16; i++) {
-    // Translate and clip [-1.0..1.0] to [28..228]
-    float sample = in[i]*100.0+128.0;
-    if (sample > 255.0)
-	sample = 255.0;
-    else if (sample < 0.0)
-	sample = 0.0;
-    unsigned char sym = (unsigned char)(floor(sample));
+  // Decode a chunk of output bytes at a time
+  const int CHUNK = 256;
+  unsigned char syms[CHUNK*16];
 
-    d_viterbi_in[d_count % 4] = sym;
-    if ((d_count % 4) == 3) {
-      // Every fourth symbol, perform butterfly operation
-      viterbi_butterfly2(d_viterbi_in, d_mettab, d_state0, d_state1);
+  for (int n = 0; n < noutput_items; n += CHUNK) {
+    int nbytes = std::min(CHUNK, noutput_items - n);
 
-      // Every sixteenth symbol, read out a byte
-      if (d_count % 16 == 11) {
-	// long metric =
-	viterbi_get_output(d_state0, out++);
-	// printf("%li\n", *(out-1), metric);
-      }
+    for (int i = 0; i < nbytes*16; i++) {
+      // Translate and clip [-1.0..1.0] to [28..228]
+      float sample = in[i]*100.0+128.0;
+      if (sample > 255.0)
+	sample = 255.0;
+      else if (sample < 0.0)
+	sample = 0.0;
+      syms[i] = (unsigned char)(floor(sample));
     }
 
-    d_count++;
+    // One byte out every 16 symbols
+    out += d_viterbi->decode(syms, nbytes*8, out);
+    in += nbytes*16;
   }
 
   return noutput_items;
@@ -22,6 +22,7 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_decimator.h>
+#include <gri_viterbi_27.h>
 
 extern "C" {
 #include <viterbi.h>
@@ -61,11 +62,7 @@ private:
 
   // Viterbi state
   int d_mettab[2][256];
-  struct viterbi_state d_state0[64];
-  struct viterbi_state d_state1[64];
-  unsigned char d_viterbi_in[16];
-
-  int d_count;
+  gri_viterbi_27 *d_viterbi;
 
 public:
   ~gr_decode_ccsds_27_fb();
@@ -26,7 +26,7 @@
 
 #include <gr_deinterleave.h>
 #include <gr_io_signature.h>
-#include <string.h>
+#include <gri_interleave.h>
 
 
 gr_deinterleave_sptr
@@ -62,17 +62,9 @@ gr_deinterleave::work (int noutput_items,
 		       gr_vector_void_star &output_items)
 {
   size_t nchan = output_items.size ();
-  size_t itemsize = d_itemsize;
-  const char *in = (const char *) input_items[0];
-  char **out = (char **) &output_items[0];
 
-  for (int i = 0; i < noutput_items; i++){
-    for (unsigned int n = 0; n < nchan; n++){
-      memcpy (out[n], in, itemsize);
-      out[n] += itemsize;
-      in += itemsize;
-    }
-  }
+  gri_deinterleave (&output_items[0], input_items[0],
+		    nchan, d_itemsize, noutput_items);
 
   return noutput_items;
 }
@@ -26,6 +26,7 @@
 
 #include <gr_diff_decoder_bb.h>
 #include <gr_io_signature.h>
+#include <volk/volk.h>
 
 gr_diff_decoder_bb_sptr
 gr_make_diff_decoder_bb (unsigned int modulus)
@@ -51,11 +52,7 @@ gr_diff_decoder_bb::work (int noutput_items,
   unsigned char *out = (unsigned char *) output_items[0];
   in += 1;	// ensure that in[-1] is valid
 
-  unsigned modulus = d_modulus;
-
-  for (int i = 0; i < noutput_items; i++){
-    out[i] = (in[i] - in[i-1]) % modulus;
-  }
+  volk_8u_x2_diff_decode_8u_u(out, in, in - 1, d_modulus, noutput_items);
 
   return noutput_items;
 }
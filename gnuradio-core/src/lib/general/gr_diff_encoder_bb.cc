@@ -26,6 +26,7 @@
 
 #include <gr_diff_encoder_bb.h>
 #include <gr_io_signature.h>
+#include <volk/volk.h>
 
 gr_diff_encoder_bb_sptr
 gr_make_diff_encoder_bb (unsigned int modulus)
@@ -49,13 +50,9 @@ gr_diff_encoder_bb::work (int noutput_items,
   const unsigned char *in = (const unsigned char *) input_items[0];
   unsigned char *out = (unsigned char *) output_items[0];
 
-  unsigned last_out = d_last_out;
-  unsigned modulus = d_modulus;
-
-  for (int i = 0; i < noutput_items; i++){
-    out[i] = (in[i] + last_out) % modulus;
-    last_out = out[i];
-  }
+  // every output but the initial 0 has been through an unsigned char
+  unsigned char last_out = d_last_out;
+  volk_8u_diff_encode_8u_u(out, in, &last_out, d_modulus, noutput_items);
 
   d_last_out = last_out;
   return noutput_items;
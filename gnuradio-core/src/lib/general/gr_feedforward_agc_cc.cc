@@ -27,6 +27,7 @@
 #include <gr_feedforward_agc_cc.h>
 #include <gr_io_signature.h>
 #include <stdexcept>
+#include <algorithm>
 
 gr_feedforward_agc_cc_sptr
 gr_make_feedforward_agc_cc(int nsamples, float reference)
@@ -77,13 +78,32 @@ gr_feedforward_agc_cc::work(int noutput_items,
   const gr_complex *in = (const gr_complex *) input_items[0];
   gr_complex *out = (gr_complex *) output_items[0];
   int	nsamples = d_nsamples;
+  int	ninput = noutput_items + nsamples - 1;
   float gain;
 
+  if ((int) d_env.size() < ninput){
+    d_env.resize(ninput);
+    d_head.resize(ninput);
+    d_tail.resize(ninput);
+  }
+
+  for (int j = 0; j < ninput; j++)
+    d_env[j] = envelope(in[j]);
+
+  // Split the envelopes into runs of nsamples.  Every window of
+  // nsamples covers the tail of one run and the head of the next, so
+  // its max is max(d_tail[i], d_head[i+nsamples-1]): O(1) per output
+  // instead of O(nsamples).
+  for (int j = 0; j < ninput; j++)
+    d_head[j] = (j % nsamples == 0) ? d_env[j] : std::max(d_head[j-1], d_env[j]);
+  for (int j = ninput - 1; j >= 0; j--)
+    d_tail[j] = (j == ninput - 1 || j % nsamples == nsamples - 1)
+      ? d_env[j] : std::max(d_tail[j+1], d_env[j]);
+
   for (int i = 0; i < noutput_items; i++){
     //float max_env = 1e-12;	// avoid divide by zero
     float max_env = 1e-4;	// avoid divide by zero, indirectly set max gain
-    for (int j = 0; j < nsamples; j++)
-      max_env = std::max(max_env, envelope(in[i+j]));
+    max_env = std::max(max_env, std::max(d_tail[i], d_head[i+nsamples-1]));
     gain = d_reference / max_env;
     out[i] = gain * in[i];
   }
@@ -25,6 +25,7 @@
 
 #include <gr_core_api.h>
 #include <gr_sync_block.h>
+#include <vector>
 
 class gr_feedforward_agc_cc;
 typedef boost::shared_ptr<gr_feedforward_agc_cc> gr_feedforward_agc_cc_sptr;
@@ -43,6 +44,9 @@ class GR_CORE_API gr_feedforward_agc_cc : public gr_sync_block
 
   int		d_nsamples;
   float		d_reference;
+  std::vector<float> d_env;	// envelope of each input sample
+  std::vector<float> d_head;	// running max from the start of each run of nsamples
+  std::vector<float> d_tail;	// running max to the end of each run of nsamples
 
   gr_feedforward_agc_cc(int nsamples, float reference);
 
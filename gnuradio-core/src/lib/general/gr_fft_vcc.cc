@@ -46,7 +46,8 @@ gr_fft_vcc::gr_fft_vcc (const std::string &name,
   : gr_sync_block (name,
 		   gr_make_io_signature (1, 1, fft_size * sizeof (gr_complex)),
 		   gr_make_io_signature (1, 1, fft_size * sizeof (gr_complex))),
-    d_fft_size(fft_size), d_forward(forward), d_shift(shift)
+    d_fft_size(fft_size), d_forward(forward), d_shift(shift),
+    d_shift_in_window(false)
 {
   set_window(window);
 }
@@ -60,6 +61,16 @@ gr_fft_vcc::set_window(const std::vector<float> &window)
 {
   if(window.size()==0 || window.size()==d_fft_size) {
     d_window=window;
+
+    // For even sizes, shifting the forward transform's output by half
+    // its length is the same as multiplying the input by (-1)^n, which
+    // costs nothing extra once we're applying a window anyway.
+    d_shift_in_window = (d_forward && d_shift && d_window.size()
+			 && (d_fft_size % 2) == 0);
+    if(d_shift_in_window) {
+      for(unsigned int i = 1; i < d_fft_size; i += 2)
+	d_window[i] = -d_window[i];
+    }
     return true;
   }
   else
@@ -52,6 +52,7 @@ protected:
   std::vector<float>   d_window;
   bool d_forward;
   bool d_shift;
+  bool d_shift_in_window;	// forward fftshift folded into d_window
 
   gr_fft_vcc (const std::string &name, int fft_size, bool forward,
 	      const std::vector<float> &window, bool shift);
@@ -27,8 +27,13 @@
 #include <gr_fft_vcc_fftw.h>
 #include <gr_io_signature.h>
 #include <gri_fft.h>
+#include <volk/volk.h>
 #include <math.h>
 #include <string.h>
+#include <algorithm>
+
+// Number of samples transformed by each batched execute.
+static const int BATCH_SAMPLES = 4096;
 
 gr_fft_vcc_sptr
 gr_make_fft_vcc_fftw (int fft_size, bool forward,
@@ -46,17 +51,21 @@ gr_fft_vcc_fftw::gr_fft_vcc_fftw (int fft_size, bool forward,
   : gr_fft_vcc("fft_vcc_fftw", fft_size, forward, window, shift)
 {
   d_fft = new gri_fft_complex (d_fft_size, forward, nthreads);
+  d_fft_many = new gri_fft_complex (d_fft_size, forward, nthreads,
+				    std::max (1, BATCH_SAMPLES / fft_size));
 }
 
 gr_fft_vcc_fftw::~gr_fft_vcc_fftw ()
 {
   delete d_fft;
+  delete d_fft_many;
 }
 
 void
 gr_fft_vcc_fftw::set_nthreads(int n)
 {
   d_fft->set_nthreads(n);
+  d_fft_many->set_nthreads(n);
 }
 
 int
@@ -65,66 +74,90 @@ gr_fft_vcc_fftw::nthreads() const
   return d_fft->nthreads();
 }
 
-int
-gr_fft_vcc_fftw::work (int noutput_items,
-		  gr_vector_const_void_star &input_items,
-		  gr_vector_void_star &output_items)
+void
+gr_fft_vcc_fftw::transform (gri_fft_complex *fft, const gr_complex *in, gr_complex *out)
 {
-  const gr_complex *in = (const gr_complex *) input_items[0];
-  gr_complex *out = (gr_complex *) output_items[0];
-
-  unsigned int input_data_size = input_signature()->sizeof_stream_item (0);
-  unsigned int output_data_size = output_signature()->sizeof_stream_item (0);
-
-  int count = 0;
-
-  while (count++ < noutput_items){
-
-    // copy input into optimally aligned buffer
-
-    if (d_window.size()){
-      gr_complex *dst = d_fft->get_inbuf();
-      if(!d_forward && d_shift){
-        unsigned int offset = (!d_forward && d_shift)?(d_fft_size/2):0;
-        int fft_m_offset = d_fft_size - offset;
-        for (unsigned int i = 0; i < offset; i++)		// apply window
-            dst[i+fft_m_offset] = in[i] * d_window[i];
-        for (unsigned int i = offset; i < d_fft_size; i++)		// apply window
-            dst[i-offset] = in[i] * d_window[i];
-      } else {
-        for (unsigned int i = 0; i < d_fft_size; i++)		// apply window
-          dst[i] = in[i] * d_window[i];
+  int nvecs = fft->howmany ();
+  bool ifft_shift = !d_forward && d_shift;
+  bool fft_shift = d_forward && d_shift && !d_shift_in_window;
+
+  // Run straight off the scheduler's buffers when nothing has to be
+  // done to the data on the way in or out and the alignment allows.
+  const gr_complex *src = in;
+  if (d_window.size() || ifft_shift || !gri_fft_is_aligned (in)){
+    gr_complex *dst = fft->get_inbuf();
+    src = dst;
+
+    for (int v = 0; v < nvecs; v++){
+      if (ifft_shift){  // apply an ifft shift on the data
+	unsigned int len = d_fft_size / 2; // half length of complex array
+	if (d_window.size()){
+	  volk_32fc_32f_multiply_32fc_u (&dst[d_fft_size - len], &in[0], &d_window[0], len);
+	  volk_32fc_32f_multiply_32fc_u (&dst[0], &in[len], &d_window[len], d_fft_size - len);
+	}
+	else {
+	  memcpy(&dst[0], &in[len], sizeof(gr_complex)*(d_fft_size - len));
+	  memcpy(&dst[d_fft_size - len], &in[0], sizeof(gr_complex)*len);
+	}
       }
-    }
-    else {
-      if(!d_forward && d_shift) {  // apply an ifft shift on the data
-	gr_complex *dst = d_fft->get_inbuf();
-	unsigned int len = (unsigned int)(floor(d_fft_size/2.0)); // half length of complex array
-	memcpy(&dst[0], &in[len], sizeof(gr_complex)*(d_fft_size - len));
-	memcpy(&dst[d_fft_size - len], &in[0], sizeof(gr_complex)*len);
+      else if (d_window.size()){
+	volk_32fc_32f_multiply_32fc_u (dst, in, &d_window[0], d_fft_size);
       }
       else {
-	memcpy (d_fft->get_inbuf(), in, input_data_size);
+	memcpy (dst, in, sizeof(gr_complex)*d_fft_size);
       }
+
+      in  += d_fft_size;
+      dst += d_fft_size;
     }
+  }
+
+  if (!fft_shift && gri_fft_is_aligned (out)){
+    fft->execute (src, out);
+    return;
+  }
 
-    // compute the fft
-    d_fft->execute ();
+  // compute the fft
+  fft->execute (src, fft->get_outbuf ());
 
-    // copy result to our output
-    if(d_forward && d_shift) {  // apply a fft shift on the data
+  // copy result to our output
+  const gr_complex *res = fft->get_outbuf ();
+  for (int v = 0; v < nvecs; v++){
+    if (fft_shift){  // apply a fft shift on the data
       unsigned int len = (unsigned int)(ceil(d_fft_size/2.0));
-      memcpy(&out[0], &d_fft->get_outbuf()[len], sizeof(gr_complex)*(d_fft_size - len));
-      memcpy(&out[d_fft_size - len], &d_fft->get_outbuf()[0], sizeof(gr_complex)*len);
+      memcpy(&out[0], &res[len], sizeof(gr_complex)*(d_fft_size - len));
+      memcpy(&out[d_fft_size - len], &res[0], sizeof(gr_complex)*len);
     }
     else {
-      memcpy (out, d_fft->get_outbuf (), output_data_size);
+      memcpy (out, res, sizeof(gr_complex)*d_fft_size);
     }
 
-    in  += d_fft_size;
+    res += d_fft_size;
     out += d_fft_size;
   }
+}
+
+int
+gr_fft_vcc_fftw::work (int noutput_items,
+		  gr_vector_const_void_star &input_items,
+		  gr_vector_void_star &output_items)
+{
+  const gr_complex *in = (const gr_complex *) input_items[0];
+  gr_complex *out = (gr_complex *) output_items[0];
+
+  int count = 0;
+
+  while (count < noutput_items){
+    gri_fft_complex *fft = d_fft;
+    if (noutput_items - count >= d_fft_many->howmany ())
+      fft = d_fft_many;
+
+    transform (fft, in, out);
+
+    in  += d_fft_size * fft->howmany ();
+    out += d_fft_size * fft->howmany ();
+    count += fft->howmany ();
+  }
 
   return noutput_items;
 }
-
@@ -46,7 +46,10 @@ class GR_CORE_API gr_fft_vcc_fftw : public gr_fft_vcc
 			const std::vector<float> &window,
 			bool shift, int nthreads);
 
-  gri_fft_complex *d_fft;
+  gri_fft_complex *d_fft;		// one vector per execute
+  gri_fft_complex *d_fft_many;		// d_fft_many->howmany() vectors per execute
+
+  void transform (gri_fft_complex *fft, const gr_complex *in, gr_complex *out);
 
   gr_fft_vcc_fftw (int fft_size, bool forward,
 		   const std::vector<float> &window,
@@ -27,16 +27,19 @@
 #include <gr_fft_vfc.h>
 #include <gr_io_signature.h>
 #include <gri_fft.h>
+#include <volk/volk.h>
 #include <math.h>
 #include <stdexcept>
 #include <string.h>
 #include <cstdio>
+#include <algorithm>
 
 
 // FIXME after this is working, change to use native real to complex fft.
 // It should run twice as fast.
 
-
+// Number of samples transformed by each batched execute.
+static const int BATCH_SAMPLES = 4096;
 
 
 gr_fft_vfc_sptr
@@ -62,6 +65,13 @@ gr_fft_vfc::gr_fft_vfc (int fft_size, bool forward,
   }
 
   d_fft = new gri_fft_complex (d_fft_size, forward, nthreads);
+  d_fft_many = new gri_fft_complex (d_fft_size, forward, nthreads,
+				    std::max (1, BATCH_SAMPLES / fft_size));
+
+  int nmax = d_fft_many->howmany () * d_fft_size;
+  d_real = gri_fft_malloc_float (nmax);
+  d_zeros = gri_fft_malloc_float (nmax);
+  memset (d_zeros, 0, nmax * sizeof (float));
 
   set_window(window);
 }
@@ -69,12 +79,16 @@ gr_fft_vfc::gr_fft_vfc (int fft_size, bool forward,
 gr_fft_vfc::~gr_fft_vfc ()
 {
   delete d_fft;
+  delete d_fft_many;
+  gri_fft_free (d_real);
+  gri_fft_free (d_zeros);
 }
 
 void
 gr_fft_vfc::set_nthreads(int n)
 {
   d_fft->set_nthreads(n);
+  d_fft_many->set_nthreads(n);
 }
 
 int
@@ -91,33 +105,39 @@ gr_fft_vfc::work (int noutput_items,
   const float *in = (const float *) input_items[0];
   gr_complex *out = (gr_complex *) output_items[0];
 
-  unsigned int output_data_size = output_signature()->sizeof_stream_item (0);
-
   int count = 0;
 
-  while (count++ < noutput_items){
+  while (count < noutput_items){
+    gri_fft_complex *fft = d_fft;
+    if (noutput_items - count >= d_fft_many->howmany ())
+      fft = d_fft_many;
+    int nvecs = fft->howmany ();
 
-    // copy input into optimally aligned buffer
+    // window into an aligned buffer, then convert to complex
 
+    unsigned int nsamples = nvecs * d_fft_size;
     if (d_window.size()){
-      gr_complex *dst = d_fft->get_inbuf();
-      for (unsigned int i = 0; i < d_fft_size; i++)		// apply window
-	dst[i] = in[i] * d_window[i];
-    }
-    else {
-      gr_complex *dst = d_fft->get_inbuf();
-      for (unsigned int i = 0; i < d_fft_size; i++)		// float to complex conversion
-	dst[i] = in[i];
+      for (int v = 0; v < nvecs; v++)
+	volk_32f_x2_multiply_32f_u (&d_real[v * d_fft_size], &in[v * d_fft_size],
+				    &d_window[0], d_fft_size);
     }
+    else
+      memcpy (d_real, in, nsamples * sizeof (float));
+    in += nsamples;
+
+    volk_32f_x2_interleave_32fc_a (fft->get_inbuf (), d_real, d_zeros, nsamples);
 
-    // compute the fft
-    d_fft->execute ();
+    // compute the fft, straight into our output when it's aligned
 
-    // cpoy result to our output
-    memcpy (out, d_fft->get_outbuf (), output_data_size);
+    if (gri_fft_is_aligned (out))
+      fft->execute (fft->get_inbuf (), out);
+    else {
+      fft->execute ();
+      memcpy (out, fft->get_outbuf (), nvecs * d_fft_size * sizeof (gr_complex));
+    }
 
-    in  += d_fft_size;
-    out += d_fft_size;
+    out += nvecs * d_fft_size;
+    count += nvecs;
   }
 
   return noutput_items;
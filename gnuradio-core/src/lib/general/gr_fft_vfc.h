@@ -50,7 +50,10 @@ class GR_CORE_API gr_fft_vfc : public gr_sync_block
 
   unsigned int  d_fft_size;
   std::vector<float> d_window;
-  gri_fft_complex *d_fft;
+  gri_fft_complex *d_fft;		// one vector per execute
+  gri_fft_complex *d_fft_many;		// d_fft_many->howmany() vectors per execute
+  float *d_real;			// windowed input of one execute
+  float *d_zeros;			// imaginary part of the fft input
 
   gr_fft_vfc (int fft_size, bool forward,
 	      const std::vector<float>  &window,
@@ -29,6 +29,7 @@
 #include <gr_io_signature.h>
 #include <math.h>
 #include <gr_math.h>
+#include <algorithm>
 
 #define M_TWOPI (2*M_PI)
 
@@ -75,31 +76,32 @@ gr_fmdet_cf::work (int noutput_items,
   float *optr = (float *) output_items[0];
   //  const gr_complex *scaleiptr = (gr_complex *) input_items[0];
 
-  int	size = noutput_items;
-
-  gr_complex Sdot,S0,S1=d_S1,S2=d_S2,S3=d_S3,S4=d_S4;
-  float d_8 = 8.0;
-
-  while (size-- > 0) {
-    S0=*iptr++;
-
-
-    Sdot = d_scl * (-S0+d_8*S1-d_8*S1+S4);
-
-    d_freq = (S2.real()*Sdot.imag()-S2.imag()*Sdot.real())/
-      (S2.real()*S2.real()+S2.imag()*S2.imag());
-
-    S4=S3;
-    S3=S2;
-    S2=S1;
-    S1=S0;
-
-
-    *optr++ = d_freq-d_bias;
+  // Sdot depends only on S0 and S4, and the output on Sdot and S2,
+  // so once four samples of this call are in hand every output can
+  // be computed independently and the loop vectorizes.  The first
+  // four outputs take their history from the previous call.
+  gr_complex hist[8] = { d_S4, d_S3, d_S2, d_S1 };
+  int nhead = std::min (noutput_items, 4);
+  for (int i = 0; i < nhead; i++)
+    hist[4+i] = iptr[i];
+
+  for (int i = 0; i < nhead; i++)
+    optr[i] = demod (hist[4+i], hist[2+i], hist[i]);
+
+  for (int i = 4; i < noutput_items; i++)
+    optr[i] = demod (iptr[i], iptr[i-2], iptr[i-4]);
+
+  if (noutput_items >= 4){
+    d_S1 = iptr[noutput_items-1];
+    d_S2 = iptr[noutput_items-2];
+    d_S3 = iptr[noutput_items-3];
+    d_S4 = iptr[noutput_items-4];
+  }
+  else {
+    d_S1 = hist[4+nhead-1];
+    d_S2 = hist[4+nhead-2];
+    d_S3 = hist[4+nhead-3];
+    d_S4 = hist[4+nhead-4];
   }
-  d_S1=S1;
-  d_S2=S2;
-  d_S3=S3;
-  d_S4=S4;
   return noutput_items;
 }
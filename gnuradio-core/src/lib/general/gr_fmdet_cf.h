@@ -50,10 +50,19 @@ class GR_CORE_API gr_fmdet_cf : public gr_sync_block
 					    float freq_high, float scl);
 
   gr_complex d_S1,d_S2,d_S3,d_S4;
-  float d_freq,d_freqlo,d_freqhi,d_scl,d_bias;
+  float d_freqlo,d_freqhi,d_scl,d_bias;
   gr_fir_ccf* d_filter;
   gr_fmdet_cf (float samplerate, float freq_low, float freq_high, float scl);
 
+  // slope detector output for sample s0, given the samples two and
+  // four steps back
+  float demod (const gr_complex &s0, const gr_complex &s2, const gr_complex &s4) const
+  {
+    gr_complex sdot = d_scl * (s4 - s0);
+    return (s2.real()*sdot.imag() - s2.imag()*sdot.real()) /
+      (s2.real()*s2.real() + s2.imag()*s2.imag()) - d_bias;
+  }
+
   int work (int noutput_items,
 	    gr_vector_const_void_star &input_items,
 	    gr_vector_void_star &output_items);
@@ -66,15 +66,22 @@ gr_glfsr_source_b::work(int noutput_items,
   if ((d_index > d_length) && d_repeat == false)
     return -1; /* once through the sequence */
 
-  int i;
-  for (i = 0; i < noutput_items; i++) {
-    out[i] = d_glfsr->next_bit();
+  // Stop short of the bit that takes d_index past d_length.
+  int n = noutput_items;
+  bool last = false;
+  if (d_repeat == false && (unsigned int) n > d_length - d_index) {
+    n = d_length - d_index;
+    last = true;
+  }
+
+  d_glfsr->next_bits((unsigned char *) out, n);
+  d_index += n;
+  if (last) {
+    d_glfsr->next_bit();
     d_index++;
-    if (d_index > d_length && d_repeat == false)
-      break;
   }
 
-  return i;
+  return n;
 }
 
 int
@@ -29,6 +29,7 @@
 #include <gri_glfsr.h>
 #include <gr_io_signature.h>
 #include <stdexcept>
+#include <algorithm>
 
 gr_glfsr_source_f_sptr
 gr_make_glfsr_source_f(int degree, bool repeat, int mask, int seed)
@@ -66,15 +67,28 @@ gr_glfsr_source_f::work(int noutput_items,
   if ((d_index > d_length) && d_repeat == false)
     return -1; /* once through the sequence */
 
-  int i;
-  for (i = 0; i < noutput_items; i++) {
-    out[i] = (float)d_glfsr->next_bit()*2.0-1.0;
+  // Stop short of the bit that takes d_index past d_length.
+  int n = noutput_items;
+  bool last = false;
+  if (d_repeat == false && (unsigned int) n > d_length - d_index) {
+    n = d_length - d_index;
+    last = true;
+  }
+
+  unsigned char bits[256];
+  for (int i = 0; i < n; i += sizeof(bits)) {
+    int m = std::min(n - i, (int) sizeof(bits));
+    d_glfsr->next_bits(bits, m);
+    for (int j = 0; j < m; j++)
+      out[i + j] = (float)bits[j]*2.0-1.0;
+  }
+  d_index += n;
+  if (last) {
+    d_glfsr->next_bit();
     d_index++;
-    if (d_index > d_length && d_repeat == false)
-      break;
   }
 
-  return i;
+  return n;
 }
 
 int
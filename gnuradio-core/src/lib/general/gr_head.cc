@@ -33,6 +33,7 @@ gr_head::gr_head (size_t sizeof_stream_item, unsigned long long nitems)
 		   gr_make_io_signature (1, 1, sizeof_stream_item)),
     d_nitems (nitems), d_ncopied_items (0)
 {
+  set_output_aliases_input(true);
 }
 
 gr_head_sptr
@@ -54,7 +55,8 @@ gr_head::work (int noutput_items,
   if (n == 0)
     return 0;
 
-  memcpy (output_items[0], input_items[0], n * input_signature()->sizeof_stream_item (0));
+  if (output_items[0] != input_items[0])
+    memmove (output_items[0], input_items[0], n * input_signature()->sizeof_stream_item (0));
   d_ncopied_items += n;
 
   return n;
@@ -26,7 +26,7 @@
 
 #include <gr_interleave.h>
 #include <gr_io_signature.h>
-#include <string.h>
+#include <gri_interleave.h>
 
 
 gr_interleave_sptr
@@ -62,16 +62,8 @@ gr_interleave::work (int noutput_items,
 		     gr_vector_void_star &output_items)
 {
   size_t nchan = input_items.size ();
-  size_t itemsize = d_itemsize;
-  const char **in = (const char **) &input_items[0];
-  char *out = (char *) output_items[0];
 
-  for (int i = 0; i < noutput_items; i += nchan){
-    for (unsigned int n = 0; n < nchan; n++){
-      memcpy (out, in[n], itemsize);
-      out += itemsize;
-      in[n] += itemsize;
-    }
-  }
+  gri_interleave (output_items[0], &input_items[0],
+		  nchan, d_itemsize, noutput_items / nchan);
   return noutput_items;
 }
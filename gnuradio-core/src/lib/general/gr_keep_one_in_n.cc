@@ -45,6 +45,7 @@ gr_keep_one_in_n::gr_keep_one_in_n (size_t item_size, int n)
   // this to turn off automatic tag propagation, which will be handled
   // locally in general_work().
   set_tag_propagation_policy(TPP_DONT);
+  set_output_aliases_input(true);
 
   set_n(n);
 }
@@ -80,7 +81,8 @@ gr_keep_one_in_n::general_work (int noutput_items,
   while (ni < ninput_items[0] && no < noutput_items){
     d_count--;
     if (d_count <= 0){
-      memcpy (out, in, item_size);		// copy 1 item
+      if (out != in)
+	memmove (out, in, item_size);		// copy 1 item
       out += item_size;
       no++;
       d_count = d_n;
@@ -40,6 +40,7 @@ gr_kludge_copy::gr_kludge_copy(size_t itemsize)
 		   gr_make_io_signature (1, -1, itemsize)),
     d_itemsize(itemsize)
 {
+  set_output_aliases_input(true);
 }
 
 bool
@@ -58,7 +59,8 @@ gr_kludge_copy::work(int noutput_items,
 
   int ninputs = input_items.size();
   for (int i = 0; i < ninputs; i++){
-    memcpy(out[i], in[i], noutput_items * d_itemsize);
+    if (out[i] != in[i])
+      memmove(out[i], in[i], noutput_items * d_itemsize);
   }
   return noutput_items;
 }
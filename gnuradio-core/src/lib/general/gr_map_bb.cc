@@ -26,6 +26,7 @@
 
 #include <gr_map_bb.h>
 #include <gr_io_signature.h>
+#include <volk/volk.h>
 
 gr_map_bb_sptr
 gr_make_map_bb (const std::vector<int> &map)
@@ -54,8 +55,7 @@ gr_map_bb::work (int noutput_items,
   const unsigned char *in = (const unsigned char *) input_items[0];
   unsigned char *out = (unsigned char *) output_items[0];
 
-  for (int i = 0; i < noutput_items; i++)
-    out[i] = d_map[in[i]];
+  volk_8u_map_8u_u(out, in, d_map, noutput_items);
 
   return noutput_items;
 }
@@ -27,6 +27,8 @@
 #include <gr_sincos.h>
 #include <cmath>
 #include <gr_complex.h>
+#include <volk/volk.h>
+#include <algorithm>
 
 /*!
  * \brief base class template for Numerically Controlled Oscillator (NCO)
@@ -103,7 +105,9 @@ public:
   float cos () const { return std::cos (phase); }
   float sin () const { return std::sin (phase); }
 
-  // compute a block at a time
+  // compute a block at a time.  The float and complex versions
+  // advance a unit phasor with a SIMD rotator instead of evaluating
+  // sin and cos for every sample.
   void sin (float *output, int noutput_items, double ampl = 1.0);
   void cos (float *output, int noutput_items, double ampl = 1.0);
   void sincos (gr_complex *output, int noutput_items, double ampl = 1.0);
@@ -115,8 +119,16 @@ public:
 protected:
   double phase;
   double phase_inc;
+
+  // samples generated from one exact phase by the block methods
+  static const int BLOCK = 64;
+
+  void sincos_block (float *sinx, float *cosx, int noutput_items, double ampl);
 };
 
+template<class o_type, class i_type>
+const int gr_nco<o_type,i_type>::BLOCK;
+
 template<class o_type, class i_type>
 void
 gr_nco<o_type,i_type>::sincos (float *sinx, float *cosx) const
@@ -128,20 +140,14 @@ template<class o_type, class i_type>
 void
 gr_nco<o_type,i_type>::sin (float *output, int noutput_items, double ampl)
 {
-  for (int i = 0; i < noutput_items; i++){
-    output[i] = (float)(sin () * ampl);
-    step ();
-  }
+  sincos_block (output, 0, noutput_items, ampl);
 }
 
 template<class o_type, class i_type>
 void
 gr_nco<o_type,i_type>::cos (float *output, int noutput_items, double ampl)
 {
-  for (int i = 0; i < noutput_items; i++){
-    output[i] = (float)(cos () * ampl);
-    step ();
-  }
+  sincos_block (0, output, noutput_items, ampl);
 }
 
 template<class o_type, class i_type>
@@ -188,11 +194,37 @@ template<class o_type, class i_type>
 void
 gr_nco<o_type,i_type>::sincos (gr_complex *output, int noutput_items, double ampl)
 {
-  for (int i = 0; i < noutput_items; i++){
-    float cosx, sinx;
-    sincos (&sinx, &cosx);
-    output[i] = gr_complex(cosx * ampl, sinx * ampl);
-    step ();
+  // Run a phasor recursion, restarted from the exact phase every
+  // BLOCK samples so float rounding can't build up.
+  gr_complex incr = gr_complex (std::cos (phase_inc), std::sin (phase_inc));
+
+  for (int i = 0; i < noutput_items; i += BLOCK){
+    int n = std::min (BLOCK, noutput_items - i);
+    gr_complex start = gr_complex (std::cos (phase), std::sin (phase));
+
+    std::fill (output + i, output + i + n, gr_complex (ampl, 0));
+    volk_32fc_s32fc_x2_rotator_32fc_u (output + i, output + i, incr, &start, n);
+    step (n);
+  }
+}
+
+template<class o_type, class i_type>
+void
+gr_nco<o_type,i_type>::sincos_block (float *sinx, float *cosx, int noutput_items,
+				     double ampl)
+{
+  gr_complex buf[BLOCK];
+
+  for (int i = 0; i < noutput_items; i += BLOCK){
+    int n = std::min (BLOCK, noutput_items - i);
+    sincos (buf, n, ampl);
+    if (sinx)
+      for (int j = 0; j < n; j++)
+	sinx[i + j] = buf[j].imag ();
+    if (cosx)
+      for (int j = 0; j < n; j++)
+	cosx[i + j] = buf[j].real ();
   }
 }
+
 #endif /* _NCO_H_ */
@@ -32,7 +32,6 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <stdexcept>
-#include <gr_count_bits.h>
 #include <string.h>
 
 #define VERBOSE 0
@@ -46,7 +45,7 @@ gr_packet_sink::enter_search()
     fprintf(stderr, "@ enter_search\n");
 
   d_state = STATE_SYNC_SEARCH;
-  d_shift_reg = 0;
+  d_correlator.reset();
 }
 
 inline void
@@ -93,6 +92,7 @@ gr_packet_sink::gr_packet_sink (const std::vector<unsigned char>& sync_vector,
     d_sync_vector <<= 8;
     d_sync_vector |= sync_vector[i];
   }
+  d_correlator.set_access_code(d_sync_vector, 64, d_threshold);
 
   enter_search();
 }
@@ -120,13 +120,16 @@ gr_packet_sink::work (int noutput_items,
 	fprintf(stderr,"SYNC Search, noutput=%d\n",noutput_items),fflush(stderr);
 
       while (count < noutput_items) {
-	if(slice(inbuf[count++]))
-	  d_shift_reg = (d_shift_reg << 1) | 1;
-	else
-	  d_shift_reg = d_shift_reg << 1;
-
-	// Compute popcnt of putative sync vector
-	if(gr_count_bits64 (d_shift_reg ^ d_sync_vector) <= d_threshold) {
+	unsigned char bits[SLICE_CHUNK];
+	int n = noutput_items - count;
+	if (n > SLICE_CHUNK)
+	  n = SLICE_CHUNK;
+	for (int i = 0; i < n; i++)
+	  bits[i] = slice(inbuf[count + i]);
+
+	// Shift bits in until the sync vector is within threshold
+	count += d_correlator.shift_until_match(bits, n);
+	if (d_correlator.matches()) {
 	  // Found it, set up for header decode
 	  enter_have_sync();
 	  break;
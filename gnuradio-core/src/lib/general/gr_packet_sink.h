@@ -26,6 +26,7 @@
 #include <gr_core_api.h>
 #include <gr_sync_block.h>
 #include <gr_msg_queue.h>
+#include <gri_access_code_correlator.h>
 
 class gr_packet_sink;
 typedef boost::shared_ptr<gr_packet_sink> gr_packet_sink_sptr;
@@ -51,6 +52,7 @@ class GR_CORE_API gr_packet_sink : public gr_sync_block
 
   static const int MAX_PKT_LEN    = 4096;
   static const int HEADERBITLEN   = 32;
+  static const int SLICE_CHUNK    = 256;	// bits sliced at a time during sync search
 
   gr_msg_queue_sptr  d_target_queue;		// where to send the packet when received
   unsigned long long d_sync_vector;		// access code to locate start of packet
@@ -58,7 +60,7 @@ class GR_CORE_API gr_packet_sink : public gr_sync_block
 
   state_t            d_state;
 
-  unsigned long long d_shift_reg;		// used to look for sync_vector
+  gri_access_code_correlator d_correlator;	// used to look for sync_vector
 
   unsigned int       d_header;			// header bits
   int		     d_headerbitlen_cnt;	// how many so far
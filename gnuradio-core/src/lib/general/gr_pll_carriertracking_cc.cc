@@ -26,7 +26,7 @@
 
 #include <gr_pll_carriertracking_cc.h>
 #include <gr_io_signature.h>
-#include <gr_sincos.h>
+#include <gr_fxpt.h>
 #include <math.h>
 #include <gr_math.h>
 
@@ -101,7 +101,7 @@ gr_pll_carriertracking_cc::work (int noutput_items,
   float t_imag, t_real;
 
   for (int i = 0; i < noutput_items; i++){
-    gr_sincosf(d_phase, &t_imag, &t_real);
+    gr_fxpt::sincos(gr_fxpt::float_to_fixed(d_phase), &t_imag, &t_real);
     optr[i] = iptr[i] * gr_complex(t_real, -t_imag);
 
     error = phase_detector(iptr[i],d_phase);
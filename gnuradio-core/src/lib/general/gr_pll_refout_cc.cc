@@ -26,7 +26,7 @@
 
 #include <gr_pll_refout_cc.h>
 #include <gr_io_signature.h>
-#include <gr_sincos.h>
+#include <gr_fxpt.h>
 #include <math.h>
 #include <gr_math.h>
 
@@ -80,7 +80,7 @@ gr_pll_refout_cc::work (int noutput_items,
   int	size = noutput_items;
 
   while (size-- > 0) {
-    gr_sincosf(d_phase,&t_imag,&t_real);
+    gr_fxpt::sincos(gr_fxpt::float_to_fixed(d_phase),&t_imag,&t_real);
     *optr++ = gr_complex(t_real,t_imag);
 
     error = phase_detector(*iptr++,d_phase);
@@ -33,6 +33,7 @@ gr_skiphead::gr_skiphead (size_t itemsize, uint64_t nitems_to_skip)
 	      gr_make_io_signature(1, 1, itemsize)),
     d_nitems_to_skip(nitems_to_skip), d_nitems(0)
 {
+  set_output_aliases_input(true);
 }
 
 gr_skiphead_sptr
@@ -68,7 +69,8 @@ gr_skiphead::general_work(int noutput_items,
       int n_to_copy = ninput_items - ii;
       if (n_to_copy > 0){
 	size_t itemsize = output_signature()->sizeof_stream_item(0);
-	memcpy(out, in + (ii*itemsize), n_to_copy*itemsize);
+	if (out != in + (ii*itemsize))
+	  memmove(out, in + (ii*itemsize), n_to_copy*itemsize);
       }
 
       d_nitems += ninput_items;
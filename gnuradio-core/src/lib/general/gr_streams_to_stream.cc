@@ -26,7 +26,7 @@
 
 #include <gr_streams_to_stream.h>
 #include <gr_io_signature.h>
-#include <string.h>
+#include <gri_interleave.h>
 
 gr_streams_to_stream_sptr
 gr_make_streams_to_stream (size_t item_size, size_t nstreams)
@@ -49,20 +49,13 @@ gr_streams_to_stream::work (int noutput_items,
 {
   size_t item_size = output_signature()->sizeof_stream_item (0);
 
-  const char **inv = (const char **) &input_items[0];
-  char *out = (char *) output_items[0];
   int nstreams = input_items.size();
 
   assert (noutput_items % nstreams == 0);
   int ni = noutput_items / nstreams;
 
-  for (int i = 0; i < ni; i++){
-    for (int j = 0; j < nstreams; j++){
-      memcpy(out, inv[j], item_size);
-      out += item_size;
-      inv[j] += item_size;
-    }
-  }
+  gri_interleave (output_items[0], &input_items[0],
+		  nstreams, item_size, ni);
 
   return noutput_items;
 }
@@ -26,7 +26,7 @@
 
 #include <gr_streams_to_vector.h>
 #include <gr_io_signature.h>
-#include <string.h>
+#include <gri_interleave.h>
 
 gr_streams_to_vector_sptr
 gr_make_streams_to_vector (size_t item_size, size_t nstreams)
@@ -49,16 +49,8 @@ gr_streams_to_vector::work (int noutput_items,
   size_t item_size = input_signature()->sizeof_stream_item(0);
   int nstreams = input_items.size();
 
-  const char **inv = (const char **) &input_items[0];
-  char *out = (char *) output_items[0];
-
-  for (int i = 0; i < noutput_items; i++){
-    for (int j = 0; j < nstreams; j++){
-      memcpy(out, inv[j], item_size);
-      inv[j] += item_size;
-      out += item_size;
-    }
-  }
+  gri_interleave (output_items[0], &input_items[0],
+		  nstreams, item_size, noutput_items);
 
   return noutput_items;
 }
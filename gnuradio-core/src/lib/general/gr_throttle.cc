@@ -26,7 +26,11 @@
 
 #include <gr_throttle.h>
 #include <gr_io_signature.h>
+#include <gruel/high_res_timer.h>
+#include <gruel/pmt.h>
 #include <cstring>
+#include <sstream>
+#include <algorithm>
 #include <boost/thread/thread.hpp>
 
 class gr_throttle_impl : public gr_throttle{
@@ -35,17 +39,42 @@ public:
         gr_sync_block("throttle",
             gr_make_io_signature(1, 1, itemsize),
             gr_make_io_signature(1, 1, itemsize)),
-        d_itemsize(itemsize)
+        d_itemsize(itemsize),
+        d_max_burst(0),
+        d_spin_ticks(0),
+        d_tag_time(false)
     {
-        /* NOP */
+        d_time_key = pmt::pmt_string_to_symbol("rx_time");
+
+        std::stringstream str;
+        str << name() << unique_id();
+        d_id = pmt::pmt_string_to_symbol(str.str());
     }
 
     void set_sample_rate(double rate){
         //changing the sample rate performs a reset of state params
-        d_start = boost::get_system_time();
+        d_start = gruel::high_res_timer_now();
         d_total_samples = 0;
-        d_samps_per_tick = rate/boost::posix_time::time_duration::ticks_per_second();
-        d_samps_per_us = rate/1e6;
+        d_rate = rate;
+        d_samps_per_tick = rate/gruel::high_res_timer_tps();
+        d_tag_now = true;
+    }
+
+    double sample_rate() const{
+        return d_rate;
+    }
+
+    void set_max_burst(size_t items){
+        d_max_burst = items;
+    }
+
+    void set_spin_time(double secs){
+        d_spin_ticks = gruel::high_res_timer_type(secs*gruel::high_res_timer_tps());
+    }
+
+    void set_tag_time(bool tag){
+        d_tag_time = tag;
+        d_tag_now = true;
     }
 
     int work (
@@ -54,16 +83,34 @@ public:
         gr_vector_void_star &output_items
     ){
         //calculate the expected number of samples to have passed through
-        boost::system_time now = boost::get_system_time();
-        boost::int64_t ticks = (now - d_start).ticks();
-        uint64_t expected_samps = uint64_t(d_samps_per_tick*ticks);
+        gruel::high_res_timer_type now = gruel::high_res_timer_now();
+        double expected_samps = (now - d_start)*d_samps_per_tick;
+
+        //by default we may run one call's worth of samples ahead
+        double ahead = noutput_items;
+        if (d_max_burst){
+            noutput_items = std::min(noutput_items, int(d_max_burst));
+            ahead = d_max_burst;
+
+            //token bucket: credit earned while starved can't exceed
+            //one burst, so let the schedule slip by whole samples
+            if (expected_samps >= d_total_samples + 1){
+                uint64_t slip = uint64_t(expected_samps - d_total_samples);
+                d_start += gruel::high_res_timer_type(slip/d_samps_per_tick);
+                expected_samps -= slip;
+                d_tag_now = true;
+            }
+        }
 
         //if the expected samples was less, we need to throttle back
-        if (d_total_samples > expected_samps){
-            boost::this_thread::sleep(boost::posix_time::microseconds(
-                long((d_total_samples - expected_samps)/d_samps_per_us)
-            ));
+        double target = d_total_samples + noutput_items - ahead;
+        if (target > expected_samps)
+            wait_until(d_start + gruel::high_res_timer_type(target/d_samps_per_tick));
+
+        if (d_tag_time && d_tag_now){
+            add_item_tag(0, nitems_written(0), d_time_key, time_of(d_total_samples), d_id);
         }
+        d_tag_now = false;
 
         //copy all samples output[i] <= input[i]
         const char *in = (const char *) input_items[0];
@@ -74,10 +121,43 @@ public:
     }
 
 private:
-    boost::system_time d_start;
+    //sleep until shortly before the deadline, then spin
+    void wait_until(gruel::high_res_timer_type deadline){
+        const gruel::high_res_timer_type tps = gruel::high_res_timer_tps();
+        gruel::high_res_timer_type left = deadline - gruel::high_res_timer_now();
+        if (left > d_spin_ticks){
+            boost::this_thread::sleep(boost::posix_time::microseconds(
+                long((left - d_spin_ticks)*1e6/tps)
+            ));
+        }
+        if (d_spin_ticks){
+            while (gruel::high_res_timer_now() < deadline){
+                /* spin */
+            }
+        }
+    }
+
+    //wall clock time sample n is due, as (full secs, frac secs)
+    pmt::pmt_t time_of(uint64_t n){
+        const gruel::high_res_timer_type tps = gruel::high_res_timer_tps();
+        gruel::high_res_timer_type t = d_start - gruel::high_res_timer_epoch();
+        uint64_t full_secs = t/tps;
+        double frac_secs = double(t%tps)/tps + n/d_rate;
+        uint64_t carry = uint64_t(frac_secs);
+        return pmt::pmt_make_tuple(
+            pmt::pmt_from_uint64(full_secs + carry),
+            pmt::pmt_from_double(frac_secs - carry)
+        );
+    }
+
+    gruel::high_res_timer_type d_start;
     size_t d_itemsize;
     uint64_t d_total_samples;
-    double d_samps_per_tick, d_samps_per_us;
+    double d_rate, d_samps_per_tick;
+    size_t d_max_burst;
+    gruel::high_res_timer_type d_spin_ticks;
+    bool d_tag_time, d_tag_now;
+    pmt::pmt_t d_time_key, d_id;
 };
 
 gr_throttle::sptr
@@ -35,6 +35,20 @@
  * rate limiting block.  It is not intended nor effective at precisely
  * controlling the rate of samples.  That should be controlled by a
  * source or sink tied to sample clock.  E.g., a USRP or audio card.
+ *
+ * Pacing uses gruel::high_res_timer.  By default each call to work
+ * may run one call's worth of items ahead of schedule, and after a
+ * stall the block catches up as fast as it can.  set_max_burst
+ * bounds both: no more than that many items leave ahead of schedule
+ * or in one go, and time spent starved is not made up for later.
+ * For sub-millisecond accuracy, set_spin_time makes the block sleep
+ * until shortly before each deadline and busy-wait the rest.
+ *
+ * When tagging is enabled, the output carries rx_time tags like a
+ * USRP source: a pmt tuple of (uint64 seconds, double fractional
+ * seconds) giving the wall clock time the tagged item was due.  A
+ * tag is produced on the first item, after a rate change, and
+ * whenever the burst limit makes the schedule slip.
  */
 class GR_CORE_API gr_throttle : virtual public gr_sync_block
 {
@@ -43,6 +57,24 @@ public:
 
     //! Sets the sample rate in samples per second
     virtual void set_sample_rate(double rate) = 0;
+
+    //! Get the sample rate in samples per second
+    virtual double sample_rate() const = 0;
+
+    /*!
+     * \brief Limit how far ahead of schedule the output may run.
+     * \param items maximum items per burst, or 0 for no limit
+     */
+    virtual void set_max_burst(size_t items) = 0;
+
+    /*!
+     * \brief Busy-wait the last \p secs seconds before each deadline
+     * instead of sleeping.  0 never spins.
+     */
+    virtual void set_spin_time(double secs) = 0;
+
+    //! Turn rx_time tags on the output on or off
+    virtual void set_tag_time(bool tag) = 0;
 };
 
 GR_CORE_API gr_throttle::sptr gr_make_throttle(size_t itemsize, double samples_per_sec);
@@ -28,6 +28,7 @@
 #include <gr_io_signature.h>
 #include <stdexcept>
 #include <iostream>
+#include <volk/volk.h>
 
 gr_unpack_k_bits_bb_sptr gr_make_unpack_k_bits_bb (unsigned k)
 {
@@ -58,13 +59,8 @@ gr_unpack_k_bits_bb::work (int noutput_items,
   const unsigned char *in = (const unsigned char *) input_items[0];
   unsigned char *out = (unsigned char *) output_items[0];
 
-  int n = 0;
-  for (unsigned int i = 0; i < noutput_items/d_k; i++){
-    unsigned int t = in[i];
-    for (int j = d_k - 1; j >= 0; j--)
-      out[n++] = (t >> j) & 0x01;
-  }
+  assert(noutput_items % d_k == 0);
+  volk_8u_unpack_k_bits_8u_u(out, in, d_k, noutput_items/d_k);
 
-  assert(n == noutput_items);
   return noutput_items;
 }
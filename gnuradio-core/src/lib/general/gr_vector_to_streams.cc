@@ -26,7 +26,7 @@
 
 #include <gr_vector_to_streams.h>
 #include <gr_io_signature.h>
-#include <string.h>
+#include <gri_interleave.h>
 
 gr_vector_to_streams_sptr
 gr_make_vector_to_streams (size_t item_size, size_t nstreams)
@@ -49,16 +49,8 @@ gr_vector_to_streams::work (int noutput_items,
   size_t item_size = output_signature()->sizeof_stream_item(0);
   int nstreams = output_items.size();
 
-  const char *in = (const char *) input_items[0];
-  char **outv = (char **) &output_items[0];
-
-  for (int i = 0; i < noutput_items; i++){
-    for (int j = 0; j < nstreams; j++){
-      memcpy(outv[j], in, item_size);
-      outv[j] += item_size;
-      in += item_size;
-    }
-  }
+  gri_deinterleave (&output_items[0], input_items[0],
+		    nstreams, item_size, noutput_items);
 
   return noutput_items;
 }
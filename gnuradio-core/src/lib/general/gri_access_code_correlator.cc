@@ -0,0 +1,247 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_access_code_correlator.h>
+#include <gr_count_bits.h>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CORRELATOR_AVX2 1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define CORRELATOR_AVX2 0
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if CORRELATOR_AVX2
+// AVX2, and the OS saving the YMM registers, checked once at load time
+static bool
+have_avx2 ()
+{
+  unsigned int eax, ebx, ecx, edx, xcr0;
+  if (!__get_cpuid (1, &eax, &ebx, &ecx, &edx))
+    return false;
+  if (!(ecx & bit_OSXSAVE) || __get_cpuid_max (0, 0) < 7)
+    return false;
+  __asm__ ("xgetbv" : "=a" (xcr0), "=d" (edx) : "c" (0));
+  if ((xcr0 & 6) != 6)
+    return false;
+  __cpuid_count (7, 0, eax, ebx, ecx, edx);
+  return (ebx & bit_AVX2) != 0;
+}
+
+static const bool s_have_avx2 = have_avx2 ();
+#endif
+
+static inline uint64_t
+bit_reverse (uint64_t x)
+{
+  x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+  x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+  x = ((x >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((x & 0x0f0f0f0f0f0f0f0fULL) << 4);
+  x = ((x >> 8) & 0x00ff00ff00ff00ffULL) | ((x & 0x00ff00ff00ff00ffULL) << 8);
+  x = ((x >> 16) & 0x0000ffff0000ffffULL) | ((x & 0x0000ffff0000ffffULL) << 16);
+  return (x >> 32) | (x << 32);
+}
+
+static inline int
+lowest_bit (uint64_t x)		// x != 0
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll (x);
+#else
+  int n = 0;
+  while (!(x & 1)){
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+// Bit b of the result is the LSB of in[b], for b < nbits.
+static inline uint64_t
+pack_bits (const unsigned char *in, int nbits)
+{
+  uint64_t word = 0;
+  int b = 0;
+
+#if defined(__SSE2__)
+  // move each byte's LSB to its MSB and gather those 16 at a time
+  for (; b + 16 <= nbits; b += 16){
+    __m128i v = _mm_loadu_si128 ((const __m128i *) &in[b]);
+    word |= (uint64_t) (unsigned int) _mm_movemask_epi8 (_mm_slli_epi16 (v, 7)) << b;
+  }
+#endif
+  for (; b < nbits; b++)
+    word |= (uint64_t) (in[b] & 1) << b;
+
+  return word;
+}
+
+gri_access_code_correlator::gri_access_code_correlator ()
+  : d_reg (0), d_code (0), d_mask (0), d_threshold (0)
+{
+}
+
+void
+gri_access_code_correlator::set_access_code (uint64_t code, unsigned int len,
+					     unsigned int threshold)
+{
+  d_code = bit_reverse (code);
+  d_mask = len >= 64 ? ~0ULL : (1ULL << len) - 1;
+  d_threshold = threshold;
+}
+
+uint64_t
+gri_access_code_correlator::data_reg () const
+{
+  return bit_reverse (d_reg);
+}
+
+unsigned int
+gri_access_code_correlator::wrong_bits (uint64_t reg) const
+{
+#if defined(__GNUC__)
+  return __builtin_popcountll ((reg ^ d_code) & d_mask);
+#else
+  return gr_count_bits64 ((reg ^ d_code) & d_mask);
+#endif
+}
+
+/*
+ * Bit k of the result is set if the register matched just before bit
+ * k of \p word went in, for k < nbits.  At that point the register
+ * holds the old register shifted down by k with the first k bits of
+ * word on top.
+ */
+uint64_t
+gri_access_code_correlator::word_matches (uint64_t word, int nbits) const
+{
+#if CORRELATOR_AVX2
+  if (s_have_avx2)
+    return word_matches_avx2 (word, nbits);
+#endif
+
+  uint64_t result = 0;
+  if (nbits > 0 && wrong_bits (d_reg) <= d_threshold)
+    result = 1;
+  for (int k = 1; k < nbits; k++)
+    if (wrong_bits ((d_reg >> k) | (word << (64 - k))) <= d_threshold)
+      result |= 1ULL << k;
+
+  return result;
+}
+
+#if CORRELATOR_AVX2
+// word_matches, four positions at a time
+__attribute__((target("avx2")))
+uint64_t
+gri_access_code_correlator::word_matches_avx2 (uint64_t word, int nbits) const
+{
+  uint64_t result = 0;
+
+  const __m256i reg = _mm256_set1_epi64x (d_reg);
+  const __m256i w = _mm256_set1_epi64x (word);
+  const __m256i code = _mm256_set1_epi64x (d_code);
+  const __m256i mask = _mm256_set1_epi64x (d_mask);
+  const __m256i limit = _mm256_set1_epi64x (d_threshold + 1);
+  const __m256i nibble = _mm256_set1_epi8 (0x0f);
+  const __m256i popcount4 = _mm256_setr_epi8 (0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+					      0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  __m256i k = _mm256_setr_epi64x (0, 1, 2, 3);
+
+  for (int base = 0; base < nbits; base += 4){
+    // shifts of 64 give 0, which is what k = 0 needs
+    __m256i window = _mm256_or_si256 (_mm256_srlv_epi64 (reg, k),
+				      _mm256_sllv_epi64 (w, _mm256_sub_epi64 (_mm256_set1_epi64x (64), k)));
+    __m256i x = _mm256_and_si256 (_mm256_xor_si256 (window, code), mask);
+    __m256i counts = _mm256_add_epi8 (_mm256_shuffle_epi8 (popcount4, _mm256_and_si256 (x, nibble)),
+				      _mm256_shuffle_epi8 (popcount4, _mm256_and_si256 (_mm256_srli_epi16 (x, 4), nibble)));
+    __m256i nwrong = _mm256_sad_epu8 (counts, _mm256_setzero_si256 ());
+    __m256i hit = _mm256_cmpgt_epi64 (limit, nwrong);
+    result |= (uint64_t) _mm256_movemask_pd (_mm256_castsi256_pd (hit)) << base;
+    k = _mm256_add_epi64 (k, _mm256_set1_epi64x (4));
+  }
+  if (nbits < 64)
+    result &= (1ULL << nbits) - 1;
+
+  return result;
+}
+#endif
+
+void
+gri_access_code_correlator::shift (uint64_t word, int nbits)
+{
+  if (nbits >= 64)
+    d_reg = word;
+  else if (nbits > 0)
+    d_reg = (d_reg >> nbits) | (word << (64 - nbits));
+}
+
+void
+gri_access_code_correlator::search (const unsigned char *in, int n,
+				    std::vector<int> &hits)
+{
+  hits.clear ();
+
+  for (int i = 0; i < n; i += 64){
+    int nbits = std::min (64, n - i);
+    uint64_t word = pack_bits (&in[i], nbits);
+
+    for (uint64_t m = word_matches (word, nbits); m != 0; m &= m - 1)
+      hits.push_back (i + lowest_bit (m));
+
+    shift (word, nbits);
+  }
+}
+
+int
+gri_access_code_correlator::shift_until_match (const unsigned char *in, int n)
+{
+  for (int i = 0; i < n; i += 64){
+    int nbits = std::min (64, n - i);
+    uint64_t word = pack_bits (&in[i], nbits);
+
+    // a match right after bit k went in is a match just before bit k+1
+    uint64_t m = word_matches (word, nbits) >> 1;
+    if (m != 0){
+      int k = lowest_bit (m);
+      shift (word, k + 1);
+      return i + k + 1;
+    }
+
+    shift (word, nbits);
+    if (matches ())
+      return i + nbits;
+  }
+
+  return n;
+}
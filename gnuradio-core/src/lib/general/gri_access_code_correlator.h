@@ -0,0 +1,98 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GRI_ACCESS_CODE_CORRELATOR_H
+#define INCLUDED_GRI_ACCESS_CODE_CORRELATOR_H
+
+#include <gr_core_api.h>
+#include <stdint.h>
+#include <vector>
+
+/*!
+ * \brief Search a stream of bits for an access code, 64 bits at a time.
+ * \ingroup misc
+ *
+ * Does what gr_correlate_access_code_tag_bb and friends do one bit at
+ * a time: shift each bit into a 64 bit data register and compare the
+ * top \p len bits of the register with the access code, allowing up
+ * to \p threshold wrong bits.  Here the input is packed into words of
+ * 64 bits and all 64 positions of a word are compared at once, four
+ * at a time with AVX2 where the CPU has it.  The positions found are
+ * exactly the same.
+ */
+class GR_CORE_API gri_access_code_correlator
+{
+public:
+  gri_access_code_correlator ();
+
+  /*!
+   * \param code      access code, left justified: its first bit is bit 63
+   * \param len       number of bits in the access code, 1 to 64
+   * \param threshold maximum number of bits that may be wrong
+   */
+  void set_access_code (uint64_t code, unsigned int len, unsigned int threshold);
+
+  //! Clear the data register.
+  void reset () { d_reg = 0; }
+
+  /*!
+   * \brief The data register, the newest bit in bit 0, as the blocks
+   * keep it.
+   */
+  uint64_t data_reg () const;
+
+  //! True if the data register now matches the access code.
+  bool matches () const { return wrong_bits (d_reg) <= d_threshold; }
+
+  /*!
+   * \brief Shift the \p n bits in the LSBs of \p in through the data
+   * register.
+   *
+   * Sets \p hits to the positions i, in increasing order, at which the
+   * register matched just before in[i] was shifted in.
+   */
+  void search (const unsigned char *in, int n, std::vector<int> &hits);
+
+  /*!
+   * \brief Shift bits from \p in until the register matches right
+   * after a bit went in.
+   *
+   * \returns the number of bits shifted in.  matches() then tells
+   * whether the last of them completed the access code.
+   */
+  int shift_until_match (const unsigned char *in, int n);
+
+private:
+  // Both the register and the code are kept bit reversed: the newest
+  // bit is in bit 63, so packed input words shift in from the top.
+  uint64_t	d_reg;
+  uint64_t	d_code;
+  uint64_t	d_mask;
+  unsigned int	d_threshold;
+
+  unsigned int wrong_bits (uint64_t reg) const;
+  uint64_t word_matches (uint64_t word, int nbits) const;
+  uint64_t word_matches_avx2 (uint64_t word, int nbits) const;
+  void shift (uint64_t word, int nbits);
+};
+
+#endif /* INCLUDED_GRI_ACCESS_CODE_CORRELATOR_H */
@@ -24,7 +24,9 @@
 #define _GRI_AGC2_FF_H_
 
 #include <gr_core_api.h>
+#include <gri_agc_block.h>
 #include <math.h>
+#include <stdexcept>
 
 /*!
  * \brief high performance Automatic Gain Control class with attack and decay rate
@@ -38,13 +40,14 @@ class GR_CORE_API gri_agc2_ff {
   gri_agc2_ff (float attack_rate = 1e-1, float decay_rate = 1e-2, float reference = 1.0,
 	       float gain = 1.0, float max_gain = 0.0)
     : _attack_rate(attack_rate), _decay_rate(decay_rate), _reference(reference),
-      _gain(gain), _max_gain(max_gain) {};
+      _gain(gain), _max_gain(max_gain), _block_size(1) {};
 
   float attack_rate () const { return _attack_rate; }
   float decay_rate () const  { return _decay_rate; }
   float reference () const   { return _reference; }
   float gain () const 	     { return _gain;  }
   float max_gain () const    { return _max_gain; }
+  unsigned block_size () const { return _block_size; }
 
   void set_attack_rate (float rate) { _attack_rate = rate; }
   void set_decay_rate (float rate) { _decay_rate = rate; }
@@ -52,6 +55,20 @@ class GR_CORE_API gri_agc2_ff {
   void set_gain (float gain) { _gain = gain; }
   void set_max_gain (float max_gain) { _max_gain = max_gain; }
 
+  /*!
+   * \brief Update the gain once every \p block_size samples.
+   *
+   * The gain is computed from the mean envelope of each block with the
+   * same time constant as the per-sample loop, and ramped linearly
+   * across the block.  The default of 1 updates it every sample.
+   * 16 to 64 is a good range; at most GRI_AGC_MAX_BLOCK.
+   */
+  void set_block_size (unsigned block_size) {
+    if (block_size < 1 || block_size > GRI_AGC_MAX_BLOCK)
+      throw std::invalid_argument ("gri_agc2_ff: block_size must be in [1, GRI_AGC_MAX_BLOCK]");
+    _block_size = block_size;
+  }
+
   float scale (float input){
     float output = input * _gain;
 
@@ -75,6 +92,24 @@ class GR_CORE_API gri_agc2_ff {
   }
 
   void scaleN (float output[], const float input[], unsigned n){
+    if (_block_size > 1){
+      for (unsigned i = 0; i < n; i += _block_size){
+	unsigned m = n - i < _block_size ? n - i : _block_size;
+	float env = gri_agc_envelope (&input[i], m);
+	float tmp = _gain * env - _reference;
+	float rate = _decay_rate;
+	if (fabsf(tmp) > _gain)
+	  rate = _attack_rate;
+	float gain = gri_agc_block_gain (_gain, rate, _reference, env, m);
+	if (gain < 0.0)
+	  gain = 10e-5;
+	if (_max_gain > 0.0 && gain > _max_gain)
+	  gain = _max_gain;
+	gri_agc_ramp (&output[i], &input[i], _gain, gain, m);
+	_gain = gain;
+      }
+      return;
+    }
     for (unsigned i = 0; i < n; i++)
       output[i] = scale (input[i]);
   }
@@ -85,6 +120,7 @@ class GR_CORE_API gri_agc2_ff {
   float	_reference;		// reference value
   float	_gain;			// current gain
   float _max_gain;		// maximum gain
+  unsigned _block_size;		// samples per gain update
 };
 
 #endif /* _GRI_AGC2_FF_H_ */
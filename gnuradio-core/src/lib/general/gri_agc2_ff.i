@@ -39,9 +39,11 @@ class gri_agc2_ff {
   float reference ();
   float gain ();
   float max_gain ();
+  unsigned block_size ();
   void set_attack_rate (float rate);
   void set_decay_rate (float rate);
   void set_reference (float reference);
   void set_gain (float gain);
   void set_max_gain (float max_gain);
+  void set_block_size (unsigned block_size);
   };
@@ -0,0 +1,100 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_agc_block.h>
+#include <volk/volk.h>
+#include <math.h>
+#include <assert.h>
+
+float
+gri_agc_block_gain (float gain, float rate, float reference,
+		    float env, unsigned n)
+{
+  // gain converges geometrically on reference / env:
+  //   g[n] = g[0] * d^n + rate * reference * (1 + d + ... + d^(n-1))
+  // with d = 1 - rate * env.  Done in double so the sum doesn't lose
+  // the small rates these loops are run with.
+  double a = (double) rate * env;
+  double dn = pow (1.0 - a, (double) n);
+  double sum = fabs (a) > 1e-12 ? (1.0 - dn) / a : (double) n;
+
+  return (float) (gain * dn + (double) rate * reference * sum);
+}
+
+float
+gri_agc_envelope (const gr_complex *in, unsigned n)
+{
+  __VOLK_ATTR_ALIGNED(16) float mag[GRI_AGC_MAX_BLOCK];
+  float sum;
+
+  assert (n > 0 && n <= GRI_AGC_MAX_BLOCK);
+  volk_32fc_magnitude_32f_u (mag, in, n);
+  volk_32f_accumulator_s32f_a (&sum, mag, n);
+  return sum / n;
+}
+
+float
+gri_agc_envelope (const float *in, unsigned n)
+{
+  __VOLK_ATTR_ALIGNED(16) float mag[GRI_AGC_MAX_BLOCK];
+  float sum;
+
+  assert (n > 0 && n <= GRI_AGC_MAX_BLOCK);
+  for (unsigned i = 0; i < n; i++)
+    mag[i] = fabsf (in[i]);
+  volk_32f_accumulator_s32f_a (&sum, mag, n);
+  return sum / n;
+}
+
+static void
+make_ramp (float *gains, float gain0, float gain1, unsigned n)
+{
+  float step = (gain1 - gain0) / n;
+  for (unsigned i = 0; i < n; i++)
+    gains[i] = gain0 + step * i;
+}
+
+void
+gri_agc_ramp (gr_complex *out, const gr_complex *in,
+	      float gain0, float gain1, unsigned n)
+{
+  __VOLK_ATTR_ALIGNED(16) float gains[GRI_AGC_MAX_BLOCK];
+
+  assert (n <= GRI_AGC_MAX_BLOCK);
+  make_ramp (gains, gain0, gain1, n);
+  volk_32fc_32f_multiply_32fc_u (out, in, gains, n);
+}
+
+void
+gri_agc_ramp (float *out, const float *in,
+	      float gain0, float gain1, unsigned n)
+{
+  __VOLK_ATTR_ALIGNED(16) float gains[GRI_AGC_MAX_BLOCK];
+
+  assert (n <= GRI_AGC_MAX_BLOCK);
+  make_ramp (gains, gain0, gain1, n);
+  volk_32f_x2_multiply_32f_u (out, in, gains, n);
+}
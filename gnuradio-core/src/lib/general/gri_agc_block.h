@@ -0,0 +1,61 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifndef INCLUDED_GRI_AGC_BLOCK_H
+#define INCLUDED_GRI_AGC_BLOCK_H
+
+#include <gr_core_api.h>
+#include <gr_complex.h>
+
+/*
+ * Helpers for running the gri_agc* loops once per block of samples
+ * instead of once per sample.  Used by scaleN when set_block_size()
+ * is greater than one.
+ */
+
+//! Largest block size accepted by the gri_agc* set_block_size()
+static const unsigned GRI_AGC_MAX_BLOCK = 256;
+
+/*
+ * The gain after n steps of gain += rate * (reference - gain * env),
+ * the update all the agc loops make, with the input envelope held at
+ * env.  Used with the mean envelope of a block this keeps the time
+ * constant of the per-sample loop.
+ */
+GR_CORE_API float gri_agc_block_gain (float gain, float rate, float reference,
+				      float env, unsigned n);
+
+/*
+ * Mean magnitude of n <= GRI_AGC_MAX_BLOCK samples.
+ */
+GR_CORE_API float gri_agc_envelope (const gr_complex *in, unsigned n);
+GR_CORE_API float gri_agc_envelope (const float *in, unsigned n);
+
+/*
+ * out[i] = in[i] * (gain0 + (gain1 - gain0) * i / n) for
+ * n <= GRI_AGC_MAX_BLOCK samples.
+ */
+GR_CORE_API void gri_agc_ramp (gr_complex *out, const gr_complex *in,
+			       float gain0, float gain1, unsigned n);
+GR_CORE_API void gri_agc_ramp (float *out, const float *in,
+			       float gain0, float gain1, unsigned n);
+
+#endif /* INCLUDED_GRI_AGC_BLOCK_H */
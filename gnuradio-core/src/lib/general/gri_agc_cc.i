@@ -38,4 +38,6 @@ class gri_agc_cc {
   float reference ();
   float gain ();
   float max_gain ();
+  unsigned block_size ();
+  void set_block_size (unsigned block_size);
   };
@@ -1,6 +1,6 @@
 /* -*- c++ -*- */
 /*
- * Copyright 2003,2008,2011 Free Software Foundation, Inc.
+ * Copyright 2003,2008,2011,2012 Free Software Foundation, Inc.
  *
  * This file is part of GNU Radio
  *
@@ -42,6 +42,8 @@ static int my_fftw_read_char(void *f) { return fgetc((FILE *) f); }
 #include <stdio.h>
 #include <cassert>
 #include <stdexcept>
+#include <string>
+#include <map>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
@@ -65,6 +67,14 @@ gri_fft_free(void *b)
   fftwf_free(b);
 }
 
+bool
+gri_fft_is_aligned(const void *p)
+{
+  // Plans are made on fftwf_malloc'd buffers, which FFTW aligns for
+  // whatever SIMD it was built with.
+  return fftwf_alignment_of ((float *) p) == 0;
+}
+
 boost::mutex &
 gri_fft_planner::mutex()
 {
@@ -73,26 +83,57 @@ gri_fft_planner::mutex()
   return s_planning_mutex;
 }
 
-static const char *
+static std::string
 wisdom_filename ()
 {
-  static fs::path path;
-  path = fs::path(gr_appdata_path()) / ".gr_fftw_wisdom";
-  return path.string().c_str();
+  fs::path path = fs::path(gr_appdata_path()) / ".gr_fftw_wisdom";
+  return path.string();
 }
 
+static bool s_wisdom_dirty = false;	// plans made since wisdom was saved
+
+// Registered with atexit by gri_fftw_import_wisdom.
+static void
+gri_fftw_export_wisdom ()
+{
+  gri_fft_planner::scoped_lock	lock(gri_fft_planner::mutex());
+
+  if (!s_wisdom_dirty)
+    return;
+  s_wisdom_dirty = false;
+
+  std::string filename = wisdom_filename ();
+  FILE *fp = fopen (filename.c_str(), "w");
+  if (fp != 0){
+    fftwf_export_wisdom_to_file (fp);
+    fclose (fp);
+  }
+  else {
+    fprintf (stderr, "gri_fftw: ");
+    perror (filename.c_str());
+  }
+}
+
+// Caller must hold the planner mutex.
 static void
 gri_fftw_import_wisdom ()
 {
-  const char *filename = wisdom_filename ();
-  FILE *fp = fopen (filename, "r");
+  static bool wisdom_imported = false;
+
+  if (wisdom_imported)
+    return;
+  wisdom_imported = true;
+
+  std::string filename = wisdom_filename ();
+  FILE *fp = fopen (filename.c_str(), "r");
   if (fp != 0){
     int r = fftwf_import_wisdom_from_file (fp);
     fclose (fp);
     if (!r){
-      fprintf (stderr, "gri_fftw: can't import wisdom from %s\n", filename);
+      fprintf (stderr, "gri_fftw: can't import wisdom from %s\n", filename.c_str());
     }
   }
+  atexit (gri_fftw_export_wisdom);
 }
 
 static void
@@ -111,34 +152,140 @@ gri_fftw_config_threading (int nthreads)
 #endif
 }
 
-static void
-gri_fftw_export_wisdom ()
+// ----------------------------------------------------------------
+
+namespace {
+  struct plan_key {
+    int type;
+    int fft_size;
+    int nthreads;
+    int howmany;
+    int alignment;	// SIMD alignment of the buffers, and in-place flag
+
+    bool operator< (const plan_key &o) const
+    {
+      if (type != o.type) return type < o.type;
+      if (fft_size != o.fft_size) return fft_size < o.fft_size;
+      if (nthreads != o.nthreads) return nthreads < o.nthreads;
+      if (howmany != o.howmany) return howmany < o.howmany;
+      return alignment < o.alignment;
+    }
+  };
+
+  struct plan_entry {
+    fftwf_plan plan;
+    int        refcount;
+  };
+
+  typedef std::map<plan_key, plan_entry> plan_cache_t;
+}
+
+static plan_cache_t &
+plan_cache ()
 {
-  const char *filename = wisdom_filename ();
-  FILE *fp = fopen (filename, "w");
-  if (fp != 0){
-    fftwf_export_wisdom_to_file (fp);
-    fclose (fp);
+  static plan_cache_t s_plan_cache;
+
+  return s_plan_cache;
+}
+
+static fftwf_plan
+gri_fftw_make_plan (gri_fft_planner::plan_type type, int fft_size,
+		    int howmany, void *inbuf, void *outbuf)
+{
+  switch (type){
+  case gri_fft_planner::COMPLEX_FORWARD:
+  case gri_fft_planner::COMPLEX_REVERSE:
+    // howmany contiguous vectors, each fft_size long
+    return fftwf_plan_many_dft (1, &fft_size, howmany,
+				reinterpret_cast<fftwf_complex *>(inbuf),
+				NULL, 1, fft_size,
+				reinterpret_cast<fftwf_complex *>(outbuf),
+				NULL, 1, fft_size,
+				type == gri_fft_planner::COMPLEX_FORWARD ? FFTW_FORWARD : FFTW_BACKWARD,
+				FFTW_MEASURE);
+
+  case gri_fft_planner::REAL_FORWARD:
+    return fftwf_plan_dft_r2c_1d (fft_size,
+				  reinterpret_cast<float *>(inbuf),
+				  reinterpret_cast<fftwf_complex *>(outbuf),
+				  FFTW_MEASURE);
+
+  case gri_fft_planner::REAL_REVERSE:
+    return fftwf_plan_dft_c2r_1d (fft_size,
+				  reinterpret_cast<fftwf_complex *>(inbuf),
+				  reinterpret_cast<float *>(outbuf),
+				  FFTW_MEASURE);
   }
-  else {
-    fprintf (stderr, "gri_fftw: ");
-    perror (filename);
+  return NULL;
+}
+
+void *
+gri_fft_planner::acquire_plan (plan_type type, int fft_size, int nthreads,
+			       int howmany, void *inbuf, void *outbuf)
+{
+  scoped_lock	lock(mutex());
+
+  plan_key key;
+  key.type = type;
+  key.fft_size = fft_size;
+  key.nthreads = nthreads;
+  key.howmany = howmany;
+  key.alignment = (fftwf_alignment_of ((float *) inbuf)
+		   | (fftwf_alignment_of ((float *) outbuf) << 8)
+		   | ((inbuf == outbuf) << 16));
+
+  plan_cache_t::iterator it = plan_cache().find (key);
+  if (it != plan_cache().end ()){
+    it->second.refcount++;
+    return it->second.plan;
+  }
+
+  gri_fftw_config_threading (nthreads);
+  gri_fftw_import_wisdom ();	// load prior wisdom from disk, once
+
+  fftwf_plan plan = gri_fftw_make_plan (type, fft_size, howmany, inbuf, outbuf);
+  if (plan == NULL)
+    return 0;
+
+  plan_entry entry;
+  entry.plan = plan;
+  entry.refcount = 1;
+  plan_cache().insert (std::make_pair (key, entry));
+  s_wisdom_dirty = true;	// new wisdom is stored to disk at exit
+
+  return plan;
+}
+
+void
+gri_fft_planner::release_plan (void *plan)
+{
+  scoped_lock	lock(mutex());
+
+  for (plan_cache_t::iterator it = plan_cache().begin (); it != plan_cache().end (); ++it){
+    if (it->second.plan == (fftwf_plan) plan){
+      if (--it->second.refcount == 0){
+	fftwf_destroy_plan (it->second.plan);
+	plan_cache().erase (it);
+      }
+      return;
+    }
   }
 }
 
 // ----------------------------------------------------------------
 
-gri_fft_complex::gri_fft_complex (int fft_size, bool forward, int nthreads)
+gri_fft_complex::gri_fft_complex (int fft_size, bool forward, int nthreads, int howmany)
 {
-  // Hold global mutex during plan construction and destruction.
-  gri_fft_planner::scoped_lock	lock(gri_fft_planner::mutex());
-
   assert (sizeof (fftwf_complex) == sizeof (gr_complex));
 
   if (fft_size <= 0)
     throw std::out_of_range ("gri_fftw: invalid fft_size");
 
+  if (howmany <= 0)
+    throw std::out_of_range ("gri_fftw: invalid howmany");
+
   d_fft_size = fft_size;
+  d_howmany = howmany;
   d_inbuf = (gr_complex *) fftwf_malloc (sizeof (gr_complex) * inbuf_length ());
   if (d_inbuf == 0)
     throw std::runtime_error ("fftwf_malloc");
@@ -150,28 +297,22 @@ gri_fft_complex::gri_fft_complex (int fft_size, bool forward, int nthreads)
   }
 
   d_nthreads = nthreads;
-  gri_fftw_config_threading (nthreads);
-  gri_fftw_import_wisdom ();	// load prior wisdom from disk
-
-  d_plan = fftwf_plan_dft_1d (fft_size,
-			      reinterpret_cast<fftwf_complex *>(d_inbuf),
-			      reinterpret_cast<fftwf_complex *>(d_outbuf),
-			      forward ? FFTW_FORWARD : FFTW_BACKWARD,
-			      FFTW_MEASURE);
+  d_plan = gri_fft_planner::acquire_plan (forward ? gri_fft_planner::COMPLEX_FORWARD
+					  : gri_fft_planner::COMPLEX_REVERSE,
+					  fft_size, nthreads, howmany,
+					  d_inbuf, d_outbuf);
 
   if (d_plan == NULL) {
     fprintf(stderr, "gri_fft_complex: error creating plan\n");
+    fftwf_free (d_inbuf);
+    fftwf_free (d_outbuf);
     throw std::runtime_error ("fftwf_plan_dft_1d failed");
   }
-  gri_fftw_export_wisdom ();	// store new wisdom to disk
 }
 
 gri_fft_complex::~gri_fft_complex ()
 {
-  // Hold global mutex during plan construction and destruction.
-  gri_fft_planner::scoped_lock	lock(gri_fft_planner::mutex());
-
-  fftwf_destroy_plan ((fftwf_plan) d_plan);
+  gri_fft_planner::release_plan (d_plan);
   fftwf_free (d_inbuf);
   fftwf_free (d_outbuf);
 }
@@ -191,16 +332,26 @@ gri_fft_complex::set_nthreads(int n)
 void
 gri_fft_complex::execute ()
 {
-  fftwf_execute ((fftwf_plan) d_plan);
+  fftwf_execute_dft ((fftwf_plan) d_plan,
+		     reinterpret_cast<fftwf_complex *>(d_inbuf),
+		     reinterpret_cast<fftwf_complex *>(d_outbuf));
+}
+
+void
+gri_fft_complex::execute (const gr_complex *in, gr_complex *out)
+{
+  assert (gri_fft_is_aligned (in) && gri_fft_is_aligned (out));
+
+  // out of place complex transforms leave their input untouched
+  fftwf_execute_dft ((fftwf_plan) d_plan,
+		     reinterpret_cast<fftwf_complex *>(const_cast<gr_complex *>(in)),
+		     reinterpret_cast<fftwf_complex *>(out));
 }
 
 // ----------------------------------------------------------------
 
 gri_fft_real_fwd::gri_fft_real_fwd (int fft_size, int nthreads)
 {
-  // Hold global mutex during plan construction and destruction.
-  gri_fft_planner::scoped_lock	lock(gri_fft_planner::mutex());
-
   assert (sizeof (fftwf_complex) == sizeof (gr_complex));
 
   if (fft_size <= 0)
@@ -218,27 +369,21 @@ gri_fft_real_fwd::gri_fft_real_fwd (int fft_size, int nthreads)
   }
 
   d_nthreads = nthreads;
-  gri_fftw_config_threading (nthreads);
-  gri_fftw_import_wisdom ();	// load prior wisdom from disk
-
-  d_plan = fftwf_plan_dft_r2c_1d (fft_size,
-				  d_inbuf,
-				  reinterpret_cast<fftwf_complex *>(d_outbuf),
-				  FFTW_MEASURE);
+  d_plan = gri_fft_planner::acquire_plan (gri_fft_planner::REAL_FORWARD,
+					  fft_size, nthreads, 1,
+					  d_inbuf, d_outbuf);
 
   if (d_plan == NULL) {
     fprintf(stderr, "gri_fft_real_fwd: error creating plan\n");
+    fftwf_free (d_inbuf);
+    fftwf_free (d_outbuf);
     throw std::runtime_error ("fftwf_plan_dft_r2c_1d failed");
   }
-  gri_fftw_export_wisdom ();	// store new wisdom to disk
 }
 
 gri_fft_real_fwd::~gri_fft_real_fwd ()
 {
-  // Hold global mutex during plan construction and destruction.
-  gri_fft_planner::scoped_lock	lock(gri_fft_planner::mutex());
-
-  fftwf_destroy_plan ((fftwf_plan) d_plan);
+  gri_fft_planner::release_plan (d_plan);
   fftwf_free (d_inbuf);
   fftwf_free (d_outbuf);
 }
@@ -258,16 +403,14 @@ gri_fft_real_fwd::set_nthreads(int n)
 void
 gri_fft_real_fwd::execute ()
 {
-  fftwf_execute ((fftwf_plan) d_plan);
+  fftwf_execute_dft_r2c ((fftwf_plan) d_plan, d_inbuf,
+			 reinterpret_cast<fftwf_complex *>(d_outbuf));
 }
 
 // ----------------------------------------------------------------
 
 gri_fft_real_rev::gri_fft_real_rev (int fft_size, int nthreads)
 {
-  // Hold global mutex during plan construction and destruction.
-  gri_fft_planner::scoped_lock	lock(gri_fft_planner::mutex());
-
   assert (sizeof (fftwf_complex) == sizeof (gr_complex));
 
   if (fft_size <= 0)
@@ -285,27 +428,21 @@ gri_fft_real_rev::gri_fft_real_rev (int fft_size, int nthreads)
   }
 
   d_nthreads = nthreads;
-  gri_fftw_config_threading (nthreads);
-  gri_fftw_import_wisdom ();	// load prior wisdom from disk
-
-  // FIXME If there's ever a chance that the planning functions
-  // will be called in multiple threads, we've got to ensure single
-  // threaded access.  They are not thread-safe.
-  d_plan = fftwf_plan_dft_c2r_1d (fft_size,
-				  reinterpret_cast<fftwf_complex *>(d_inbuf),
-				  d_outbuf,
-				  FFTW_MEASURE);
+  d_plan = gri_fft_planner::acquire_plan (gri_fft_planner::REAL_REVERSE,
+					  fft_size, nthreads, 1,
+					  d_inbuf, d_outbuf);
 
   if (d_plan == NULL) {
     fprintf(stderr, "gri_fft_real_rev: error creating plan\n");
+    fftwf_free (d_inbuf);
+    fftwf_free (d_outbuf);
     throw std::runtime_error ("fftwf_plan_dft_c2r_1d failed");
   }
-  gri_fftw_export_wisdom ();	// store new wisdom to disk
 }
 
 gri_fft_real_rev::~gri_fft_real_rev ()
 {
-  fftwf_destroy_plan ((fftwf_plan) d_plan);
+  gri_fft_planner::release_plan (d_plan);
   fftwf_free (d_inbuf);
   fftwf_free (d_outbuf);
 }
@@ -325,6 +462,6 @@ gri_fft_real_rev::set_nthreads(int n)
 void
 gri_fft_real_rev::execute ()
 {
-  fftwf_execute ((fftwf_plan) d_plan);
+  fftwf_execute_dft_c2r ((fftwf_plan) d_plan,
+			 reinterpret_cast<fftwf_complex *>(d_inbuf), d_outbuf);
 }
-
@@ -42,6 +42,11 @@ float* gri_fft_malloc_float(int size);
  */
 void gri_fft_free(void *b);
 
+/*! \brief True if \p p has the alignment of the fft buffers, so
+ * that it can be passed to the new-array execute() methods.
+ */
+bool gri_fft_is_aligned(const void *p);
+
 
 /*!
  * \brief Export reference to planner mutex for those apps that
@@ -54,6 +59,38 @@ public:
    * Return reference to planner mutex
    */
   static boost::mutex &mutex();
+
+  enum plan_type {
+    COMPLEX_FORWARD,
+    COMPLEX_REVERSE,
+    REAL_FORWARD,
+    REAL_REVERSE
+  };
+
+  /*!
+   * \brief Return a shared FFTW plan (an fftwf_plan) for \p howmany
+   * contiguous transforms of length \p fft_size.
+   *
+   * Plans are cached process wide, keyed on type, size, number of
+   * threads, howmany and the alignment of \p inbuf and \p outbuf, so
+   * identical transforms are only planned once.  \p inbuf and
+   * \p outbuf are only used for planning; a shared plan must be run
+   * with the new-array execute functions (fftwf_execute_dft etc.) on
+   * buffers allocated with gri_fft_malloc_*.
+   *
+   * Wisdom is read from disk on the first call and written back once
+   * at exit.  Takes the planner mutex.  Returns 0 if FFTW could not
+   * create the plan.  Each successful call must be matched by a call
+   * to release_plan.
+   */
+  static void *acquire_plan(plan_type type, int fft_size, int nthreads,
+			    int howmany, void *inbuf, void *outbuf);
+
+  /*!
+   * \brief Drop a reference to a plan returned by acquire_plan.
+   * The plan is destroyed when its last user releases it.
+   */
+  static void release_plan(void *plan);
 };
 
 /*!
@@ -63,12 +100,21 @@ public:
 class GR_CORE_API gri_fft_complex {
   int	      d_fft_size;
   int         d_nthreads;
+  int         d_howmany;
   gr_complex *d_inbuf;
   gr_complex *d_outbuf;
   void	     *d_plan;
 
 public:
-  gri_fft_complex (int fft_size, bool forward = true, int nthreads=1);
+  /*!
+   * \param fft_size  length of each transform
+   * \param forward   forward or reverse transform
+   * \param nthreads  number of FFTW threads
+   * \param howmany   number of transforms done by each call to
+   *                  execute().  The buffers hold \p howmany
+   *                  vectors of \p fft_size back to back.
+   */
+  gri_fft_complex (int fft_size, bool forward = true, int nthreads=1, int howmany=1);
   virtual ~gri_fft_complex ();
 
   /*
@@ -79,8 +125,18 @@ public:
   gr_complex *get_inbuf ()  const { return d_inbuf; }
   gr_complex *get_outbuf () const { return d_outbuf; }
 
-  int inbuf_length ()  const { return d_fft_size; }
-  int outbuf_length () const { return d_fft_size; }
+  int inbuf_length ()  const { return d_fft_size * d_howmany; }
+  int outbuf_length () const { return d_fft_size * d_howmany; }
+
+  /*!
+   * Length of each transform.
+   */
+  int fft_size () const { return d_fft_size; }
+
+  /*!
+   * Number of transforms computed by each call to execute().
+   */
+  int howmany () const { return d_howmany; }
 
   /*!
    *  Set the number of threads to use for caclulation.
@@ -96,6 +152,13 @@ public:
    * compute FFT.  The input comes from inbuf, the output is placed in outbuf.
    */
   void execute ();
+
+  /*!
+   * compute FFT from \p in to \p out instead of inbuf to outbuf.
+   * Both hold howmany() vectors back to back, must not overlap and
+   * must satisfy gri_fft_is_aligned.  \p in is not modified.
+   */
+  void execute (const gr_complex *in, gr_complex *out);
 };
 
 /*!
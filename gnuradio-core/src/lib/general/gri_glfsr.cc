@@ -21,6 +21,7 @@
  */
 
 #include <gri_glfsr.h>
+#include <gri_lfsr_jump.h>
 #include <stdexcept>
 
 static int s_polynomial_masks[] = {
@@ -65,3 +66,28 @@ int gri_glfsr::glfsr_mask(int degree)
     throw std::runtime_error("gri_glfsr::glfsr_mask(): degree must be between 1 and 32 inclusive");
   return s_polynomial_masks[degree];
 }
+
+void gri_glfsr::next_bits(unsigned char *out, int n)
+{
+  int i = 0;
+
+  if (n >= 64) {
+    if (!d_jump) {
+      // d_shift_register >>= 1 is an arithmetic shift: bit 31 stays put
+      uint32_t next[32];
+      next[0] = d_mask;
+      for (int j = 1; j < 31; j++)
+	next[j] = (uint32_t) 1 << (j - 1);
+      next[31] = 0xc0000000;
+      d_jump.reset(new gri_lfsr_jump(next, 1));
+    }
+
+    uint32_t reg = d_shift_register;
+    for (; i + 64 <= n; i += 64)
+      gri_lfsr_jump::unpack(d_jump->advance(reg), &out[i]);
+    d_shift_register = reg;
+  }
+
+  for (; i < n; i++)
+    out[i] = next_bit();
+}
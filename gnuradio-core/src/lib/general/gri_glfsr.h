@@ -24,12 +24,17 @@
 #define INCLUDED_GRI_GLFSR_H
 
 #include <gr_core_api.h>
+#include <boost/shared_ptr.hpp>
+
+class gri_lfsr_jump;
 
 /*!
  * \brief Galois Linear Feedback Shift Register using specified polynomial mask
  * \ingroup misc
  *
  * Generates a maximal length pseudo-random sequence of length 2^degree-1
+ *
+ * next_bits() generates many bits 64 at a time (see gri_lfsr_jump.)
  */
 
 class GR_CORE_API gri_glfsr
@@ -37,6 +42,7 @@ class GR_CORE_API gri_glfsr
  private:
   int d_shift_register;
   int d_mask;
+  boost::shared_ptr<gri_lfsr_jump> d_jump;
 
  public:
 
@@ -51,6 +57,11 @@ class GR_CORE_API gri_glfsr
     return bit;
   }
 
+  /*!
+   * Set out[i] to the result of the i'th of \p n calls to next_bit()
+   */
+  void next_bits(unsigned char *out, int n);
+
   int mask() const { return d_mask; }
 };
 
@@ -0,0 +1,330 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_interleave.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+  struct item16 { uint64_t w[2]; };
+
+  /*
+   * Copy loops for items [first, nitems).  With the stream count known
+   * at compile time the compiler unrolls the inner loop and can often
+   * vectorize the outer one.
+   */
+  template<class T, int N>
+  void
+  deinterleave_items (void *const out[], const void *in, int first, int nitems)
+  {
+    const T *ip = (const T *) in;
+    T *op[N];
+    for (int k = 0; k < N; k++)
+      op[k] = (T *) out[k];
+
+    for (int i = first; i < nitems; i++)
+      for (int k = 0; k < N; k++)
+	op[k][i] = ip[i*N + k];
+  }
+
+  template<class T, int N>
+  void
+  interleave_items (void *out, const void *const in[], int first, int nitems)
+  {
+    T *op = (T *) out;
+    const T *ip[N];
+    for (int k = 0; k < N; k++)
+      ip[k] = (const T *) in[k];
+
+    for (int i = first; i < nitems; i++)
+      for (int k = 0; k < N; k++)
+	op[i*N + k] = ip[k][i];
+  }
+
+  template<class T>
+  void
+  deinterleave_items (void *const out[], const void *in,
+		      int nstreams, int nitems)
+  {
+    const T *ip = (const T *) in;
+    for (int i = 0; i < nitems; i++)
+      for (int k = 0; k < nstreams; k++)
+	((T *) out[k])[i] = *ip++;
+  }
+
+  template<class T>
+  void
+  interleave_items (void *out, const void *const in[],
+		    int nstreams, int nitems)
+  {
+    T *op = (T *) out;
+    for (int i = 0; i < nitems; i++)
+      for (int k = 0; k < nstreams; k++)
+	*op++ = ((const T *) in[k])[i];
+  }
+
+#ifdef __SSE2__
+
+  /*
+   * Splitting a vector pair into its even and odd elements, and the
+   * inverse, for each element size E.
+   */
+  template<int E> struct lanes;
+
+  template<> struct lanes<1> {
+    static __m128i even (__m128i a, __m128i b) {
+      const __m128i m = _mm_set1_epi16 (0x00ff);
+      return _mm_packus_epi16 (_mm_and_si128 (a, m), _mm_and_si128 (b, m));
+    }
+    static __m128i odd (__m128i a, __m128i b) {
+      return _mm_packus_epi16 (_mm_srli_epi16 (a, 8), _mm_srli_epi16 (b, 8));
+    }
+    static __m128i lo (__m128i a, __m128i b) { return _mm_unpacklo_epi8 (a, b); }
+    static __m128i hi (__m128i a, __m128i b) { return _mm_unpackhi_epi8 (a, b); }
+  };
+
+  template<> struct lanes<2> {
+    // sign extend so the saturating pack is exact
+    static __m128i even (__m128i a, __m128i b) {
+      return _mm_packs_epi32 (_mm_srai_epi32 (_mm_slli_epi32 (a, 16), 16),
+			      _mm_srai_epi32 (_mm_slli_epi32 (b, 16), 16));
+    }
+    static __m128i odd (__m128i a, __m128i b) {
+      return _mm_packs_epi32 (_mm_srai_epi32 (a, 16), _mm_srai_epi32 (b, 16));
+    }
+    static __m128i lo (__m128i a, __m128i b) { return _mm_unpacklo_epi16 (a, b); }
+    static __m128i hi (__m128i a, __m128i b) { return _mm_unpackhi_epi16 (a, b); }
+  };
+
+  template<> struct lanes<4> {
+    static __m128i even (__m128i a, __m128i b) {
+      return _mm_castps_si128 (_mm_shuffle_ps (_mm_castsi128_ps (a), _mm_castsi128_ps (b),
+					       _MM_SHUFFLE (2, 0, 2, 0)));
+    }
+    static __m128i odd (__m128i a, __m128i b) {
+      return _mm_castps_si128 (_mm_shuffle_ps (_mm_castsi128_ps (a), _mm_castsi128_ps (b),
+					       _MM_SHUFFLE (3, 1, 3, 1)));
+    }
+    static __m128i lo (__m128i a, __m128i b) { return _mm_unpacklo_epi32 (a, b); }
+    static __m128i hi (__m128i a, __m128i b) { return _mm_unpackhi_epi32 (a, b); }
+  };
+
+  template<> struct lanes<8> {
+    static __m128i even (__m128i a, __m128i b) { return _mm_unpacklo_epi64 (a, b); }
+    static __m128i odd (__m128i a, __m128i b) { return _mm_unpackhi_epi64 (a, b); }
+    static __m128i lo (__m128i a, __m128i b) { return _mm_unpacklo_epi64 (a, b); }
+    static __m128i hi (__m128i a, __m128i b) { return _mm_unpackhi_epi64 (a, b); }
+  };
+
+  template<> struct lanes<16> {
+    static __m128i even (__m128i a, __m128i) { return a; }
+    static __m128i odd (__m128i, __m128i b) { return b; }
+    static __m128i lo (__m128i a, __m128i) { return a; }
+    static __m128i hi (__m128i, __m128i b) { return b; }
+  };
+
+  /*
+   * N vectors of N interleaved streams <-> one vector per stream.
+   * Taking the even and odd elements of the interleaved data gives
+   * the even and odd numbered streams, still interleaved, so log2(N)
+   * rounds of lanes<E> do the whole transpose.
+   */
+  template<int E, int N>
+  struct shuffle {
+    static void split (const __m128i *v, __m128i *s) {
+      __m128i ev[N/2], od[N/2], se[N/2], so[N/2];
+      for (int j = 0; j < N/2; j++){
+	ev[j] = lanes<E>::even (v[2*j], v[2*j+1]);
+	od[j] = lanes<E>::odd (v[2*j], v[2*j+1]);
+      }
+      shuffle<E, N/2>::split (ev, se);
+      shuffle<E, N/2>::split (od, so);
+      for (int j = 0; j < N/2; j++){
+	s[2*j] = se[j];
+	s[2*j+1] = so[j];
+      }
+    }
+
+    static void merge (const __m128i *s, __m128i *v) {
+      __m128i ev[N/2], od[N/2], se[N/2], so[N/2];
+      for (int j = 0; j < N/2; j++){
+	se[j] = s[2*j];
+	so[j] = s[2*j+1];
+      }
+      shuffle<E, N/2>::merge (se, ev);
+      shuffle<E, N/2>::merge (so, od);
+      for (int j = 0; j < N/2; j++){
+	v[2*j] = lanes<E>::lo (ev[j], od[j]);
+	v[2*j+1] = lanes<E>::hi (ev[j], od[j]);
+      }
+    }
+  };
+
+  template<int E>
+  struct shuffle<E, 1> {
+    static void split (const __m128i *v, __m128i *s) { s[0] = v[0]; }
+    static void merge (const __m128i *s, __m128i *v) { v[0] = s[0]; }
+  };
+
+  // returns the number of items done; the caller finishes the rest
+  template<int E, int N>
+  int
+  deinterleave_simd (void *const out[], const void *in, int nitems)
+  {
+    const int nblocks = nitems / (16 / E);
+    const __m128i *ip = (const __m128i *) in;
+    __m128i v[N], s[N];
+
+    for (int b = 0; b < nblocks; b++){
+      for (int k = 0; k < N; k++)
+	v[k] = _mm_loadu_si128 (ip++);
+      shuffle<E, N>::split (v, s);
+      for (int k = 0; k < N; k++)
+	_mm_storeu_si128 ((__m128i *) out[k] + b, s[k]);
+    }
+    return nblocks * (16 / E);
+  }
+
+  template<int E, int N>
+  int
+  interleave_simd (void *out, const void *const in[], int nitems)
+  {
+    const int nblocks = nitems / (16 / E);
+    __m128i *op = (__m128i *) out;
+    __m128i v[N], s[N];
+
+    for (int b = 0; b < nblocks; b++){
+      for (int k = 0; k < N; k++)
+	s[k] = _mm_loadu_si128 ((const __m128i *) in[k] + b);
+      shuffle<E, N>::merge (s, v);
+      for (int k = 0; k < N; k++)
+	_mm_storeu_si128 (op++, v[k]);
+    }
+    return nblocks * (16 / E);
+  }
+
+#else
+
+  template<int E, int N>
+  int deinterleave_simd (void *const out[], const void *in, int nitems) { return 0; }
+
+  template<int E, int N>
+  int interleave_simd (void *out, const void *const in[], int nitems) { return 0; }
+
+#endif /* __SSE2__ */
+
+  template<class T>
+  void
+  deinterleave_typed (void *const out[], const void *in, int nstreams, int nitems)
+  {
+    const int E = sizeof (T);
+    switch (nstreams){
+    case 2:
+      deinterleave_items<T, 2>(out, in, deinterleave_simd<E, 2>(out, in, nitems), nitems);
+      break;
+    case 3:
+      deinterleave_items<T, 3>(out, in, 0, nitems);
+      break;
+    case 4:
+      deinterleave_items<T, 4>(out, in, deinterleave_simd<E, 4>(out, in, nitems), nitems);
+      break;
+    case 8:
+      deinterleave_items<T, 8>(out, in, deinterleave_simd<E, 8>(out, in, nitems), nitems);
+      break;
+    default:
+      deinterleave_items<T>(out, in, nstreams, nitems);
+    }
+  }
+
+  template<class T>
+  void
+  interleave_typed (void *out, const void *const in[], int nstreams, int nitems)
+  {
+    const int E = sizeof (T);
+    switch (nstreams){
+    case 2:
+      interleave_items<T, 2>(out, in, interleave_simd<E, 2>(out, in, nitems), nitems);
+      break;
+    case 3:
+      interleave_items<T, 3>(out, in, 0, nitems);
+      break;
+    case 4:
+      interleave_items<T, 4>(out, in, interleave_simd<E, 4>(out, in, nitems), nitems);
+      break;
+    case 8:
+      interleave_items<T, 8>(out, in, interleave_simd<E, 8>(out, in, nitems), nitems);
+      break;
+    default:
+      interleave_items<T>(out, in, nstreams, nitems);
+    }
+  }
+
+} // namespace
+
+void
+gri_deinterleave (void *const out[], const void *in,
+		  int nstreams, size_t itemsize, int nitems)
+{
+  switch (itemsize){
+  case 1:  deinterleave_typed<uint8_t>(out, in, nstreams, nitems);  return;
+  case 2:  deinterleave_typed<uint16_t>(out, in, nstreams, nitems); return;
+  case 4:  deinterleave_typed<uint32_t>(out, in, nstreams, nitems); return;
+  case 8:  deinterleave_typed<uint64_t>(out, in, nstreams, nitems); return;
+  case 16: deinterleave_typed<item16>(out, in, nstreams, nitems);   return;
+  }
+
+  const char *ip = (const char *) in;
+  for (int k = 0; k < nstreams; k++){
+    char *op = (char *) out[k];
+    for (int i = 0; i < nitems; i++)
+      memcpy (op + i * itemsize, ip + (i * nstreams + k) * itemsize, itemsize);
+  }
+}
+
+void
+gri_interleave (void *out, const void *const in[],
+		int nstreams, size_t itemsize, int nitems)
+{
+  switch (itemsize){
+  case 1:  interleave_typed<uint8_t>(out, in, nstreams, nitems);  return;
+  case 2:  interleave_typed<uint16_t>(out, in, nstreams, nitems); return;
+  case 4:  interleave_typed<uint32_t>(out, in, nstreams, nitems); return;
+  case 8:  interleave_typed<uint64_t>(out, in, nstreams, nitems); return;
+  case 16: interleave_typed<item16>(out, in, nstreams, nitems);   return;
+  }
+
+  char *op = (char *) out;
+  for (int k = 0; k < nstreams; k++){
+    const char *ip = (const char *) in[k];
+    for (int i = 0; i < nitems; i++)
+      memcpy (op + (i * nstreams + k) * itemsize, ip + i * itemsize, itemsize);
+  }
+}
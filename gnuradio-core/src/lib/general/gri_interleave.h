@@ -0,0 +1,46 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifndef INCLUDED_GRI_INTERLEAVE_H
+#define INCLUDED_GRI_INTERLEAVE_H
+
+#include <gr_core_api.h>
+#include <stddef.h>
+
+/*
+ * Split a stream of nitems groups of nstreams items into nstreams
+ * separate streams: out[k][i] = in[i*nstreams + k].
+ *
+ * Item sizes of 1, 2, 4, 8 and 16 bytes with 2, 4 or 8 streams are
+ * done with SIMD shuffles; other item sizes and stream counts use a
+ * copy loop.  Buffers must not overlap and must be aligned to the item
+ * size (as all gr_buffers are).
+ */
+GR_CORE_API void gri_deinterleave (void *const out[], const void *in,
+				   int nstreams, size_t itemsize, int nitems);
+
+/*
+ * The inverse of gri_deinterleave: out[i*nstreams + k] = in[k][i].
+ */
+GR_CORE_API void gri_interleave (void *out, const void *const in[],
+				 int nstreams, size_t itemsize, int nitems);
+
+#endif /* INCLUDED_GRI_INTERLEAVE_H */
@@ -0,0 +1,93 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_lfsr.h>
+#include <gri_lfsr_jump.h>
+
+const gri_lfsr_jump &
+gri_lfsr::jump(jump_mode mode)
+{
+  if (!d_jump || d_jump_mode != mode) {
+    uint32_t newbit = (uint32_t) 1 << d_shift_register_length;
+    uint32_t next[32];
+
+    // each bit moves down one; the masked ones feed the new bit,
+    // except when descrambling, where the input does
+    for (int j = 0; j < 32; j++) {
+      next[j] = ((uint32_t) 1 << j) >> 1;
+      if (mode != DESCRAMBLE && ((d_mask >> j) & 1))
+	next[j] ^= newbit;
+    }
+
+    switch (mode) {
+    case GENERATE:
+      d_jump.reset(new gri_lfsr_jump(next, 1));
+      break;
+    case SCRAMBLE:
+      d_jump.reset(new gri_lfsr_jump(next, 1, newbit, false));
+      break;
+    case DESCRAMBLE:
+      d_jump.reset(new gri_lfsr_jump(next, d_mask, newbit, true));
+      break;
+    }
+    d_jump_mode = mode;
+  }
+  return *d_jump;
+}
+
+void
+gri_lfsr::run(jump_mode mode, unsigned char *out, const unsigned char *in, int n)
+{
+  int i = 0;
+
+  while (i < n) {
+    if (linear() && n - i >= 64) {
+      const gri_lfsr_jump &j = jump(mode);
+      for (; i + 64 <= n; i += 64) {
+	uint64_t bits;
+	if (mode == GENERATE)
+	  bits = j.advance(d_shift_register);
+	else
+	  bits = j.advance(d_shift_register, gri_lfsr_jump::pack(&in[i]));
+	gri_lfsr_jump::unpack(bits, &out[i]);
+      }
+      continue;
+    }
+
+    switch (mode) {
+    case GENERATE:
+      out[i] = next_bit();
+      break;
+    case SCRAMBLE:
+      out[i] = next_bit_scramble(in[i]);
+      break;
+    case DESCRAMBLE:
+      out[i] = next_bit_descramble(in[i]);
+      break;
+    }
+    i++;
+  }
+}
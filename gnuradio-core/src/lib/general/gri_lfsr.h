@@ -26,6 +26,9 @@
 #include <gr_core_api.h>
 #include <stdexcept>
 #include <stdint.h>
+#include <boost/shared_ptr.hpp>
+
+class gri_lfsr_jump;
 
 /*!
  * \brief Fibonacci Linear Feedback Shift Register using specified polynomial mask
@@ -80,6 +83,9 @@
  * See http://en.wikipedia.org/wiki/Scrambler for operation of these
  * last two functions (see multiplicative scrambler.)
  *
+ *  next_bits(), scramble() and descramble() do the same to whole
+ *  arrays of bits, 64 steps at a time (see gri_lfsr_jump.)
+ *
  */
 
 class GR_CORE_API gri_lfsr
@@ -90,6 +96,19 @@ class GR_CORE_API gri_lfsr
   uint32_t d_seed;
   uint32_t d_shift_register_length;	// less than 32
 
+  enum jump_mode { GENERATE, SCRAMBLE, DESCRAMBLE };
+  boost::shared_ptr<gri_lfsr_jump> d_jump;
+  jump_mode d_jump_mode;
+
+  // Seed bits above reg_len are or-ed with the new bits rather than
+  // xor-ed; the jump tables only hold once they have been shifted out.
+  bool linear() const {
+    return ((uint64_t) d_shift_register >> (d_shift_register_length + 1)) == 0;
+  }
+
+  const gri_lfsr_jump &jump(jump_mode mode);
+  void run(jump_mode mode, unsigned char *out, const unsigned char *in, int n);
+
   static uint32_t
   popCount(uint32_t x)
   {
@@ -104,7 +123,8 @@ class GR_CORE_API gri_lfsr
     : d_shift_register(seed),
       d_mask(mask),
       d_seed(seed),
-      d_shift_register_length(reg_len)
+      d_shift_register_length(reg_len),
+      d_jump_mode(GENERATE)
   {
     if (reg_len > 31)
       throw std::invalid_argument("reg_len must be <= 31");
@@ -131,6 +151,25 @@ class GR_CORE_API gri_lfsr
     return output;
   }
 
+  /*!
+   * Set out[i] to the result of the i'th of \p n calls to next_bit()
+   */
+  void next_bits(unsigned char *out, int n) { run(GENERATE, out, 0, n); }
+
+  /*!
+   * Set out[i] to next_bit_scramble(in[i]) for the \p n inputs
+   */
+  void scramble(unsigned char *out, const unsigned char *in, int n) {
+    run(SCRAMBLE, out, in, n);
+  }
+
+  /*!
+   * Set out[i] to next_bit_descramble(in[i]) for the \p n inputs
+   */
+  void descramble(unsigned char *out, const unsigned char *in, int n) {
+    run(DESCRAMBLE, out, in, n);
+  }
+
   /*!
    * Reset shift register to initial seed value
    */
@@ -0,0 +1,166 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_lfsr_jump.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const int REG_BYTES = 4;
+static const int IN_BYTES = 8;
+
+static inline unsigned int
+parity (uint32_t x)
+{
+  x ^= x >> 16;
+  x ^= x >> 8;
+  x ^= x >> 4;
+  x ^= x >> 2;
+  x ^= x >> 1;
+  return x & 1;
+}
+
+static inline int
+lowest_bit (unsigned int x)	// x != 0
+{
+  int n = 0;
+  while (!(x & 1)){
+    x >>= 1;
+    n++;
+  }
+  return n;
+}
+
+gri_lfsr_jump::gri_lfsr_jump (const uint32_t next[32], uint32_t out_mask,
+			      uint32_t in_next, bool out_in)
+  : d_has_input (in_next != 0 || out_in)
+{
+  int nbytes = REG_BYTES + (d_has_input ? IN_BYTES : 0);
+
+  // What 64 steps make of each register bit and each input bit on its own.
+  uint64_t out_img[32 + 64];
+  uint32_t reg_img[32 + 64];
+  for (int k = 0; k < 8 * nbytes; k++){
+    uint32_t reg = k < 32 ? (uint32_t) 1 << k : 0;
+    uint64_t out = 0;
+    for (int i = 0; i < 64; i++){
+      unsigned int in = (k - 32 == i);
+      out |= (uint64_t) (parity (reg & out_mask) ^ (out_in & in)) << i;
+
+      uint32_t r = in ? in_next : 0;
+      for (int j = 0; j < 32; j++)
+	if ((reg >> j) & 1)
+	  r ^= next[j];
+      reg = r;
+    }
+    out_img[k] = out;
+    reg_img[k] = reg;
+  }
+
+  // ...and of each value of each byte, by linearity.
+  d_out.resize (nbytes * 256);
+  d_reg.resize (nbytes * 256);
+  for (int b = 0; b < nbytes; b++){
+    uint64_t *out = &d_out[b * 256];
+    uint32_t *reg = &d_reg[b * 256];
+    out[0] = 0;
+    reg[0] = 0;
+    for (unsigned int v = 1; v < 256; v++){
+      int k = 8 * b + lowest_bit (v);
+      out[v] = out[v & (v - 1)] ^ out_img[k];
+      reg[v] = reg[v & (v - 1)] ^ reg_img[k];
+    }
+  }
+}
+
+uint64_t
+gri_lfsr_jump::advance (uint32_t &reg) const
+{
+  const uint64_t *out = &d_out[0];
+  const uint32_t *rt = &d_reg[0];
+  unsigned int b0 = reg & 0xff, b1 = (reg >> 8) & 0xff;
+  unsigned int b2 = (reg >> 16) & 0xff, b3 = reg >> 24;
+
+  reg = rt[b0] ^ rt[256 + b1] ^ rt[512 + b2] ^ rt[768 + b3];
+  return out[b0] ^ out[256 + b1] ^ out[512 + b2] ^ out[768 + b3];
+}
+
+uint64_t
+gri_lfsr_jump::advance (uint32_t &reg, uint64_t in) const
+{
+  uint64_t o = advance (reg);
+
+  if (d_has_input){
+    for (int b = REG_BYTES; b < REG_BYTES + IN_BYTES; b++){
+      unsigned int v = (unsigned int) (in >> (8 * (b - REG_BYTES))) & 0xff;
+      o ^= d_out[b * 256 + v];
+      reg ^= d_reg[b * 256 + v];
+    }
+  }
+  return o;
+}
+
+uint64_t
+gri_lfsr_jump::pack (const unsigned char *in)
+{
+  uint64_t bits = 0;
+
+#if defined(__SSE2__)
+  // move each byte's LSB to its MSB and gather those 16 at a time
+  for (int b = 0; b < 64; b += 16){
+    __m128i v = _mm_loadu_si128 ((const __m128i *) &in[b]);
+    bits |= (uint64_t) (unsigned int) _mm_movemask_epi8 (_mm_slli_epi16 (v, 7)) << b;
+  }
+#else
+  for (int b = 0; b < 64; b++)
+    bits |= (uint64_t) (in[b] & 1) << b;
+#endif
+
+  return bits;
+}
+
+void
+gri_lfsr_jump::unpack (uint64_t bits, unsigned char *out)
+{
+#if defined(__SSE2__)
+  // spread each of 2 bytes over 8 bytes, then pick bit i of byte i
+  const __m128i sel = _mm_set_epi8 ((char) 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1,
+				    (char) 0x80, 0x40, 0x20, 0x10, 8, 4, 2, 1);
+  const __m128i one = _mm_set1_epi8 (1);
+  for (int b = 0; b < 64; b += 16){
+    __m128i v = _mm_cvtsi32_si128 ((int) ((bits >> b) & 0xffff));
+    v = _mm_unpacklo_epi8 (v, v);
+    v = _mm_unpacklo_epi16 (v, v);
+    v = _mm_unpacklo_epi32 (v, v);
+    v = _mm_and_si128 (_mm_cmpeq_epi8 (_mm_and_si128 (v, sel), sel), one);
+    _mm_storeu_si128 ((__m128i *) &out[b], v);
+  }
+#else
+  for (int b = 0; b < 64; b++)
+    out[b] = (bits >> b) & 1;
+#endif
+}
@@ -0,0 +1,80 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifndef INCLUDED_GRI_LFSR_JUMP_H
+#define INCLUDED_GRI_LFSR_JUMP_H
+
+#include <gr_core_api.h>
+#include <stdint.h>
+#include <vector>
+
+/*!
+ * \brief Advance a linear feedback shift register 64 bits at a time.
+ * \ingroup misc
+ *
+ * One step of gri_lfsr or gri_glfsr -- plain, scrambling or
+ * descrambling -- is linear over GF(2) in the 32 bit register and the
+ * input bit.  So are 64 steps: the 64 output bits and the new register
+ * are the xor of the contributions of each byte of the register and
+ * of the 64 input bits, which are looked up in tables built once from
+ * the one step map.
+ */
+class GR_CORE_API gri_lfsr_jump
+{
+public:
+  /*!
+   * \brief Build the tables for the register whose one step is given by
+   *
+   *   new register = xor of next[j] over the bits j set in the
+   *                  register, xor \p in_next if the input bit is 1
+   *   output bit   = parity of register & \p out_mask, xor the input
+   *                  bit if \p out_in
+   *
+   * Leave \p in_next 0 and \p out_in false for a register without
+   * input.
+   */
+  gri_lfsr_jump (const uint32_t next[32], uint32_t out_mask,
+		 uint32_t in_next = 0, bool out_in = false);
+
+  /*!
+   * \brief Do 64 steps with bit i of \p in as the input of step i.
+   *
+   * Updates \p reg and returns the 64 output bits, the first in bit 0.
+   */
+  uint64_t advance (uint32_t &reg, uint64_t in) const;
+
+  //! Do 64 steps of a register without input.
+  uint64_t advance (uint32_t &reg) const;
+
+  //! Bit i of the result is the LSB of in[i].
+  static uint64_t pack (const unsigned char *in);
+
+  //! Set out[i] to bit i of \p bits, 0 or 1.
+  static void unpack (uint64_t bits, unsigned char *out);
+
+private:
+  // [byte][value], the register's 4 bytes then the input's 8
+  std::vector<uint64_t>	d_out;
+  std::vector<uint32_t>	d_reg;
+  bool			d_has_input;
+};
+
+#endif /* INCLUDED_GRI_LFSR_JUMP_H */
@@ -0,0 +1,322 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_viterbi_27.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VITERBI27_AVX2 1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define VITERBI27_AVX2 0
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if VITERBI27_AVX2
+// AVX2, and the OS saving the YMM registers, checked once at load time
+static bool
+have_avx2 ()
+{
+  unsigned int eax, ebx, ecx, edx, xcr0;
+  if (!__get_cpuid (1, &eax, &ebx, &ecx, &edx))
+    return false;
+  if (!(ecx & bit_OSXSAVE) || __get_cpuid_max (0, 0) < 7)
+    return false;
+  __asm__ ("xgetbv" : "=a" (xcr0), "=d" (edx) : "c" (0));
+  if ((xcr0 & 6) != 6)
+    return false;
+  __cpuid_count (7, 0, eax, ebx, ecx, edx);
+  return (ebx & bit_AVX2) != 0;
+}
+
+static const bool s_have_avx2 = have_avx2 ();
+#endif
+
+/*
+ * Branch metric index of butterfly i, as in the BUTTERFLY calls of
+ * viterbi.c.  Butterfly i joins states i and i+32 into states 2*i
+ * and 2*i+1.  Going to 2*i, state i sends sym and state i+32 sends
+ * 3^sym; going to 2*i+1 the other way round.
+ */
+static const int butterfly_sym[32] = {
+  0, 1, 3, 2, 3, 2, 0, 1, 0, 1, 3, 2, 3, 2, 0, 1,
+  2, 3, 1, 0, 1, 0, 2, 3, 2, 3, 1, 0, 1, 0, 2, 3
+};
+
+/*
+ * One trellis step over all 64 states in place.  Ties go to the
+ * upper state (i+32), like the ACS in viterbi.c.  dec[0] gets the
+ * decision of state 2*i in bit i, dec[1] that of state 2*i+1.
+ */
+#if VITERBI27_AVX2
+
+__attribute__((target("avx2")))
+static inline void
+acs_avx2 (int32_t *metrics, const int mets[4], uint32_t dec[2])
+{
+  // butterfly_sym in groups of eight, and 3^sym
+  const __m256i sym_lo = _mm256_setr_epi32 (0, 1, 3, 2, 3, 2, 0, 1);
+  const __m256i sym_lo_x = _mm256_setr_epi32 (3, 2, 0, 1, 0, 1, 3, 2);
+  const __m256i sym_hi = _mm256_setr_epi32 (2, 3, 1, 0, 1, 0, 2, 3);
+  const __m256i sym_hi_x = _mm256_setr_epi32 (1, 0, 2, 3, 2, 3, 1, 0);
+
+  __m256i m = _mm256_setr_epi32 (mets[0], mets[1], mets[2], mets[3],
+				 mets[0], mets[1], mets[2], mets[3]);
+  __m256i bm[2][2] = {
+    { _mm256_permutevar8x32_epi32 (m, sym_lo), _mm256_permutevar8x32_epi32 (m, sym_lo_x) },
+    { _mm256_permutevar8x32_epi32 (m, sym_hi), _mm256_permutevar8x32_epi32 (m, sym_hi_x) }
+  };
+
+  __m256i st[8];
+  for (int g = 0; g < 8; g++)
+    st[g] = _mm256_loadu_si256 ((const __m256i *) &metrics[8*g]);
+
+  uint32_t d0 = 0, d1 = 0;
+  for (int g = 0; g < 4; g++){
+    const __m256i *b = bm[g >> 1];
+    __m256i m0 = _mm256_add_epi32 (st[g], b[0]);
+    __m256i m1 = _mm256_add_epi32 (st[g+4], b[1]);
+    __m256i even = _mm256_max_epi32 (m0, m1);
+    d0 |= (uint32_t) (~_mm256_movemask_ps (_mm256_castsi256_ps (_mm256_cmpgt_epi32 (m0, m1))) & 0xff) << 8*g;
+
+    m0 = _mm256_add_epi32 (st[g], b[1]);
+    m1 = _mm256_add_epi32 (st[g+4], b[0]);
+    __m256i odd = _mm256_max_epi32 (m0, m1);
+    d1 |= (uint32_t) (~_mm256_movemask_ps (_mm256_castsi256_ps (_mm256_cmpgt_epi32 (m0, m1))) & 0xff) << 8*g;
+
+    __m256i lo = _mm256_unpacklo_epi32 (even, odd);
+    __m256i hi = _mm256_unpackhi_epi32 (even, odd);
+    _mm256_storeu_si256 ((__m256i *) &metrics[16*g], _mm256_permute2x128_si256 (lo, hi, 0x20));
+    _mm256_storeu_si256 ((__m256i *) &metrics[16*g+8], _mm256_permute2x128_si256 (lo, hi, 0x31));
+  }
+  dec[0] = d0;
+  dec[1] = d1;
+}
+
+#endif
+
+#if defined(__SSE2__)
+
+// the larger of a and b where gt = a > b
+static inline __m128i
+select_gt (__m128i gt, __m128i a, __m128i b)
+{
+  return _mm_or_si128 (_mm_and_si128 (gt, a), _mm_andnot_si128 (gt, b));
+}
+
+static inline void
+acs (int32_t *metrics, const int mets[4], uint32_t dec[2])
+{
+  __m128i m = _mm_setr_epi32 (mets[0], mets[1], mets[2], mets[3]);
+
+  // butterfly_sym in groups of four, and 3^sym
+  __m128i bm[4][2] = {
+    { _mm_shuffle_epi32 (m, _MM_SHUFFLE (2, 3, 1, 0)), _mm_shuffle_epi32 (m, _MM_SHUFFLE (1, 0, 2, 3)) },
+    { _mm_shuffle_epi32 (m, _MM_SHUFFLE (1, 0, 2, 3)), _mm_shuffle_epi32 (m, _MM_SHUFFLE (2, 3, 1, 0)) },
+    { _mm_shuffle_epi32 (m, _MM_SHUFFLE (0, 1, 3, 2)), _mm_shuffle_epi32 (m, _MM_SHUFFLE (3, 2, 0, 1)) },
+    { _mm_shuffle_epi32 (m, _MM_SHUFFLE (3, 2, 0, 1)), _mm_shuffle_epi32 (m, _MM_SHUFFLE (0, 1, 3, 2)) }
+  };
+
+  __m128i st[16];
+  for (int g = 0; g < 16; g++)
+    st[g] = _mm_loadu_si128 ((const __m128i *) &metrics[4*g]);
+
+  uint32_t d0 = 0, d1 = 0;
+  for (int g = 0; g < 8; g++){
+    const __m128i *b = bm[(g & 1) | ((g >> 1) & 2)];
+    __m128i m0 = _mm_add_epi32 (st[g], b[0]);
+    __m128i m1 = _mm_add_epi32 (st[g+8], b[1]);
+    __m128i gt = _mm_cmpgt_epi32 (m0, m1);
+    __m128i even = select_gt (gt, m0, m1);
+    d0 |= (uint32_t) (~_mm_movemask_ps (_mm_castsi128_ps (gt)) & 0xf) << 4*g;
+
+    m0 = _mm_add_epi32 (st[g], b[1]);
+    m1 = _mm_add_epi32 (st[g+8], b[0]);
+    gt = _mm_cmpgt_epi32 (m0, m1);
+    __m128i odd = select_gt (gt, m0, m1);
+    d1 |= (uint32_t) (~_mm_movemask_ps (_mm_castsi128_ps (gt)) & 0xf) << 4*g;
+
+    _mm_storeu_si128 ((__m128i *) &metrics[8*g], _mm_unpacklo_epi32 (even, odd));
+    _mm_storeu_si128 ((__m128i *) &metrics[8*g+4], _mm_unpackhi_epi32 (even, odd));
+  }
+  dec[0] = d0;
+  dec[1] = d1;
+}
+
+#else
+
+static inline void
+acs (int32_t *metrics, const int mets[4], uint32_t dec[2])
+{
+  int32_t state[64];
+  memcpy (state, metrics, sizeof (state));
+
+  uint32_t d0 = 0, d1 = 0;
+  for (int i = 0; i < 32; i++){
+    int sym = butterfly_sym[i];
+    int32_t m0 = state[i] + mets[sym];
+    int32_t m1 = state[i+32] + mets[3^sym];
+    metrics[2*i] = m0 > m1 ? m0 : m1;
+    d0 |= (uint32_t) !(m0 > m1) << i;
+
+    m0 = state[i] + mets[3^sym];
+    m1 = state[i+32] + mets[sym];
+    metrics[2*i+1] = m0 > m1 ? m0 : m1;
+    d1 |= (uint32_t) !(m0 > m1) << i;
+  }
+  dec[0] = d0;
+  dec[1] = d1;
+}
+
+#endif
+
+// branch metrics for each pair of sent symbols
+static inline void
+branch_metrics (const int mettab[2][256], const unsigned char *symbols, int mets[4])
+{
+  const int *m0 = mettab[0], *m1 = mettab[1];
+  mets[0] = m0[symbols[0]] + m0[symbols[1]];
+  mets[1] = m0[symbols[0]] + m1[symbols[1]];
+  mets[2] = m1[symbols[0]] + m0[symbols[1]];
+  mets[3] = m1[symbols[0]] + m1[symbols[1]];
+}
+
+/*
+ * nbits trellis steps, the first one's decisions going to
+ * dec[first & 63].
+ */
+static void
+steps (const int mettab[2][256], int32_t *metrics, uint32_t dec[64][2],
+       uint64_t first, const unsigned char *symbols, int nbits)
+{
+  for (int n = 0; n < nbits; n++){
+    int mets[4];
+    branch_metrics (mettab, &symbols[2*n], mets);
+    acs (metrics, mets, dec[(first + n) & 63]);
+  }
+}
+
+#if VITERBI27_AVX2
+__attribute__((target("avx2")))
+static void
+steps_avx2 (const int mettab[2][256], int32_t *metrics, uint32_t dec[64][2],
+	    uint64_t first, const unsigned char *symbols, int nbits)
+{
+  for (int n = 0; n < nbits; n++){
+    int mets[4];
+    branch_metrics (mettab, &symbols[2*n], mets);
+    acs_avx2 (metrics, mets, dec[(first + n) & 63]);
+  }
+}
+#endif
+
+gri_viterbi_27::gri_viterbi_27 (const int mettab[2][256])
+{
+  memcpy (d_mettab, mettab, sizeof (d_mettab));
+  reset ();
+}
+
+void
+gri_viterbi_27::reset ()
+{
+  d_metrics[0] = 0;
+  for (int i = 1; i < 64; i++)
+    d_metrics[i] = -999999;
+  memset (d_dec, 0, sizeof (d_dec));
+  d_nbits = 0;
+}
+
+int
+gri_viterbi_27::decode (const unsigned char *symbols, int nbits, unsigned char *out)
+{
+  int nout = 0;
+
+  while (nbits > 0){
+    // up to and including the step after which a byte is due
+    int n = ((5 - d_nbits) & 7) + 1;
+    if (n > nbits)
+      n = nbits;
+
+#if VITERBI27_AVX2
+    if (s_have_avx2)
+      steps_avx2 (d_mettab, d_metrics, d_dec, d_nbits, symbols, n);
+    else
+#endif
+      steps (d_mettab, d_metrics, d_dec, d_nbits, symbols, n);
+    symbols += 2*n;
+    nbits -= n;
+    d_nbits += n;
+
+    if (((d_nbits - 1) & 7) == 5)
+      out[nout++] = traceback (renormalize ());
+  }
+
+  return nout;
+}
+
+/*
+ * Find the best state, the first if several are equally good, and
+ * subtract its metric from all so that they stay small.
+ */
+int
+gri_viterbi_27::renormalize ()
+{
+  int best = 0;
+  for (int i = 1; i < 64; i++)
+    if (d_metrics[i] > d_metrics[best])
+      best = i;
+
+  int32_t bestmetric = d_metrics[best];
+  for (int i = 0; i < 64; i++)
+    d_metrics[i] -= bestmetric;
+
+  return best;
+}
+
+/*
+ * Follow the survivor of state back 32 bits and return the oldest 8
+ * decisions on it, newest in the LSB.  This is what bits 24-31 of
+ * the path register in viterbi.c hold.  Bits before the first one
+ * decoded count as 0.
+ */
+unsigned char
+gri_viterbi_27::traceback (int state) const
+{
+  unsigned int byte = 0;
+  for (int k = 0; k < 32 && (uint64_t) k < d_nbits; k++){
+    const uint32_t *dec = d_dec[(d_nbits - 1 - k) & 63];
+    int i = state >> 1;
+    int d = (dec[state & 1] >> i) & 1;
+    if (k >= 24)
+      byte |= d << (k - 24);
+    state = i + 32*d;
+  }
+  return byte;
+}
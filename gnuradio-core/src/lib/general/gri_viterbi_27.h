@@ -0,0 +1,75 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_GRI_VITERBI_27_H
+#define INCLUDED_GRI_VITERBI_27_H
+
+#include <gr_core_api.h>
+#include <stdint.h>
+
+/*!
+ * \brief Streaming Viterbi decoder for the CCSDS rate 1/2, K=7 code.
+ * \ingroup misc
+ *
+ * Does the same add-compare-select and output steps as feeding
+ * viterbi_butterfly2 and viterbi_get_output (viterbi.h) in the way
+ * gr_decode_ccsds_27_fb does, and its output is bit for bit the same.
+ * The 64 state metrics are kept in 32-bit lanes, four states at a
+ * time with SSE2, or eight with AVX2 where the CPU has it.  They are
+ * renormalized as they go, so they never overflow.  Instead of a 32
+ * bit path register per state, one decision bit per state and bit is
+ * kept and the survivor is traced back when a byte is due.
+ */
+class GR_CORE_API gri_viterbi_27
+{
+public:
+  /*!
+   * \param mettab metric table, [sent bit][received symbol], as made
+   *               by gen_met.
+   */
+  gri_viterbi_27 (const int mettab[2][256]);
+
+  //! Start over in state 0, as viterbi_chunks_init does.
+  void reset ();
+
+  /*!
+   * \brief Decode \p nbits bits from 2*\p nbits offset binary symbols.
+   *
+   * Once every 8 bits, after the 6th, a byte is written to \p out
+   * holding the bits decided 25 to 32 bits earlier along the best
+   * path, MSB first.  The state is kept between calls.
+   *
+   * \returns the number of bytes written.
+   */
+  int decode (const unsigned char *symbols, int nbits, unsigned char *out);
+
+private:
+  int		d_mettab[2][256];
+  int32_t	d_metrics[64];	// state metrics
+  uint32_t	d_dec[64][2];	// decisions of the last 64 bits, even and odd states
+  uint64_t	d_nbits;	// bits decoded since reset
+
+  int renormalize ();
+  unsigned char traceback (int state) const;
+};
+
+#endif /* INCLUDED_GRI_VITERBI_27_H */
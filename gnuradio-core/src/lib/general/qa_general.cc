@@ -33,7 +33,10 @@
 #include <qa_gr_fxpt_nco.h>
 #include <qa_gr_fxpt_vco.h>
 #include <qa_gr_math.h>
+#include <qa_gri_access_code_correlator.h>
+#include <qa_gri_interleave.h>
 #include <qa_gri_lfsr.h>
+#include <qa_gri_viterbi_27.h>
 
 CppUnit::TestSuite *
 qa_general::suite ()
@@ -47,7 +50,10 @@ qa_general::suite ()
   s->addTest (qa_gr_fxpt_nco::suite ());
   s->addTest (qa_gr_fxpt_vco::suite ());
   s->addTest (qa_gr_math::suite ());
+  s->addTest (qa_gri_access_code_correlator::suite ());
+  s->addTest (qa_gri_interleave::suite ());
   s->addTest (qa_gri_lfsr::suite ());
+  s->addTest (qa_gri_viterbi_27::suite ());
 
   return s;
 }
@@ -0,0 +1,142 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_access_code_correlator.h>
+#include <qa_gri_access_code_correlator.h>
+#include <gr_count_bits.h>
+#include <cppunit/TestAssert.h>
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+
+static const int NBITS = 1000;
+static const int NTRIALS = 200;
+
+// Random bits with a few noisy copies of the access code in them.
+static void
+make_input (std::vector<unsigned char> &in, unsigned long long code, unsigned int len)
+{
+  in.resize (NBITS);
+  for (int i = 0; i < NBITS; i++)
+    in[i] = (random () & 0xfe) | (random () & 1);	// junk above the LSB
+
+  for (int r = 0; r < 5; r++){
+    int p = random () % NBITS;
+    for (unsigned int j = 0; j < len && p + j < (unsigned int) NBITS; j++){
+      int bit = ((code >> (63 - j)) & 1) ^ ((random () % 16) == 0);
+      in[p + j] = (in[p + j] & 0xfe) | bit;
+    }
+  }
+}
+
+static unsigned long long
+make_code (unsigned int len)
+{
+  unsigned long long code = 0;
+  for (unsigned int i = 0; i < 64; i++){
+    code <<= 1;
+    if (i < len)
+      code |= random () & 1;
+  }
+  return code;
+}
+
+void
+qa_gri_access_code_correlator::test_search ()
+{
+  srandom (1);
+
+  for (int nt = 0; nt < NTRIALS; nt++){
+    unsigned int len = 1 + random () % 64;
+    unsigned int threshold = random () % (len / 3 + 2);
+    unsigned long long code = make_code (len);
+    unsigned long long mask = ((~0ULL) >> (64 - len)) << (64 - len);
+    std::vector<unsigned char> in;
+    make_input (in, code, len);
+
+    // the bit at a time reference, as in gr_correlate_access_code_tag_bb
+    std::vector<int> expected;
+    unsigned long long data_reg = 0;
+    for (int i = 0; i < NBITS; i++){
+      if (gr_count_bits64 ((data_reg ^ code) & mask) <= threshold)
+	expected.push_back (i);
+      data_reg = (data_reg << 1) | (in[i] & 1);
+    }
+
+    // in uneven pieces, so the state carries over
+    gri_access_code_correlator c;
+    c.set_access_code (code, len, threshold);
+    std::vector<int> found, hits;
+    for (int start = 0; start < NBITS; ){
+      int n = std::min (NBITS - start, 1 + (int) (random () % 150));
+      c.search (&in[start], n, hits);
+      for (size_t h = 0; h < hits.size (); h++)
+	found.push_back (start + hits[h]);
+      start += n;
+    }
+
+    CPPUNIT_ASSERT (found == expected);
+    CPPUNIT_ASSERT_EQUAL (data_reg, (unsigned long long) c.data_reg ());
+  }
+}
+
+void
+qa_gri_access_code_correlator::test_shift_until_match ()
+{
+  srandom (2);
+
+  for (int nt = 0; nt < NTRIALS; nt++){
+    unsigned int threshold = random () % 16;
+    unsigned long long code = make_code (64);
+    std::vector<unsigned char> in;
+    make_input (in, code, 64);
+
+    // the bit at a time reference, as in gr_packet_sink
+    std::vector<int> expected;
+    unsigned long long shift_reg = 0;
+    for (int i = 0; i < NBITS; i++){
+      shift_reg = (shift_reg << 1) | (in[i] & 1);
+      if (gr_count_bits64 (shift_reg ^ code) <= threshold){
+	expected.push_back (i);
+	shift_reg = 0;
+      }
+    }
+
+    gri_access_code_correlator c;
+    c.set_access_code (code, 64, threshold);
+    std::vector<int> found;
+    for (int count = 0; count < NBITS; ){
+      int n = std::min (NBITS - count, 1 + (int) (random () % 150));
+      count += c.shift_until_match (&in[count], n);
+      if (c.matches ()){
+	found.push_back (count - 1);
+	c.reset ();
+      }
+    }
+
+    CPPUNIT_ASSERT (found == expected);
+  }
+}
@@ -0,0 +1,96 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_interleave.h>
+#include <qa_gri_interleave.h>
+#include <cppunit/TestAssert.h>
+#include <string.h>
+#include <vector>
+
+// cover every SIMD case, the copy loops and the tails they leave
+static const size_t itemsizes[] = { 1, 2, 3, 4, 8, 12, 16 };
+static const int stream_counts[] = { 1, 2, 3, 4, 5, 8 };
+static const int NITEMS = 37;
+
+void
+qa_gri_interleave::test_deinterleave ()
+{
+  for (size_t s = 0; s < sizeof (itemsizes) / sizeof (itemsizes[0]); s++){
+    for (size_t c = 0; c < sizeof (stream_counts) / sizeof (stream_counts[0]); c++){
+      size_t itemsize = itemsizes[s];
+      int nstreams = stream_counts[c];
+      size_t nbytes = NITEMS * itemsize;
+
+      std::vector<unsigned char> in (nstreams * nbytes);
+      for (size_t i = 0; i < in.size (); i++)
+	in[i] = (unsigned char) (i * 7 + 3);
+
+      std::vector<std::vector<unsigned char> > out (nstreams);
+      std::vector<void *> outv (nstreams);
+      for (int k = 0; k < nstreams; k++){
+	out[k].resize (nbytes);
+	outv[k] = &out[k][0];
+      }
+
+      gri_deinterleave (&outv[0], &in[0], nstreams, itemsize, NITEMS);
+
+      for (int k = 0; k < nstreams; k++)
+	for (int i = 0; i < NITEMS; i++)
+	  CPPUNIT_ASSERT (memcmp (&out[k][i * itemsize],
+				  &in[(i * nstreams + k) * itemsize], itemsize) == 0);
+    }
+  }
+}
+
+void
+qa_gri_interleave::test_interleave ()
+{
+  for (size_t s = 0; s < sizeof (itemsizes) / sizeof (itemsizes[0]); s++){
+    for (size_t c = 0; c < sizeof (stream_counts) / sizeof (stream_counts[0]); c++){
+      size_t itemsize = itemsizes[s];
+      int nstreams = stream_counts[c];
+      size_t nbytes = NITEMS * itemsize;
+
+      std::vector<std::vector<unsigned char> > in (nstreams);
+      std::vector<const void *> inv (nstreams);
+      for (int k = 0; k < nstreams; k++){
+	in[k].resize (nbytes);
+	for (size_t i = 0; i < nbytes; i++)
+	  in[k][i] = (unsigned char) (i * 5 + k * 31 + 1);
+	inv[k] = &in[k][0];
+      }
+
+      std::vector<unsigned char> out (nstreams * nbytes);
+
+      gri_interleave (&out[0], &inv[0], nstreams, itemsize, NITEMS);
+
+      for (int k = 0; k < nstreams; k++)
+	for (int i = 0; i < NITEMS; i++)
+	  CPPUNIT_ASSERT (memcmp (&out[(i * nstreams + k) * itemsize],
+				  &in[k][i * itemsize], itemsize) == 0);
+    }
+  }
+}
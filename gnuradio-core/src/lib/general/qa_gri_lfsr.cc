@@ -20,11 +20,14 @@
  */
 
 #include <gri_lfsr.h>
+#include <gri_glfsr.h>
 #include <qa_gri_lfsr.h>
 #include <cppunit/TestAssert.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <vector>
+#include <algorithm>
 
 void
 qa_gri_lfsr::test_lfsr ()
@@ -140,3 +143,76 @@ qa_gri_lfsr::test_descrambler()
 
   CPPUNIT_ASSERT(memcmp(expected, &actual[0], len) == 0);
 }
+
+void
+qa_gri_lfsr::test_bulk()
+{
+  // next_bits, scramble and descramble against the bit at a time calls
+  static const uint32_t cases[][3] = {	// mask, seed, length
+    { 0x19, 0x01, 5 }, { 0x8A, 0x7F, 7 }, { 0x8A, 0xFFFF, 7 },
+    { 0x4001, 0x1234, 15 }, { 0x80000057, 0x7fffffff, 31 }
+  };
+  // call lengths, to cross the 64 bit steps in odd places
+  static const int sizes[] = { 1, 63, 64, 65, 200, 7, 1000 };
+  static const int total = 1400;
+
+  std::vector<unsigned char> in(total), expected(total), actual(total);
+  srandom(1);
+  for (int i = 0; i < total; i++)
+    in[i] = random() & 0xff;
+
+  for (unsigned int c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    for (int mode = 0; mode < 3; mode++) {
+      gri_lfsr ref(cases[c][0], cases[c][1], cases[c][2]);
+      gri_lfsr lfsr(cases[c][0], cases[c][1], cases[c][2]);
+
+      for (int i = 0; i < total; i++) {
+	if (mode == 0)
+	  expected[i] = ref.next_bit();
+	else if (mode == 1)
+	  expected[i] = ref.next_bit_scramble(in[i]);
+	else
+	  expected[i] = ref.next_bit_descramble(in[i]);
+      }
+
+      for (int i = 0, k = 0; i < total; k++) {
+	int n = std::min(sizes[k % 7], total - i);
+	if (mode == 0)
+	  lfsr.next_bits(&actual[i], n);
+	else if (mode == 1)
+	  lfsr.scramble(&actual[i], &in[i], n);
+	else
+	  lfsr.descramble(&actual[i], &in[i], n);
+	i += n;
+      }
+
+      CPPUNIT_ASSERT(memcmp(&expected[0], &actual[0], total) == 0);
+    }
+  }
+}
+
+void
+qa_gri_lfsr::test_glfsr_bulk()
+{
+  static const int sizes[] = { 1, 63, 64, 65, 200, 7, 1000 };
+  static const int total = 1400;
+
+  std::vector<unsigned char> expected(total), actual(total);
+
+  for (int degree = 1; degree <= 32; degree++) {
+    int mask = gri_glfsr::glfsr_mask(degree);
+    gri_glfsr ref(mask, 1);
+    gri_glfsr glfsr(mask, 1);
+
+    for (int i = 0; i < total; i++)
+      expected[i] = ref.next_bit();
+
+    for (int i = 0, k = 0; i < total; k++) {
+      int n = std::min(sizes[k % 7], total - i);
+      glfsr.next_bits(&actual[i], n);
+      i += n;
+    }
+
+    CPPUNIT_ASSERT(memcmp(&expected[0], &actual[0], total) == 0);
+  }
+}
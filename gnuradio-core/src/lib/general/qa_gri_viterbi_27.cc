@@ -0,0 +1,141 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gri_viterbi_27.h>
+#include <qa_gri_viterbi_27.h>
+#include <gr_random.h>
+#include <cppunit/TestAssert.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+extern "C" {
+#include <viterbi.h>
+}
+
+static const int NBYTES = 2000;
+
+static void
+make_mettab (int mettab[2][256])
+{
+  // as gr_decode_ccsds_27_fb does
+  float esn0 = 0.5*pow (10.0, 12.0/10.0);
+  gen_met (mettab, 100, esn0, 0.0, 256);
+}
+
+// encode random data into noisy offset binary soft symbols
+static void
+make_symbols (std::vector<unsigned char> &data,
+	      std::vector<unsigned char> &symbols, float noise)
+{
+  gr_random rng (42);
+
+  data.resize (NBYTES);
+  for (int i = 0; i < NBYTES; i++)
+    data[i] = (unsigned char) (rng.ran1 () * 256);
+
+  symbols.resize (16 * NBYTES);
+  encode (&symbols[0], &data[0], NBYTES, 0);
+
+  for (size_t i = 0; i < symbols.size (); i++){
+    float v = (symbols[i] ? 1.0 : -1.0) + noise * rng.gasdev ();
+    if (rng.ran1 () < 0.02)
+      v = 0;		// erasure
+    float s = v * 100 + 128;
+    symbols[i] = (unsigned char) (s > 255 ? 255 : s < 0 ? 0 : floor (s));
+  }
+}
+
+// decode in calls of varying length
+static void
+decode (gri_viterbi_27 &v, const std::vector<unsigned char> &symbols,
+	std::vector<unsigned char> &out)
+{
+  int nbits = symbols.size () / 2;
+  out.resize (nbits / 8);
+  int n = 0;
+  for (int i = 0, k = 1; i < nbits; i += k, k = k * 3 % 97 + 1){
+    k = std::min (k, nbits - i);
+    n += v.decode (&symbols[2*i], k, &out[n]);
+  }
+  CPPUNIT_ASSERT_EQUAL ((int) out.size (), n);
+}
+
+void
+qa_gri_viterbi_27::t1 ()
+{
+  // a clean channel decodes to the data, 4 bytes late
+  int mettab[2][256];
+  make_mettab (mettab);
+
+  std::vector<unsigned char> data, symbols, out;
+  make_symbols (data, symbols, 0.0);
+
+  gri_viterbi_27 v (mettab);
+  decode (v, symbols, out);
+
+  for (int i = 0; i < 4; i++)
+    CPPUNIT_ASSERT_EQUAL (0, (int) out[i]);
+  for (int i = 4; i < NBYTES; i++)
+    CPPUNIT_ASSERT_EQUAL ((int) data[i-4], (int) out[i]);
+
+  // and again after a reset
+  v.reset ();
+  std::vector<unsigned char> out2;
+  decode (v, symbols, out2);
+  CPPUNIT_ASSERT (out == out2);
+}
+
+void
+qa_gri_viterbi_27::t2 ()
+{
+  // bit exact with viterbi_butterfly2, even when the channel is bad
+  int mettab[2][256];
+  make_mettab (mettab);
+
+  static const float noise[] = { 0.5, 1.0, 2.0 };
+  for (size_t k = 0; k < sizeof (noise) / sizeof (noise[0]); k++){
+    std::vector<unsigned char> data, symbols, out;
+    make_symbols (data, symbols, noise[k]);
+
+    struct viterbi_state state0[64], state1[64];
+    memset (state0, 0, sizeof (state0));
+    viterbi_chunks_init (state0);
+    std::vector<unsigned char> expected (NBYTES);
+    for (size_t i = 0, j = 0; i < symbols.size (); i += 4){
+      viterbi_butterfly2 (&symbols[i], mettab, state0, state1);
+      if (i % 16 == 8)
+	viterbi_get_output (state0, &expected[j++]);
+    }
+
+    gri_viterbi_27 v (mettab);
+    decode (v, symbols, out);
+
+    for (int i = 0; i < NBYTES; i++)
+      CPPUNIT_ASSERT_EQUAL ((int) expected[i], (int) out[i]);
+  }
+}
@@ -30,6 +30,7 @@
 #include <gr_io_signature.h>
 #include <assert.h>
 #include <gr_log2_const.h>
+#include <volk/volk.h>
 
 static const unsigned int BITS_PER_TYPE = sizeof(@I_TYPE@) * 8;
 static const unsigned int LOG2_L_TYPE = gr_log2_const<sizeof(@I_TYPE@) * 8>();
@@ -102,6 +103,22 @@ int
     switch (d_endianness){
 
     case GR_MSB_FIRST:
+      if (sizeof(@I_TYPE@) == 1 && d_bits_per_chunk == 1){
+	// one bit per output: whole bytes at a time once aligned
+	int i = 0;
+	for (; i < noutput_items && (index_tmp & 7) != 0; i++, index_tmp++)
+	  out[i] = get_bit_be(in, index_tmp);
+	int nbytes = (noutput_items - i) / 8;
+	volk_8u_unpack_k_bits_8u_u((unsigned char *) &out[i],
+				   (const unsigned char *) &in[index_tmp >> 3],
+				   8, nbytes);
+	i += 8 * nbytes;
+	index_tmp += 8 * nbytes;
+	for (; i < noutput_items; i++, index_tmp++)
+	  out[i] = get_bit_be(in, index_tmp);
+	break;
+      }
+
       for (int i = 0; i < noutput_items; i++){
 	//printf("here msb %d\n",i);
 	@O_TYPE@ x = 0;
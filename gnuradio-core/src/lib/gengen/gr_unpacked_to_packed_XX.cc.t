@@ -29,6 +29,7 @@
 #include <@NAME@.h>
 #include <gr_io_signature.h>
 #include <assert.h>
+#include <volk/volk.h>
 
 static const unsigned int BITS_PER_TYPE = sizeof(@O_TYPE@) * 8;
 
@@ -95,6 +96,15 @@ int
     switch(d_endianness){
 
     case GR_MSB_FIRST:
+      if (sizeof(@O_TYPE@) == 1 && d_bits_per_chunk == 1) {
+	// one bit per input: pack them 8 at a time
+	volk_8u_pack_k_bits_8u_u((unsigned char *) out,
+				 (const unsigned char *) &in[index_tmp],
+				 8, noutput_items);
+	index_tmp += 8 * noutput_items;
+	break;
+      }
+
       for(int i=0;i<noutput_items;i++) {
 	@O_TYPE@ tmp=0;
 	for(unsigned int j=0; j<BITS_PER_TYPE; j++) {
@@ -19,6 +19,7 @@ struct rs {
   unsigned char fcr;        /* First consecutive root, index form */
   unsigned char prim;       /* Primitive element, index form */
   unsigned char iprim;      /* prim-th root of 1, index form */
+  unsigned char *syn_mul;   /* Nibble product tables of the roots, for syndromes */
 };
 
 static inline unsigned int modnn(struct rs *rs, unsigned int x){
@@ -39,18 +40,25 @@ static inline unsigned int modnn(struct rs *rs, unsigned int x){
 #define FCR (rs->fcr)
 #define PRIM (rs->prim)
 #define IPRIM (rs->iprim)
+#define SYN_MUL (rs->syn_mul)
 #define A0 (NN)
 
 #define ENCODE_RS encode_rs_char
 #define DECODE_RS decode_rs_char
 #define INIT_RS init_rs_char
 #define FREE_RS free_rs_char
+#define SYNDROMES_RS syndromes_rs_char
+#define CORRECT_RS correct_rs_char
 
 GR_CORE_API void ENCODE_RS(void *p,DTYPE *data,DTYPE *parity);
 GR_CORE_API int DECODE_RS(void *p,DTYPE *data,int *eras_pos,int no_eras);
 GR_CORE_API void *INIT_RS(unsigned int symsize,unsigned int gfpoly,unsigned int fcr,
 		   unsigned int prim,unsigned int nroots);
 GR_CORE_API void FREE_RS(void *p);
+GR_CORE_API int SYNDROMES_RS(void *p,const DTYPE *data,int len,int stride,int nblocks,
+			     DTYPE *syndromes);
+GR_CORE_API int CORRECT_RS(void *p,DTYPE *data,int len,const DTYPE *syndromes,
+			   int *eras_pos,int no_eras);
 
 
 
@@ -20,11 +20,19 @@
 #include "char.h"
 #endif
 
+#ifdef CORRECT_RS
+/* Correct the shortened codeword data[0..len-1], given its syndromes in
+ * poly form.  DECODE_RS below is the full length case.
+ */
+int CORRECT_RS(void *p, DTYPE *data, int len, const DTYPE *syndromes,
+	       int *eras_pos, int no_eras){
+#else
 int DECODE_RS(
 #ifndef FIXED
 void *p,
 #endif
 DTYPE *data, int *eras_pos, int no_eras){
+#endif
 
 #ifndef FIXED
   struct rs *rs = (struct rs *)p;
@@ -46,6 +54,15 @@ DTYPE *data, int *eras_pos, int no_eras){
 #endif
   int syn_error, count;
 
+#ifdef CORRECT_RS
+  /* data[0] is symbol pad of the full block */
+  int pad = NN - len;
+
+  for(i=0;(unsigned int)i<NROOTS;i++)
+    s[i] = syndromes[i];
+#else
+  int pad = 0;
+
   /* form the syndromes; i.e., evaluate data(x) at roots of g(x) */
   for(i=0;(unsigned int)i<NROOTS;i++)
     s[i] = data[0];
@@ -59,6 +76,7 @@ DTYPE *data, int *eras_pos, int no_eras){
       }
     }
   }
+#endif
 
   /* Convert syndromes to index form, checking for nonzero condition */
   syn_error = 0;
@@ -79,9 +97,9 @@ DTYPE *data, int *eras_pos, int no_eras){
 
   if (no_eras > 0) {
     /* Init lambda to be the erasure locator polynomial */
-    lambda[1] = ALPHA_TO[MODNN(PRIM*(NN-1-eras_pos[0]))];
+    lambda[1] = ALPHA_TO[MODNN(PRIM*(NN-1-pad-eras_pos[0]))];
     for (i = 1; i < no_eras; i++) {
-      u = MODNN(PRIM*(NN-1-eras_pos[i]));
+      u = MODNN(PRIM*(NN-1-pad-eras_pos[i]));
       for (j = i+1; j > 0; j--) {
 	tmp = INDEX_OF[lambda[j - 1]];
 	if(tmp != A0)
@@ -256,15 +274,29 @@ DTYPE *data, int *eras_pos, int no_eras){
       count = -1;
       goto finish;
     }
-    /* Apply error to data */
-    if (num1 != 0) {
-      data[loc[j]] ^= ALPHA_TO[MODNN(INDEX_OF[num1] + INDEX_OF[num2] + NN - INDEX_OF[den])];
+    /* Apply error to data, unless it is in the zero padding */
+    if (num1 != 0 && loc[j] >= pad) {
+      data[loc[j] - pad] ^= ALPHA_TO[MODNN(INDEX_OF[num1] + INDEX_OF[num2] + NN - INDEX_OF[den])];
     }
   }
  finish:
   if(eras_pos != NULL){
     for(i=0;i<count;i++)
-      eras_pos[i] = loc[i];
+      eras_pos[i] = loc[i] - pad;
   }
   return count;
 }
+
+#ifdef CORRECT_RS
+int DECODE_RS(void *p, DTYPE *data, int *eras_pos, int no_eras){
+  struct rs *rs = (struct rs *)p;
+#ifdef MAX_ARRAY
+  DTYPE s[MAX_ARRAY];
+#else
+  DTYPE s[NROOTS];
+#endif
+
+  SYNDROMES_RS(p, data, NN, NN, 1, s);
+  return CORRECT_RS(p, data, NN, s, eras_pos, no_eras);
+}
+#endif
@@ -27,6 +27,7 @@
 #else
 #include "char.h"
 #define EXERCISE exercise_char
+#define EXERCISE_BATCH exercise_char_batch
 #endif
 
 #ifdef FIXED
@@ -132,3 +133,85 @@ int trials){
   }
   return decoder_errors;
 }
+
+#ifdef EXERCISE_BATCH
+#define NBLOCKS 37	/* Two SIMD groups and a remainder */
+
+/* Exercise the shortened, batched path of the RS codec: syndromes for
+ * NBLOCKS codewords of a random shortened length in one call, then
+ * correction of those with errors
+ */
+int EXERCISE_BATCH(void *p,int trials){
+  struct rs *rs = (struct rs *)p;
+  int stride = NN + 3;
+  DTYPE *blocks = (DTYPE *)malloc(NBLOCKS*stride*sizeof(DTYPE));
+  DTYPE *tblocks = (DTYPE *)malloc(NBLOCKS*stride*sizeof(DTYPE));
+  DTYPE *full = (DTYPE *)malloc(NN*sizeof(DTYPE));
+  DTYPE *syndromes = (DTYPE *)malloc(NBLOCKS*NROOTS*sizeof(DTYPE));
+  int *errlocs = (int *)malloc(NN*sizeof(int));
+  int errors[NBLOCKS];
+  int len, pad, b, i, nerrors, derrors;
+  int errval,errloc;
+  int decoder_errors = 0;
+
+  while(trials-- != 0){
+    len = NROOTS + 1 + random() % (NN - NROOTS);
+    pad = NN - len;
+    nerrors = 0;
+
+    for(b=0;b<NBLOCKS;b++){
+      /* Random message with leading zero padding, encoded */
+      memset(full,0,pad*sizeof(DTYPE));
+      for(i=pad;i<(int)(NN-NROOTS);i++)
+	full[i] = random() & NN;
+      ENCODE_RS(rs,&full[0],&full[NN-NROOTS]);
+      memcpy(&blocks[b*stride],&full[pad],len*sizeof(DTYPE));
+      memcpy(&tblocks[b*stride],&full[pad],len*sizeof(DTYPE));
+
+      /* Seed with up to NROOTS/2 errors, a quarter of the blocks clean */
+      errors[b] = (random() & 3) == 0 ? 0 : random() % (NROOTS/2 + 1);
+      if(errors[b] > len)
+	errors[b] = len;
+      memset(errlocs,0,NN*sizeof(int));
+      for(i=0;i<errors[b];i++){
+	do {
+	  errval = random() & NN;
+	} while(errval == 0);
+	do {
+	  errloc = random() % len;
+	} while(errlocs[errloc] != 0);
+	errlocs[errloc] = 1;
+	tblocks[b*stride + errloc] ^= errval;
+      }
+      if(errors[b] != 0)
+	nerrors++;
+    }
+
+    if(SYNDROMES_RS(rs,tblocks,len,stride,NBLOCKS,syndromes) != nerrors){
+      PRINTPARM
+      printf(" batch syndromes miscount blocks with errors\n");
+      decoder_errors++;
+    }
+    for(b=0;b<NBLOCKS;b++){
+      derrors = CORRECT_RS(rs,&tblocks[b*stride],len,&syndromes[b*NROOTS],NULL,0);
+      if(derrors != errors[b]){
+	PRINTPARM
+	printf(" shortened to %d, decoder says %d errors, true number is %d\n",
+	       len,derrors,errors[b]);
+	decoder_errors++;
+      }
+      if(memcmp(&tblocks[b*stride],&blocks[b*stride],len*sizeof(DTYPE)) != 0){
+	PRINTPARM
+	printf(" shortened to %d, uncorrected errors!\n",len);
+	decoder_errors++;
+      }
+    }
+  }
+  free(blocks);
+  free(tblocks);
+  free(full);
+  free(syndromes);
+  free(errlocs);
+  return decoder_errors;
+}
+#endif
@@ -21,6 +21,9 @@ void FREE_RS(void *p){
   free(rs->alpha_to);
   free(rs->index_of);
   free(rs->genpoly);
+#ifdef SYN_MUL
+  free(rs->syn_mul);
+#endif
   free(rs);
 }
 
@@ -118,6 +121,31 @@ void *INIT_RS(unsigned int symsize,unsigned int gfpoly,unsigned fcr,unsigned pri
   for (i = 0; i <= nroots; i++)
     rs->genpoly[i] = rs->index_of[rs->genpoly[i]];
 
+#ifdef SYN_MUL
+  /* Syndromes are evaluated by Horner's rule, multiplying by each root
+   * once per symbol.  Entries [32*i+x] and [32*i+16+x] of rs->syn_mul
+   * hold the products of the i-th root with x and x<<4, so a product
+   * is two lookups: syn_mul[32*i+(s&15)] ^ syn_mul[32*i+16+(s>>4)].
+   */
+  rs->syn_mul = (DTYPE *)calloc(32*nroots,sizeof(DTYPE));
+  if(rs->syn_mul == NULL){
+    free(rs->genpoly);
+    free(rs->alpha_to);
+    free(rs->index_of);
+    free(rs);
+    return NULL;
+  }
+  for (i = 0; i < nroots; i++) {
+    root = modnn(rs,(fcr+i)*prim);
+    for (j = 1; j < 16; j++){
+      if (j <= rs->nn)
+	rs->syn_mul[32*i+j] = rs->alpha_to[modnn(rs,rs->index_of[j] + root)];
+      if ((j << 4) <= rs->nn)
+	rs->syn_mul[32*i+16+j] = rs->alpha_to[modnn(rs,rs->index_of[j << 4] + root)];
+    }
+  }
+#endif
+
 #if 0
   printf ("genpoly:\n");
   for (i = nroots; i >= 0; i--){
@@ -12,6 +12,26 @@ GR_CORE_API void *init_rs_char(unsigned int symsize,unsigned int gfpoly,
 		   unsigned int fcr,unsigned int prim,unsigned int nroots);
 GR_CORE_API void free_rs_char(void *rs);
 
+/* Shortened codewords and batches of them, 8-bit symbols.  A codeword
+ * of len symbols stands for a full block whose leading nn-len symbols
+ * are zero.
+ *
+ * syndromes_rs_char computes the nroots syndromes (poly form) of the
+ * nblocks codewords at data, data+stride, ... into syndromes[nroots*b]
+ * and returns how many codewords have nonzero syndromes.  Batches of
+ * 16 or more are done SIMD across codewords when the CPU allows.
+ *
+ * correct_rs_char then corrects one codeword in place given its
+ * syndromes.  Erasure and error positions are indices into data[];
+ * an error in the zero padding is counted but not applied, and is
+ * reported at a negative position.  Returns the number of corrected
+ * symbols or -1 if the codeword is uncorrectable.
+ */
+GR_CORE_API int syndromes_rs_char(void *rs,const unsigned char *data,int len,
+		   int stride,int nblocks,unsigned char *syndromes);
+GR_CORE_API int correct_rs_char(void *rs,unsigned char *data,int len,
+		   const unsigned char *syndromes,int *eras_pos,int no_eras);
+
 /* General purpose RS codec, integer symbols */
 GR_CORE_API void encode_rs_int(void *rs,int *data,int *parity);
 GR_CORE_API int decode_rs_int(void *rs,int *data,int *eras_pos,int no_eras);
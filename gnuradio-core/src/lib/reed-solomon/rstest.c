@@ -15,6 +15,7 @@
 #include "rs.h"
 
 int exercise_char(void *,int);
+int exercise_char_batch(void *,int);
 
 #ifdef ALL_VERSIONS
 int exercise_int(void *,int);
@@ -89,6 +90,7 @@ int main(){
 	continue;
       }
       errs = exercise_char(handle,Tab[i].ntrials);
+      errs += exercise_char_batch(handle,Tab[i].ntrials);
     } else {
 #ifdef ALL_VERSIONS
       if((handle = init_rs_int(Tab[i].symsize,Tab[i].genpoly,Tab[i].fcs,Tab[i].prim,Tab[i].nroots)) == NULL){
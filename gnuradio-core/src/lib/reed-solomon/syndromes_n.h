@@ -0,0 +1,47 @@
+/* Reed-Solomon syndromes of SYN_LANES codewords at once, one per byte
+ * lane.  Every lane multiplies by the same root, so each product is a
+ * pair of PSHUFB lookups into that root's nibble tables.
+ *
+ * Included by syndromes_rs.c once per instruction set, with SYN_NAME,
+ * SYN_TARGET, SYN_LANES, syn_vec and the syn_* operations defined.
+ *
+ * Copyright 2012 Free Software Foundation, Inc.
+ * May be used under the terms of the GNU General Public License (GPL)
+ */
+
+__attribute__((target(SYN_TARGET)))
+static void SYN_NAME(struct rs *rs,const DTYPE *data,int len,int stride,DTYPE *syndromes){
+  syn_vec acc[SYN_ROOTS], lo[SYN_ROOTS], hi[SYN_ROOTS];
+  union { syn_vec v; DTYPE c[SYN_LANES]; } col, out;
+  const syn_vec nibble = syn_set1(0x0f);
+  unsigned int r0, nr, i;
+  int j, k;
+
+  for(r0=0;r0<NROOTS;r0+=nr){
+    nr = NROOTS - r0 < SYN_ROOTS ? NROOTS - r0 : SYN_ROOTS;
+    for(i=0;i<nr;i++){
+      acc[i] = syn_zero();
+      lo[i] = syn_table(&SYN_MUL[32*(r0+i)]);
+      hi[i] = syn_table(&SYN_MUL[32*(r0+i)+16]);
+    }
+
+    for(j=0;j<len;j++){
+      /* symbol j of each codeword */
+      for(k=0;k<SYN_LANES;k++)
+	col.c[k] = data[k*stride + j];
+
+      for(i=0;i<nr;i++){
+	syn_vec a = acc[i];
+	acc[i] = syn_xor(col.v,
+			 syn_xor(syn_shuffle(lo[i], syn_and(a, nibble)),
+				 syn_shuffle(hi[i], syn_and(syn_srli(a, 4), nibble))));
+      }
+    }
+
+    for(i=0;i<nr;i++){
+      out.v = acc[i];
+      for(k=0;k<SYN_LANES;k++)
+	syndromes[k*NROOTS + r0 + i] = out.c[k];
+    }
+  }
+}
@@ -0,0 +1,124 @@
+/* Reed-Solomon syndromes, table driven and SIMD across codewords
+ *
+ * Copyright 2012 Free Software Foundation, Inc.
+ * May be used under the terms of the GNU General Public License (GPL)
+ */
+
+#include "char.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SYN_SIMD 1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define SYN_SIMD 0
+#endif
+
+/* Syndromes of one codeword by Horner's rule: s = data[j] ^ s*root */
+static void syndromes_1(struct rs *rs,const DTYPE *data,int len,DTYPE *s){
+  unsigned int i;
+  int j;
+
+  for(i=0;i<NROOTS;i++)
+    s[i] = 0;
+
+  for(j=0;j<len;j++){
+    for(i=0;i<NROOTS;i++){
+      const DTYPE *mul = &SYN_MUL[32*i];
+      s[i] = data[j] ^ mul[s[i] & 15] ^ mul[16 + (s[i] >> 4)];
+    }
+  }
+}
+
+#if SYN_SIMD
+
+/* Roots done per pass over the data; 32 covers the common codes */
+#define SYN_ROOTS 32
+
+#define SYN_NAME syndromes_n_avx2
+#define SYN_TARGET "avx2"
+#define SYN_LANES 32
+#define syn_vec __m256i
+#define syn_table(p) _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(p)))
+#define syn_set1 _mm256_set1_epi8
+#define syn_zero _mm256_setzero_si256
+#define syn_and _mm256_and_si256
+#define syn_xor _mm256_xor_si256
+#define syn_srli _mm256_srli_epi16
+#define syn_shuffle _mm256_shuffle_epi8
+#include "syndromes_n.h"
+#undef SYN_NAME
+#undef SYN_TARGET
+#undef SYN_LANES
+#undef syn_vec
+#undef syn_table
+#undef syn_set1
+#undef syn_zero
+#undef syn_and
+#undef syn_xor
+#undef syn_srli
+#undef syn_shuffle
+
+#define SYN_NAME syndromes_n_ssse3
+#define SYN_TARGET "ssse3"
+#define SYN_LANES 16
+#define syn_vec __m128i
+#define syn_table(p) _mm_loadu_si128((const __m128i *)(p))
+#define syn_set1 _mm_set1_epi8
+#define syn_zero _mm_setzero_si128
+#define syn_and _mm_and_si128
+#define syn_xor _mm_xor_si128
+#define syn_srli _mm_srli_epi16
+#define syn_shuffle _mm_shuffle_epi8
+#include "syndromes_n.h"
+
+/* 0 for neither, 1 for SSSE3, 2 for SSSE3 and AVX2; checked on first use */
+static int syn_level = -1;
+
+static int syn_simd_level(void){
+  unsigned int eax, ebx, ecx, edx, xcr0;
+  int level = 0;
+
+  if(!__get_cpuid(1,&eax,&ebx,&ecx,&edx))
+    return 0;
+  if(ecx & bit_SSSE3)
+    level = 1;
+  /* AVX2 also needs the OS to save the YMM registers */
+  if(level && (ecx & bit_OSXSAVE) && __get_cpuid_max(0,0) >= 7){
+    __asm__ ("xgetbv" : "=a" (xcr0), "=d" (edx) : "c" (0));
+    __cpuid_count(7,0,eax,ebx,ecx,edx);
+    if((xcr0 & 6) == 6 && (ebx & bit_AVX2))
+      level = 2;
+  }
+  return level;
+}
+
+#endif
+
+int SYNDROMES_RS(void *p,const DTYPE *data,int len,int stride,int nblocks,DTYPE *syndromes){
+  struct rs *rs = (struct rs *)p;
+  int b = 0, nerrors = 0;
+  unsigned int i;
+
+#if SYN_SIMD
+  if(syn_level < 0)
+    syn_level = syn_simd_level();
+  if(syn_level >= 2)
+    for(;b + 32 <= nblocks;b += 32)
+      syndromes_n_avx2(rs,data + b*stride,len,stride,syndromes + b*NROOTS);
+  if(syn_level >= 1)
+    for(;b + 16 <= nblocks;b += 16)
+      syndromes_n_ssse3(rs,data + b*stride,len,stride,syndromes + b*NROOTS);
+#endif
+  for(;b < nblocks;b++)
+    syndromes_1(rs,data + b*stride,len,syndromes + b*NROOTS);
+
+  for(b=0;b<nblocks;b++){
+    DTYPE syn_error = 0;
+    for(i=0;i<NROOTS;i++)
+      syn_error |= syndromes[b*NROOTS + i];
+    if(syn_error)
+      nerrors++;
+  }
+  return nerrors;
+}
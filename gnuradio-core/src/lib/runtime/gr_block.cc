@@ -40,6 +40,7 @@ gr_block::gr_block (const std::string &name,
     d_relative_rate (1.0),
     d_history(1),
     d_fixed_rate(false),
+    d_output_aliases_input(false),
     d_tag_propagation_policy(TPP_ALL_TO_ALL)
 {
 }
@@ -90,6 +90,20 @@ class GR_CORE_API gr_block : public gr_basic_block {
    */
   bool fixed_rate() const { return d_fixed_rate; }
 
+  /*!
+   * \brief Return true if output i may share storage with input i.
+   *
+   * When set, the flowgraph may hand this block an output buffer that
+   * is a window onto the buffer its matching input reads from (see
+   * gr_make_buffer_alias).  The output pointer passed to general_work
+   * is then equal to the input pointer, or lies before it if the
+   * block has consumed items it did not produce.  Such a block must
+   * never produce more items on output i than it has consumed on
+   * input i, must write its output front to back, and should skip
+   * the copy when the two pointers are equal.
+   */
+  bool output_aliases_input() const { return d_output_aliases_input; }
+
   // ----------------------------------------------------------------
   //		override these to define your behavior
   // ----------------------------------------------------------------
@@ -263,6 +277,7 @@ class GR_CORE_API gr_block : public gr_basic_block {
   gr_block_detail_sptr	d_detail;		// implementation details
   unsigned              d_history;
   bool                  d_fixed_rate;
+  bool                  d_output_aliases_input;
   tag_propagation_policy_t d_tag_propagation_policy; // policy for moving tags downstream
 
  protected:
@@ -273,6 +288,8 @@ class GR_CORE_API gr_block : public gr_basic_block {
 
   void set_fixed_rate(bool fixed_rate){ d_fixed_rate = fixed_rate; }
 
+  void set_output_aliases_input(bool alias){ d_output_aliases_input = alias; }
+
 
   /*!
    * \brief  Adds a new tag onto the given output buffer.
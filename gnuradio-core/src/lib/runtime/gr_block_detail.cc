@@ -124,6 +124,14 @@ gr_block_detail::produce_each (int how_many_items)
     }
     d_produce_or |= how_many_items;
   }
+  else {
+    // An output sharing its input's storage may have dropped what we
+    // consumed.  Tell it we're done writing so it can catch up.
+    for (int i = 0; i < noutputs (); i++) {
+      if (d_output[i]->alias_of ())
+	d_output[i]->update_write_pointer (0);
+    }
+  }
 }
 
 
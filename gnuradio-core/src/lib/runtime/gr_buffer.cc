@@ -30,6 +30,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <assert.h>
+#include <string.h>
 #include <algorithm>
 #include <boost/math/common_factor_rt.hpp>
 
@@ -80,8 +81,8 @@ minimum_buffer_items (long type_size, long page_size)
 
 gr_buffer::gr_buffer (int nitems, size_t sizeof_item, gr_block_sptr link)
   : d_base (0), d_bufsize (0), d_vmcircbuf (0),
-    d_sizeof_item (sizeof_item), d_link(link),
-    d_write_index (0), d_abs_write_offset(0), d_done (false),
+    d_sizeof_item (sizeof_item), d_link(link), d_owner(this),
+    d_write_pending (false), d_write_index (0), d_abs_write_offset(0), d_done (false),
     d_last_min_items_read(0)
 {
   if (!allocate_buffer (nitems, sizeof_item))
@@ -96,13 +97,41 @@ gr_make_buffer (int nitems, size_t sizeof_item, gr_block_sptr link)
   return gr_buffer_sptr (new gr_buffer (nitems, sizeof_item, link));
 }
 
+gr_buffer::gr_buffer (gr_buffer_reader_sptr reader, gr_block_sptr link)
+  : d_base (reader->d_buffer->d_base), d_bufsize (reader->d_buffer->d_bufsize),
+    d_vmcircbuf (0), d_sizeof_item (reader->get_sizeof_item()), d_link(link),
+    d_owner(reader->d_buffer->d_owner), d_alias_reader(reader),
+    d_write_pending (false), d_write_index (reader->d_read_index), d_abs_write_offset(0), d_done (false),
+    d_last_min_items_read(0)
+{
+  reader->d_buffer->d_aliases.push_back (this);
+  s_buffer_count++;
+}
+
+gr_buffer_sptr
+gr_make_buffer_alias (gr_buffer_reader_sptr reader, gr_block_sptr link)
+{
+  return gr_buffer_sptr (new gr_buffer (reader, link));
+}
+
 gr_buffer::~gr_buffer ()
 {
+  if (d_alias_reader){
+    std::vector<gr_buffer *> &v = d_alias_reader->d_buffer->d_aliases;
+    v.erase (std::find (v.begin (), v.end (), this));
+  }
   delete d_vmcircbuf;
   assert (d_readers.size() == 0);
+  assert (d_aliases.size() == 0);
   s_buffer_count--;
 }
 
+gr_buffer_sptr
+gr_buffer::alias_of () const
+{
+  return d_alias_reader ? d_alias_reader->buffer () : gr_buffer_sptr ();
+}
+
 /*!
  * sets d_vmcircbuf, d_base, d_bufsize.
  * returns true iff successful.
@@ -169,6 +198,11 @@ gr_buffer::space_available ()
       d_last_min_items_read = min_items_read;
     }
 
+    // Readers of the buffers that share our storage hold on to
+    // items too.
+    for (size_t i = 0; i < d_aliases.size (); i++)
+      most_data = std::max (most_data, d_aliases[i]->max_unread (d_write_index));
+
     // The -1 ensures that the case d_write_index == d_read_index is
     // unambiguous.  It indicates that there is no data for the reader
 
@@ -176,9 +210,57 @@ gr_buffer::space_available ()
   }
 }
 
+int
+gr_buffer::max_unread (unsigned write_index)
+{
+  int most_data = 0;
+  for (size_t i = 0; i < d_readers.size (); i++)
+    most_data = std::max (most_data, (int) index_sub (write_index, d_readers[i]->d_read_index));
+  for (size_t i = 0; i < d_aliases.size (); i++)
+    most_data = std::max (most_data, d_aliases[i]->max_unread (write_index));
+  return most_data;
+}
+
+void
+gr_buffer::close_gap ()
+{
+  if (d_write_pending || d_write_index == d_alias_reader->d_read_index)
+    return;
+
+  // A reader with history never gets closer to us than its preload.
+  unsigned keep = 0;
+  for (size_t i = 0; i < d_readers.size (); i++){
+    unsigned unread = index_sub (d_write_index, d_readers[i]->d_read_index);
+    if (unread > d_readers[i]->d_nzero_preload)
+      return;
+    keep = std::max (keep, unread);
+  }
+
+  // The items before the input have already been consumed by our
+  // writer, and the readers' positions keep the upstream writer off
+  // them, so the history can be copied there.
+  // Last item first, since the gap may be shorter than the history.
+  unsigned gap = index_sub (d_alias_reader->d_read_index, d_write_index);
+  for (unsigned j = 1; j <= keep; j++)
+    memcpy (&d_base[index_sub (d_alias_reader->d_read_index, j) * d_sizeof_item],
+	    &d_base[index_sub (d_write_index, j) * d_sizeof_item],
+	    d_sizeof_item);
+
+  d_write_index = d_alias_reader->d_read_index;
+  for (size_t i = 0; i < d_readers.size (); i++)
+    d_readers[i]->d_read_index = index_add (d_readers[i]->d_read_index, gap);
+}
+
 void *
 gr_buffer::write_pointer ()
 {
+  if (d_alias_reader){
+    // Hold the write index still until update_write_pointer
+    gruel::scoped_lock guard(*mutex());
+    d_write_pending = false;
+    close_gap ();
+    d_write_pending = true;
+  }
   return &d_base[d_write_index * d_sizeof_item];
 }
 
@@ -188,6 +270,11 @@ gr_buffer::update_write_pointer (int nitems)
   gruel::scoped_lock guard(*mutex());
   d_write_index = index_add (d_write_index, nitems);
   d_abs_write_offset += nitems;
+
+  if (d_alias_reader){
+    d_write_pending = false;
+    close_gap ();
+  }
 }
 
 void
@@ -206,7 +293,7 @@ gr_buffer_add_reader (gr_buffer_sptr buf, int nzero_preload, gr_block_sptr link)
   gr_buffer_reader_sptr r (new gr_buffer_reader (buf,
 						 buf->index_sub(buf->d_write_index,
 								nzero_preload),
-						 link));
+						 nzero_preload, link));
   buf->d_readers.push_back (r.get ());
 
   return r;
@@ -274,8 +361,9 @@ gr_buffer_ncurrently_allocated ()
 // ----------------------------------------------------------------------------
 
 gr_buffer_reader::gr_buffer_reader(gr_buffer_sptr buffer, unsigned int read_index,
-				   gr_block_sptr link)
-  : d_buffer(buffer), d_read_index(read_index), d_abs_read_offset(0), d_link(link)
+				   unsigned int nzero_preload, gr_block_sptr link)
+  : d_buffer(buffer), d_read_index(read_index), d_abs_read_offset(0), d_link(link),
+    d_nzero_preload(nzero_preload)
 {
   s_buffer_reader_count++;
 }
@@ -304,6 +392,9 @@ gr_buffer_reader::update_read_pointer (int nitems)
   gruel::scoped_lock guard(*mutex());
   d_read_index = d_buffer->index_add (d_read_index, nitems);
   d_abs_read_offset += nitems;
+
+  if (d_buffer->d_alias_reader)
+    d_buffer->close_gap ();
 }
 
 void
@@ -45,6 +45,20 @@ class gr_vmcircbuf;
  */
 GR_CORE_API gr_buffer_sptr gr_make_buffer (int nitems, size_t sizeof_item, gr_block_sptr link=gr_block_sptr());
 
+/*!
+ * \brief Make a buffer that shares the storage of the buffer \p reader reads from.
+ *
+ * Items are written in place into the upstream buffer, starting at
+ * the read position of \p reader.  A block that produces exactly
+ * what it consumes therefore gets an output pointer equal to its
+ * input pointer.  The upstream writer won't overwrite items until
+ * the readers of the new buffer are done with them.
+ *
+ * \param reader is the input of the block that writes to the new buffer.
+ * \param link is the block that writes to the new buffer.
+ */
+GR_CORE_API gr_buffer_sptr gr_make_buffer_alias (gr_buffer_reader_sptr reader, gr_block_sptr link=gr_block_sptr());
+
 
 /*!
  * \brief Single writer, multiple reader fifo.
@@ -89,7 +103,16 @@ class GR_CORE_API gr_buffer {
   size_t nreaders() const { return d_readers.size(); }
   gr_buffer_reader* reader(size_t index) { return d_readers[index]; }
 
-  gruel::mutex *mutex() { return &d_mutex; }
+  /*!
+   * \brief Return the buffer whose storage this buffer shares, if any.
+   */
+  gr_buffer_sptr alias_of() const;
+
+  /*!
+   * All buffers sharing storage share the mutex of the buffer that
+   * owns it.
+   */
+  gruel::mutex *mutex() { return &d_owner->d_mutex; }
 
   uint64_t nitems_written() { return d_abs_write_offset; }
 
@@ -118,6 +141,7 @@ class GR_CORE_API gr_buffer {
 
   friend class gr_buffer_reader;
   friend GR_CORE_API gr_buffer_sptr gr_make_buffer (int nitems, size_t sizeof_item, gr_block_sptr link);
+  friend GR_CORE_API gr_buffer_sptr gr_make_buffer_alias (gr_buffer_reader_sptr reader, gr_block_sptr link);
   friend GR_CORE_API gr_buffer_reader_sptr gr_buffer_add_reader (gr_buffer_sptr buf, int nzero_preload, gr_block_sptr link);
 
  protected:
@@ -128,6 +152,10 @@ class GR_CORE_API gr_buffer {
   size_t	 			d_sizeof_item;	// in bytes
   std::vector<gr_buffer_reader *>	d_readers;
   boost::weak_ptr<gr_block>		d_link;		// block that writes to this buffer
+  gr_buffer			       *d_owner;	// buffer that owns d_base
+  gr_buffer_reader_sptr			d_alias_reader;	// for an alias, the input we write over
+  std::vector<gr_buffer *>		d_aliases;	// buffers sharing our storage
+  bool					d_write_pending; // writer may be writing at d_write_index
 
   //
   // The mutex protects d_write_index, d_abs_write_offset, d_done, d_item_tags
@@ -181,6 +209,30 @@ class GR_CORE_API gr_buffer {
    */
   gr_buffer (int nitems, size_t sizeof_item, gr_block_sptr link);
 
+  /*!
+   * \brief constructor is private.  Use gr_make_buffer_alias to create instances.
+   */
+  gr_buffer (gr_buffer_reader_sptr reader, gr_block_sptr link);
+
+  /*!
+   * \brief Return the most items any reader of this buffer, or of a
+   * buffer sharing its storage, has left to read if the writer were
+   * at \p write_index.
+   */
+  int max_unread (unsigned write_index);
+
+  /*!
+   * \brief Move the write index of an alias up to its reader.
+   *
+   * Once the writer has consumed items it did not produce, its output
+   * lags its input.  When all our readers have read everything but
+   * their history and the writer isn't in the middle of writing, move
+   * that history up against the input and skip the readers past the
+   * dropped items, so that output and input line up again.  Caller
+   * must hold the mutex.
+   */
+  void close_gap ();
+
   /*!
    * \brief disassociate \p reader from this buffer
    */
@@ -288,9 +340,11 @@ class GR_CORE_API gr_buffer_reader {
   unsigned int			d_read_index;	// in items [0,d->buffer.d_bufsize)
   uint64_t                      d_abs_read_offset;  // num items seen since the start
   boost::weak_ptr<gr_block>	d_link;		// block that reads via this buffer reader
+  unsigned int			d_nzero_preload; // history the reader keeps behind the writer
 
   //! constructor is private.  Use gr_buffer::add_reader to create instances
-  gr_buffer_reader (gr_buffer_sptr buffer, unsigned int read_index, gr_block_sptr link);
+  gr_buffer_reader (gr_buffer_sptr buffer, unsigned int read_index,
+		    unsigned int nzero_preload, gr_block_sptr link);
 };
 
 //! returns # of gr_buffer_readers currently allocated
@@ -58,11 +58,14 @@ gr_flat_flowgraph::setup_connections()
 {
   gr_basic_block_vector_t blocks = calc_used_blocks();
 
-  // Assign block details to blocks
+  // Assign block details to blocks.  Outputs that can share the
+  // storage of their input are filled in by connect_block_inputs.
   for (gr_basic_block_viter_t p = blocks.begin(); p != blocks.end(); p++)
-    cast_to_block_sptr(*p)->set_detail(allocate_block_detail(*p));
+    cast_to_block_sptr(*p)->set_detail(allocate_block_detail(*p, true));
 
-  // Connect inputs to outputs for each block
+  // Connect inputs to outputs for each block, upstream blocks first so
+  // that the buffers shared by aliased outputs already exist.
+  blocks = topological_sort(blocks);
   for(gr_basic_block_viter_t p = blocks.begin(); p != blocks.end(); p++) {
     connect_block_inputs(*p);
 
@@ -74,7 +77,7 @@ gr_flat_flowgraph::setup_connections()
 }
 
 gr_block_detail_sptr
-gr_flat_flowgraph::allocate_block_detail(gr_basic_block_sptr block)
+gr_flat_flowgraph::allocate_block_detail(gr_basic_block_sptr block, bool alias)
 {
   int ninputs = calc_used_ports(block, true).size();
   int noutputs = calc_used_ports(block, false).size();
@@ -84,7 +87,9 @@ gr_flat_flowgraph::allocate_block_detail(gr_basic_block_sptr block)
     std::cout << "Creating block detail for " << block << std::endl;
 
   for (int i = 0; i < noutputs; i++) {
-    gr_buffer_sptr buffer = allocate_buffer(block, i);
+    if (alias && can_alias_output(cast_to_block_sptr(block), i))
+      continue;
+    gr_buffer_sptr buffer = allocate_buffer(block, i, alias);
     if (GR_FLAT_FLOWGRAPH_DEBUG)
       std::cout << "Allocated buffer for output " << block << ":" << i << std::endl;
     detail->set_output(i, buffer);
@@ -94,7 +99,7 @@ gr_flat_flowgraph::allocate_block_detail(gr_basic_block_sptr block)
 }
 
 gr_buffer_sptr
-gr_flat_flowgraph::allocate_buffer(gr_basic_block_sptr block, int port)
+gr_flat_flowgraph::allocate_buffer(gr_basic_block_sptr block, int port, bool alias)
 {
   gr_block_sptr grblock = cast_to_block_sptr(block);
   if (!grblock)
@@ -105,26 +110,46 @@ gr_flat_flowgraph::allocate_buffer(gr_basic_block_sptr block, int port)
   // increase the available parallelism when using the TPB scheduler.
   // (We're double buffering, where we used to single buffer)
   int nitems = s_fixed_buffer_size * 2 / item_size;
+  int default_nitems = nitems;
 
   // Make sure there are at least twice the output_multiple no. of items
   if (nitems < 2*grblock->output_multiple())	// Note: this means output_multiple()
     nitems = 2*grblock->output_multiple();	// can't be changed by block dynamically
 
   // If any downstream blocks are decimators and/or have a large output_multiple,
-  // ensure we have a buffer at least twice their decimation factor*output_multiple
-  gr_basic_block_vector_t blocks = calc_downstream_blocks(block, port);
-
-  for (gr_basic_block_viter_t p = blocks.begin(); p != blocks.end(); p++) {
-    gr_block_sptr dgrblock = cast_to_block_sptr(*p);
-    if (!dgrblock)
-      throw std::runtime_error("allocate_buffer found non-gr_block");
-
-    double decimation = (1.0/dgrblock->relative_rate());
-    int multiple      = dgrblock->output_multiple();
-    int history       = dgrblock->history();
-    nitems = std::max(nitems, static_cast<int>(2*(decimation*multiple+history)));
+  // ensure we have a buffer at least twice their decimation factor*output_multiple.
+  // Blocks reading an output that may share this buffer's storage count too.
+  std::vector<gr_endpoint> srcs(1, gr_endpoint(block, port));
+  int naliases = 0;
+
+  while (!srcs.empty()) {
+    gr_endpoint src = srcs.back();
+    srcs.pop_back();
+
+    for (gr_edge_viter_t e = d_edges.begin(); e != d_edges.end(); e++) {
+      if (!(e->src() == src))
+	continue;
+
+      gr_block_sptr dgrblock = cast_to_block_sptr(e->dst().block());
+      if (!dgrblock)
+	throw std::runtime_error("allocate_buffer found non-gr_block");
+
+      double decimation = (1.0/dgrblock->relative_rate());
+      int multiple      = dgrblock->output_multiple();
+      int history       = dgrblock->history();
+      nitems = std::max(nitems, static_cast<int>(2*(decimation*multiple+history)));
+
+      if (alias && can_alias_output(dgrblock, e->dst().port())) {
+	srcs.push_back(gr_endpoint(dgrblock, e->dst().port()));
+	naliases++;
+      }
+    }
   }
 
+  // Each of those outputs would otherwise have had a buffer of its own.
+  // Keep the same total so the blocks sharing this one don't run dry.
+  nitems = std::max(nitems, (1 + naliases) * default_nitems);
+
   return gr_make_buffer(nitems, item_size, grblock);
 }
 
@@ -156,6 +181,33 @@ gr_flat_flowgraph::connect_block_inputs(gr_basic_block_sptr block)
 
     detail->set_input(dst_port, gr_buffer_add_reader(src_buffer, grblock->history()-1, grblock));
   }
+
+  // Outputs left unallocated by allocate_block_detail write in place
+  // into the buffer their matching input reads from.
+  for (int i = 0; i < detail->noutputs(); i++) {
+    if (!detail->output(i))
+      detail->set_output(i, gr_make_buffer_alias(detail->input(i), grblock));
+  }
+}
+
+bool
+gr_flat_flowgraph::can_alias_output(gr_block_sptr block, int port)
+{
+  if (!block->output_aliases_input() || block->history() != 1)
+    return false;
+
+  // The block writes over items it has consumed, so it must be the
+  // only reader of its input.
+  gr_edge edge = calc_upstream_edge(block, port);
+  if (!edge.src().block())
+    return false;
+  for (gr_edge_viter_t e = d_edges.begin(); e != d_edges.end(); e++) {
+    if (e->src() == edge.src() && !(e->dst() == edge.dst()))
+      return false;
+  }
+
+  return (block->input_signature()->sizeof_stream_item(port) ==
+	  block->output_signature()->sizeof_stream_item(port));
 }
 
 void
@@ -203,6 +255,32 @@ gr_flat_flowgraph::merge_connections(gr_flat_flowgraph_sptr old_ffg)
     }
   }
 
+  // A block whose output shares the storage of its input needs fresh
+  // buffers if that input is now fed from somewhere else, or is no
+  // longer its upstream buffer's only reader.  Go upstream blocks first,
+  // so that a block aliasing one that gets fresh buffers sees the change.
+  gr_basic_block_vector_t sorted = topological_sort(d_blocks);
+  for (gr_basic_block_viter_t p = sorted.begin(); p != sorted.end(); p++) {
+    gr_block_sptr block = cast_to_block_sptr(*p);
+    gr_block_detail_sptr detail = block->detail();
+
+    for (int i = 0; i < detail->noutputs(); i++) {
+      gr_buffer_sptr shared = detail->output(i)->alias_of();
+      if (!shared)
+	continue;
+
+      gr_edge edge = calc_upstream_edge(*p, i);
+      gr_block_sptr src_block = cast_to_block_sptr(edge.src().block());
+      if (!can_alias_output(block, i) ||
+	  src_block->detail()->output(edge.src().port()) != shared) {
+	if (GR_FLAT_FLOWGRAPH_DEBUG)
+	  std::cout << "merge: input of aliased output " << (*p) << ":" << i << " changed" << std::endl;
+	block->set_detail(allocate_block_detail(block));
+	break;
+      }
+    }
+  }
+
   // Now connect inputs to outputs, reusing old buffer readers if they exist
   for (gr_basic_block_viter_t p = d_blocks.begin(); p != d_blocks.end(); p++) {
     gr_block_sptr block = cast_to_block_sptr(*p);
@@ -60,10 +60,13 @@ public:
 private:
   gr_flat_flowgraph();
 
-  gr_block_detail_sptr allocate_block_detail(gr_basic_block_sptr block);
-  gr_buffer_sptr allocate_buffer(gr_basic_block_sptr block, int port);
+  gr_block_detail_sptr allocate_block_detail(gr_basic_block_sptr block, bool alias=false);
+  gr_buffer_sptr allocate_buffer(gr_basic_block_sptr block, int port, bool alias=false);
   void connect_block_inputs(gr_basic_block_sptr block);
 
+  // True if output \p port of \p block may share the storage of its input
+  bool can_alias_output(gr_block_sptr block, int port);
+
   /* When reusing a flowgraph's blocks, this call makes sure all of the
    * buffer's are aligned at the machine's alignment boundary and tells
    * the blocks that they are aligned.
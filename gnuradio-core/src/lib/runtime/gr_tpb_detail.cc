@@ -43,8 +43,10 @@ gr_tpb_detail::notify_upstream(gr_block_detail *d)
   // available.
 
   for (size_t i = 0; i < d->d_input.size(); i++){
-    // Can you say, "pointer chasing?"
-    d->d_input[i]->buffer()->link()->detail()->d_tpb.set_output_changed();
+    // Can you say, "pointer chasing?"  If the buffer shares storage
+    // with buffers further upstream, their writers get space too.
+    for (gr_buffer_sptr buf = d->d_input[i]->buffer(); buf; buf = buf->alias_of())
+      buf->link()->detail()->d_tpb.set_output_changed();
   }
 }
 
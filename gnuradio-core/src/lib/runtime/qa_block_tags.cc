@@ -32,6 +32,7 @@
 #include <gr_annotator_alltoall.h>
 #include <gr_annotator_1to1.h>
 #include <gr_keep_one_in_n.h>
+#include <gr_throttle.h>
 #include <gr_firdes.h>
 #include <gruel/pmt.h>
 
@@ -448,3 +449,58 @@ qa_block_tags::t5 ()
 #endif
 }
 
+
+
+// seconds since the epoch held by an rx_time tag
+static double
+rx_time_of(const gr_tag_t &tag)
+{
+  return pmt_to_uint64(pmt_tuple_ref(tag.value, 0))
+    + pmt_to_double(pmt_tuple_ref(tag.value, 1));
+}
+
+void
+qa_block_tags::t6 ()
+{
+  int N = 5000;
+  double rate = 1e6;
+  gr_top_block_sptr tb = gr_make_top_block("top");
+  gr_block_sptr src (gr_make_null_source(sizeof(float)));
+  gr_block_sptr head (gr_make_head(sizeof(float), N));
+  gr_throttle::sptr thr0 (gr_make_throttle(sizeof(float), rate/10));
+  gr_throttle::sptr thr1 (gr_make_throttle(sizeof(float), rate));
+  gr_annotator_1to1_sptr ann0 (gr_make_annotator_1to1(N, sizeof(float)));
+  gr_block_sptr snk0 (gr_make_null_sink(sizeof(float)));
+
+  // thr1 is starved by the slower thr0, so with a burst limit its
+  // schedule keeps slipping and each slip gets a new rx_time tag
+  thr0->set_max_burst(10);
+  thr1->set_max_burst(100);
+  thr1->set_tag_time(true);
+
+  tb->connect(src,  0, head, 0);
+  tb->connect(head, 0, thr0, 0);
+  tb->connect(thr0, 0, thr1, 0);
+  tb->connect(thr1, 0, ann0, 0);
+  tb->connect(ann0, 0, snk0, 0);
+
+  tb->run();
+
+  std::vector<gr_tag_t> tags = ann0->data();
+  pmt_t key = pmt_string_to_symbol("rx_time");
+
+  CPPUNIT_ASSERT(tags.size() > 1);
+  CPPUNIT_ASSERT_EQUAL(tags[0].offset, (uint64_t)0);
+  double t0 = rx_time_of(tags[0]);
+  for(size_t i = 0; i < tags.size(); i++) {
+    CPPUNIT_ASSERT(pmt_eq(tags[i].key, key));
+
+    // slips only ever push the schedule back
+    double t = rx_time_of(tags[i]);
+    CPPUNIT_ASSERT(t - t0 >= tags[i].offset/rate - 1e-6);
+    if(i > 0) {
+      CPPUNIT_ASSERT(tags[i].offset > tags[i-1].offset);
+      CPPUNIT_ASSERT(t > rx_time_of(tags[i-1]));
+    }
+  }
+}
@@ -36,6 +36,7 @@ class qa_block_tags : public CppUnit::TestCase {
   CPPUNIT_TEST (t3);
   CPPUNIT_TEST (t4);
   CPPUNIT_TEST (t5);
+  CPPUNIT_TEST (t6);
   CPPUNIT_TEST_SUITE_END ();
 
  private:
@@ -45,6 +46,7 @@ class qa_block_tags : public CppUnit::TestCase {
   void t3 ();
   void t4 ();
   void t5 ();
+  void t6 ();
 
 };
 
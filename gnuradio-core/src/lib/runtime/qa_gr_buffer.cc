@@ -270,6 +270,68 @@ t3_body ()
 }
 
 
+// ----------------------------------------------------------------------------
+// test a buffer sharing the storage of another
+//
+
+static void
+t4_body ()
+{
+  int	nitems = 4000 / sizeof (int);
+
+  gr_buffer_sptr buf(gr_make_buffer(nitems, sizeof (int), gr_block_sptr()));
+  gr_buffer_reader_sptr r1 (gr_buffer_add_reader (buf, 0, gr_block_sptr()));
+  gr_buffer_sptr alias(gr_make_buffer_alias(r1, gr_block_sptr()));
+  gr_buffer_reader_sptr r2 (gr_buffer_add_reader (alias, 0, gr_block_sptr()));
+
+  CPPUNIT_ASSERT (alias->alias_of () == buf);
+  CPPUNIT_ASSERT_EQUAL (buf->bufsize (), alias->bufsize ());
+
+  // fill the buffer
+
+  int sa = buf->space_available ();
+  CPPUNIT_ASSERT_EQUAL ((int) buf->bufsize () - 1, sa);
+
+  int *p = (int *) buf->write_pointer ();
+  for (int j = 0; j < sa; j++)
+    p[j] = j;
+  buf->update_write_pointer (sa);
+
+  // pass the first half through in place
+
+  int n = sa / 2;
+  CPPUNIT_ASSERT (alias->write_pointer () == r1->read_pointer ());
+  r1->update_read_pointer (n);
+  alias->update_write_pointer (n);
+
+  // the writer doesn't get the space back until the alias' reader is done
+
+  CPPUNIT_ASSERT_EQUAL (0, buf->space_available ());
+  CPPUNIT_ASSERT_EQUAL (n, r2->items_available ());
+
+  int *rp = (int *) r2->read_pointer ();
+  for (int j = 0; j < n; j++)
+    CPPUNIT_ASSERT_EQUAL (j, rp[j]);
+  r2->update_read_pointer (n - 1);
+  CPPUNIT_ASSERT_EQUAL (n - 1, buf->space_available ());
+
+  // drop the rest while the alias' reader still has an item left
+
+  alias->write_pointer ();
+  r1->update_read_pointer (sa - n);
+  alias->update_write_pointer (0);
+
+  CPPUNIT_ASSERT_EQUAL (1, r2->items_available ());
+  CPPUNIT_ASSERT_EQUAL (n - 1, buf->space_available ());
+
+  // once it has read that, the alias catches up with its input
+
+  r2->update_read_pointer (1);
+  CPPUNIT_ASSERT_EQUAL (0, r2->items_available ());
+  CPPUNIT_ASSERT_EQUAL (sa, buf->space_available ());
+  CPPUNIT_ASSERT (alias->write_pointer () == r1->read_pointer ());
+}
+
 // ----------------------------------------------------------------------------
 
 void
@@ -299,6 +361,7 @@ qa_gr_buffer::t3 ()
 void
 qa_gr_buffer::t4 ()
 {
+  leak_check (t4_body);
 }
 
 void
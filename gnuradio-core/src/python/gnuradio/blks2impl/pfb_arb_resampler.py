@@ -67,7 +67,6 @@ class pfb_arb_resampler_ccf(gr.hier_block2):
         self.connect(self, self.pfb)
         self.connect(self.pfb, self)
 
-    # Note -- set_taps not implemented in base class yet
     def set_taps(self, taps):
         self.pfb.set_taps(taps)
 
@@ -120,7 +119,6 @@ class pfb_arb_resampler_fff(gr.hier_block2):
         self.connect(self, self.pfb)
         self.connect(self.pfb, self)
 
-    # Note -- set_taps not implemented in base class yet
     def set_taps(self, taps):
         self.pfb.set_taps(taps)
 
@@ -411,6 +411,48 @@ class test_agc (gr_unittest.TestCase):
         self.assertComplexTuplesAlmostEqual (expected_result, dst_data, 4)
 
 
+    def test_006(self):
+        ''' Test the complex AGC loop updating its gain per block '''
+        tb = self.tb
+
+        sampling_freq = 100
+        src1 = gr.sig_source_c (sampling_freq, gr.GR_SIN_WAVE,
+                                sampling_freq * 0.10, 100.0)
+        head = gr.head (gr.sizeof_gr_complex, 2000)
+        agc1 = gr.agc_cc(1e-3, 1, 1, 1000)
+        agc2 = gr.agc_cc(1e-3, 1, 1, 1000)
+        agc2.set_block_size(32)
+        self.assertEqual(32, agc2.block_size())
+        dst1 = gr.vector_sink_c ()
+        dst2 = gr.vector_sink_c ()
+
+        tb.connect (src1, head)
+        tb.connect (head, agc1, dst1)
+        tb.connect (head, agc2, dst2)
+        tb.run ()
+
+        # both settle on the reference magnitude
+        for x in dst1.data()[-100:] + dst2.data()[-100:]:
+            self.assertAlmostEqual (1.0, abs(x), 4)
+
+    def test_007(self):
+        ''' Test the float AGC2 loop updating its gain per block '''
+        tb = self.tb
+
+        sampling_freq = 100
+        src1 = gr.sig_source_f (sampling_freq, gr.GR_SQR_WAVE,
+                                sampling_freq * 0.10, 10.0, -5.0)
+        head = gr.head (gr.sizeof_float, 2000)
+        agc = gr.agc2_ff(1e-1, 1e-2, 1.0, 1.0, 1000)
+        agc.set_block_size(64)
+        dst1 = gr.vector_sink_f ()
+
+        tb.connect (src1, head, agc, dst1)
+        tb.run ()
+
+        for x in dst1.data()[-100:]:
+            self.assertAlmostEqual (1.0, abs(x), 4)
+
     def test_100(self):        # FIXME needs work
         ''' Test complex feedforward agc with constant input '''
         input_data = 16*(0.0,) + 64*(1.0,) + 64*(0.0,)
@@ -21,6 +21,7 @@
 #
 
 from gnuradio import gr, gr_unittest
+import time
 
 class test_copy(gr_unittest.TestCase):
 
@@ -53,6 +54,83 @@ class test_copy(gr_unittest.TestCase):
         dst_data = dst.data()
         self.assertEqual(expected_result, dst_data)
 
+    def test_copy_chain (self):
+        # copy, skiphead and keep_one_in_n write in place into the
+        # buffer of the block upstream
+        src_data = range(100000)
+        expected_result = tuple(src_data[1000:90000])
+        src = gr.vector_source_i(src_data)
+        head = gr.head(gr.sizeof_int, 90000)
+        op = gr.copy(gr.sizeof_int)
+        skip = gr.skiphead(gr.sizeof_int, 1000)
+        keep = gr.keep_one_in_n(gr.sizeof_int, 1)
+        dst = gr.vector_sink_i()
+        self.tb.connect(src, head, op, skip, keep, dst)
+        self.tb.run()
+        self.assertEqual(expected_result, dst.data())
+
+    def test_copy_chain_drop (self):
+        src_data = range(50000)
+        expected_sum = tuple([sum(src_data[max(i-2, 7):i+1]) for i in range(7, 50000)])
+        expected_keep = tuple(src_data[9::3])
+        src = gr.vector_source_i(src_data)
+        skip = gr.skiphead(gr.sizeof_int, 7)
+        avg = gr.moving_average_ii(3, 1)
+        keep = gr.keep_one_in_n(gr.sizeof_int, 3)
+        dst1 = gr.vector_sink_i()
+        dst2 = gr.vector_sink_i()
+        self.tb.connect(src, skip, avg, dst1)
+        self.tb.connect(skip, keep, dst2)
+        self.tb.run()
+        self.assertEqual(expected_sum, dst1.data())
+        self.assertEqual(expected_keep, dst2.data())
+
+    def test_copy_chain_drop_history (self):
+        # A reader with history always stays behind the aliased output.
+        # Dropping far more items than the buffer holds must not stall.
+        src_data = [float(x % 1000) for x in range(300000)]
+        skipped = src_data[100000:]
+        kept = src_data[4::5]
+        expected_skip = tuple([sum(skipped[max(i-2, 0):i+1]) for i in range(len(skipped))])
+        expected_keep = tuple([sum(kept[max(i-2, 0):i+1]) for i in range(len(kept))])
+        src1 = gr.vector_source_f(src_data)
+        src2 = gr.vector_source_f(src_data)
+        skip = gr.skiphead(gr.sizeof_float, 100000)
+        keep = gr.keep_one_in_n(gr.sizeof_float, 5)
+        fir1 = gr.fir_filter_fff(1, (1, 1, 1))
+        fir2 = gr.fir_filter_fff(1, (1, 1, 1))
+        dst1 = gr.vector_sink_f()
+        dst2 = gr.vector_sink_f()
+        self.tb.connect(src1, skip, fir1, dst1)
+        self.tb.connect(src2, keep, fir2, dst2)
+        self.tb.run()
+        self.assertFloatTuplesAlmostEqual(expected_skip, dst1.data())
+        self.assertFloatTuplesAlmostEqual(expected_keep, dst2.data())
+
+    def test_copy_chain_reconnect (self):
+        # Feeding an aliased chain from a new source gives every block
+        # in it fresh buffers, whatever order the blocks are kept in.
+        src_data = [float(x) for x in range(1, 100001)]
+        src1 = gr.null_source(gr.sizeof_float)
+        thr = gr.throttle(gr.sizeof_float, 1e6)
+        src2 = gr.vector_source_f(src_data)
+        ops = [gr.copy(gr.sizeof_float) for i in range(6)]
+        ops.reverse()
+        dst = gr.vector_sink_f()
+        self.tb.connect(src1, thr, *ops)
+        self.tb.connect(ops[-1], dst)
+        self.tb.start()
+        time.sleep(0.02)
+        self.tb.lock()
+        self.tb.disconnect(src1, thr, ops[0])
+        self.tb.connect(src2, ops[0])
+        self.tb.unlock()
+        self.tb.wait()
+        dst_data = dst.data()
+        n = len(dst_data) - len(src_data)
+        self.assertEqual(tuple(src_data), dst_data[n:])
+        self.assertEqual((0.0,) * n, dst_data[:n])
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_copy, "test_copy.xml")
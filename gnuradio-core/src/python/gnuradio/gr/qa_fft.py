@@ -22,6 +22,8 @@
 from gnuradio import gr, gr_unittest
 import sys
 import random
+import cmath
+import math
 
 primes = (2,3,5,7,11,13,17,19,23,29,31,37,41,43,47,53,
           59,61,67,71,73,79,83,89,97,101,103,107,109,113,127,131,
@@ -207,6 +209,83 @@ class test_fft(gr_unittest.TestCase):
         result_data = dst.data()
         self.assert_fft_ok2(expected_result, result_data)
 
+    def test_004(self):
+        # Enough vectors for the batched transforms, with a window and
+        # fftshift applied
+
+	tb = gr.top_block()
+        fft_size = 64
+        nvecs = 100
+
+        random.seed(0)
+        src_data = tuple([complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                          for i in range(fft_size*nvecs)])
+        window = [0.5 + 0.5*math.cos(2*math.pi*(i - fft_size/2)/fft_size)
+                  for i in range(fft_size)]
+        twiddle = [cmath.exp(-2j*cmath.pi*k/fft_size) for k in range(fft_size)]
+
+        expected_result = []
+        for v in range(nvecs):
+            x = [src_data[v*fft_size + n] * window[n] for n in range(fft_size)]
+            X = [sum([x[n] * twiddle[(k*n) % fft_size] for n in range(fft_size)])
+                 for k in range(fft_size)]
+            expected_result += X[fft_size/2:] + X[:fft_size/2]
+
+        src = gr.vector_source_c(src_data)
+        s2v = gr.stream_to_vector(gr.sizeof_gr_complex, fft_size)
+        fft = gr.fft_vcc(fft_size, True, window, True)
+        v2s = gr.vector_to_stream(gr.sizeof_gr_complex, fft_size)
+        dst = gr.vector_sink_c()
+        tb.connect(src, s2v, fft, v2s, dst)
+        tb.run()
+        result_data = dst.data()
+        self.assertComplexTuplesAlmostEqual2 (expected_result, result_data,
+                                              abs_eps=1e-4, rel_eps=1e-4)
+
+    def test_005(self):
+        # 48 byte vectors, so the scheduler's buffers are 16 but not
+        # always 32 byte aligned, as SIMD FFTW plans may need.  The
+        # skiphead starts the transforms one vector into the buffer.
+
+        fft_size = 6
+        nvecs = 101
+
+        random.seed(0)
+        src_data = tuple([complex(random.uniform(-1, 1), random.uniform(-1, 1))
+                          for i in range(fft_size*nvecs)])
+        real_data = tuple([x.real for x in src_data])
+        twiddle = [cmath.exp(-2j*cmath.pi*k/fft_size) for k in range(fft_size)]
+
+        expected_c = []
+        expected_f = []
+        for v in range(1, nvecs):
+            x = src_data[v*fft_size:(v+1)*fft_size]
+            expected_c += [sum([x[n] * twiddle[(k*n) % fft_size] for n in range(fft_size)])
+                           for k in range(fft_size)]
+            expected_f += [sum([x[n].real * twiddle[(k*n) % fft_size] for n in range(fft_size)])
+                           for k in range(fft_size)]
+
+        tb = gr.top_block()
+        src_c = gr.vector_source_c(src_data)
+        s2v_c = gr.stream_to_vector(gr.sizeof_gr_complex, fft_size)
+        skip_c = gr.skiphead(gr.sizeof_gr_complex*fft_size, 1)
+        fft_c = gr.fft_vcc(fft_size, True, [], False)
+        v2s_c = gr.vector_to_stream(gr.sizeof_gr_complex, fft_size)
+        dst_c = gr.vector_sink_c()
+        src_f = gr.vector_source_f(real_data)
+        s2v_f = gr.stream_to_vector(gr.sizeof_float, fft_size)
+        skip_f = gr.skiphead(gr.sizeof_float*fft_size, 1)
+        fft_f = gr.fft_vfc(fft_size, True, [])
+        v2s_f = gr.vector_to_stream(gr.sizeof_gr_complex, fft_size)
+        dst_f = gr.vector_sink_c()
+        tb.connect(src_c, s2v_c, skip_c, fft_c, v2s_c, dst_c)
+        tb.connect(src_f, s2v_f, skip_f, fft_f, v2s_f, dst_f)
+        tb.run()
+        self.assertComplexTuplesAlmostEqual2 (expected_c, dst_c.data(),
+                                              abs_eps=1e-4, rel_eps=1e-4)
+        self.assertComplexTuplesAlmostEqual2 (expected_f, dst_f.data(),
+                                              abs_eps=1e-4, rel_eps=1e-4)
+
 if __name__ == '__main__':
     gr_unittest.run(test_fft, "test_fft.xml")
 
@@ -151,6 +151,54 @@ class test_iir (gr_unittest.TestCase):
         result_data = dst.data ()
         self.assertFloatTuplesAlmostEqual (expected_result, result_data)
 
+    def test_iir_sos_001 (self):
+        src_data = (1, 2, 3, 4, 5, 6, 7, 8)
+        fftaps = (2, 11)
+        fbtaps = (0,  -1)
+        expected_result = (2, 13, 15, 26, 28, 39, 41, 52)
+        src = gr.vector_source_f (src_data)
+        op = gr.iir_sos_filter_ffd (fftaps, fbtaps)
+        dst = gr.vector_sink_f ()
+        self.tb.connect (src, op)
+        self.tb.connect (op, dst)
+        self.tb.run ()
+        result_data = dst.data ()
+        self.assertFloatTuplesAlmostEqual (expected_result, result_data, 4)
+
+    def test_iir_sos_002 (self):
+        src_data = [float(i % 7) for i in range(100)]
+        fftaps = (0.0675, 0.1349, 0.0675)
+        fbtaps = (0, 1.143, -0.4128)
+        sos = gr.iir_tf2sos (fftaps, fbtaps)
+        self.assertEqual (5, len(sos))
+        src = gr.vector_source_f (src_data)
+        op0 = gr.iir_filter_ffd (fftaps, fbtaps)
+        op1 = gr.iir_sos_filter_ffd (fftaps, fbtaps)
+        dst0 = gr.vector_sink_f ()
+        dst1 = gr.vector_sink_f ()
+        self.tb.connect (src, op0, dst0)
+        self.tb.connect (src, op1, dst1)
+        self.tb.run ()
+        self.assertFloatTuplesAlmostEqual (dst0.data (), dst1.data (), 4)
+
+    def test_iir_sos_mc_001 (self):
+        src_data0 = (1, 2, 3, 4, 5, 6, 7, 8)
+        src_data1 = (8, 7, 6, 5, 4, 3, 2, 1)
+        fftaps = (2, 11)
+        fbtaps = (0,  -1)
+        expected_result0 = (2, 13, 15, 26, 28, 39, 41, 52)
+        expected_result1 = (16, 86, 3, 73, -10, 60, -23, 47)
+        src0 = gr.vector_source_f (src_data0)
+        src1 = gr.vector_source_f (src_data1)
+        op = gr.iir_sos_filter_mc_ffd (fftaps, fbtaps)
+        dst0 = gr.vector_sink_f ()
+        dst1 = gr.vector_sink_f ()
+        self.tb.connect (src0, (op, 0), dst0)
+        self.tb.connect (src1, (op, 1), dst1)
+        self.tb.run ()
+        self.assertFloatTuplesAlmostEqual (expected_result0, dst0.data (), 4)
+        self.assertFloatTuplesAlmostEqual (expected_result1, dst1.data (), 4)
+
 
 
 
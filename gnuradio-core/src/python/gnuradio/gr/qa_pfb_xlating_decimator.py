@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+#
+# Copyright 2012 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+import cmath, math, random
+
+def make_random_complex_tuple(L):
+    result = []
+    for x in range(L):
+        result.append(complex(random.uniform(-1,1),
+                              random.uniform(-1,1)))
+    return tuple(result)
+
+def reference_xlating_filter(dec, taps, fc, fs, input):
+    """
+    mix fc down to zero Hz, then use a conventional decimating fir filter
+    """
+    w = -2*math.pi*fc/fs
+    mixed = [x*cmath.exp(complex(0, w*n)) for (n, x) in enumerate(input)]
+    tb = gr.top_block()
+    src = gr.vector_source_c(mixed)
+    op = gr.fir_filter_ccf(dec, taps)
+    dst = gr.vector_sink_c()
+    tb.connect(src, op, dst)
+    tb.run()
+    return dst.data()
+
+class test_pfb_xlating_decimator(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_000(self):
+        fs = 32000.0
+        taps = gr.firdes.low_pass(1, fs, 1500, 500)
+        src_data = make_random_complex_tuple(4000)
+
+        for (decim, fc) in ((1, 0), (4, 3000), (8, -5200), (13, 7777)):
+            expected_result = reference_xlating_filter(decim, taps, fc, fs, src_data)
+
+            src = gr.vector_source_c(src_data)
+            op = gr.pfb_xlating_decimator_ccf(decim, taps, fc, fs)
+            dst = gr.vector_sink_c()
+            self.tb = gr.top_block()
+            self.tb.connect(src, op, dst)
+            self.tb.run()
+            result_data = dst.data()
+
+            self.assertEqual(len(expected_result), len(result_data))
+            self.assertComplexTuplesAlmostEqual(expected_result, result_data, 4)
+
+    def test_001_retune(self):
+        fs = 32000.0
+        taps = gr.firdes.low_pass(1, fs, 1500, 500)
+        op = gr.pfb_xlating_decimator_ccf(8, taps, 1000, fs)
+        op.set_center_freq(-2000)
+        self.assertEqual(-2000, op.center_freq())
+        op.set_taps(taps[:len(taps)/2])
+        self.assertEqual(8, len(op.taps()))
+
+if __name__ == '__main__':
+    gr_unittest.run(test_pfb_xlating_decimator, "test_pfb_xlating_decimator.xml")
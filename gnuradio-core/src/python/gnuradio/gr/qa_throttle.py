@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+#
+# Copyright 2012 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+import time
+
+class test_throttle (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_throttle_data (self):
+        src_data = range(10000)
+        src = gr.vector_source_i (src_data)
+        op = gr.throttle (gr.sizeof_int, 1e6)
+        op.set_tag_time (True)
+        dst = gr.vector_sink_i ()
+        self.tb.connect (src, op, dst)
+        self.tb.run ()
+        self.assertEqual (tuple(src_data), dst.data ())
+
+    def test_throttle_burst (self):
+        src_data = range(20000)
+        src = gr.vector_source_i (src_data)
+        op = gr.throttle (gr.sizeof_int, 100e3)
+        op.set_max_burst (1000)
+        op.set_spin_time (100e-6)
+        dst = gr.vector_sink_i ()
+        self.tb.connect (src, op, dst)
+        start = time.time ()
+        self.tb.run ()
+        elapsed = time.time () - start
+        self.assertEqual (tuple(src_data), dst.data ())
+        # no more than one burst may go out ahead of schedule
+        self.assertTrue (elapsed >= 0.95 * (len(src_data) - 1000) / 100e3)
+        self.assertEqual (100e3, op.sample_rate ())
+
+
+if __name__ == '__main__':
+    gr_unittest.run(test_throttle, "test_throttle.xml")
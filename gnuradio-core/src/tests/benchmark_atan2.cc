@@ -0,0 +1,172 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+#include <unistd.h>
+#include <math.h>
+#include <gr_complex.h>
+#include <gr_math.h>
+#include <volk/volk.h>
+#include <string.h>
+#include <algorithm>
+
+#define ITERATIONS	20000000
+#define BLOCK_SIZE	(10 * 1000)	// fits in cache
+
+static gr_complex input[BLOCK_SIZE + 1];
+
+static double
+timeval_to_double (const struct timeval *tv)
+{
+  return (double) tv->tv_sec + (double) tv->tv_usec * 1e-6;
+}
+
+
+static void
+benchmark (void test (float *x), const char *implementation_name)
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage_start;
+  struct rusage	rusage_stop;
+#else
+  double clock_start;
+  double clock_end;
+#endif
+  float output[BLOCK_SIZE];
+
+  // touch memory
+  memset(output, 0, BLOCK_SIZE*sizeof(float));
+
+  // get starting CPU usage
+#ifdef HAVE_SYS_RESOURCE_H
+  if (getrusage (RUSAGE_SELF, &rusage_start) < 0){
+    perror ("getrusage");
+    exit (1);
+  }
+#else
+  clock_start = (double) clock() * (1000000. / CLOCKS_PER_SEC);
+#endif
+  // do the actual work
+
+  test (output);
+
+  // get ending CPU usage
+
+#ifdef HAVE_SYS_RESOURCE_H
+  if (getrusage (RUSAGE_SELF, &rusage_stop) < 0){
+    perror ("getrusage");
+    exit (1);
+  }
+
+  // compute results
+
+  double user =
+    timeval_to_double (&rusage_stop.ru_utime)
+    - timeval_to_double (&rusage_start.ru_utime);
+
+  double sys =
+    timeval_to_double (&rusage_stop.ru_stime)
+    - timeval_to_double (&rusage_start.ru_stime);
+
+  double total = user + sys;
+#else
+  clock_end = (double) clock () * (1000000. / CLOCKS_PER_SEC);
+  double total = clock_end - clock_start;
+#endif
+
+  // worst error against double precision atan2 over the last block
+  double max_error = 0;
+  for (int j = 0; j < BLOCK_SIZE; j++){
+    double expected = atan2 ((double) input[j+1].imag(), (double) input[j+1].real());
+    if (strstr (implementation_name, "demod")){
+      gr_complex p = input[j+1] * conj (input[j]);
+      expected = atan2 ((double) p.imag(), (double) p.real());
+    }
+    max_error = std::max (max_error, fabs (output[j] - expected));
+  }
+
+  printf ("%24s:  cpu: %6.3f  steps/sec: %10.3e  max error: %8.2e\n",
+	  implementation_name, total, ITERATIONS / total, max_error);
+}
+
+// ----------------------------------------------------------------
+
+void native_atan2 (float *x)
+{
+  for (int i = 0; i < ITERATIONS/BLOCK_SIZE; i++){
+    for (int j = 0; j < BLOCK_SIZE; j++)
+      x[j] = atan2f (input[j+1].imag(), input[j+1].real());
+  }
+}
+
+void fast_atan2 (float *x)
+{
+  for (int i = 0; i < ITERATIONS/BLOCK_SIZE; i++){
+    for (int j = 0; j < BLOCK_SIZE; j++)
+      x[j] = gr_fast_atan2f (input[j+1]);
+  }
+}
+
+void volk_atan2 (float *x)
+{
+  for (int i = 0; i < ITERATIONS/BLOCK_SIZE; i++)
+    volk_32fc_s32f_atan2_32f_u (x, &input[1], 1.0, BLOCK_SIZE);
+}
+
+// ----------------------------------------------------------------
+
+void fast_quad_demod (float *x)
+{
+  for (int i = 0; i < ITERATIONS/BLOCK_SIZE; i++){
+    for (int j = 0; j < BLOCK_SIZE; j++){
+      gr_complex product = input[j+1] * conj (input[j]);
+      x[j] = gr_fast_atan2f (imag(product), real(product));
+    }
+  }
+}
+
+void volk_quad_demod (float *x)
+{
+  for (int i = 0; i < ITERATIONS/BLOCK_SIZE; i++)
+    volk_32fc_x2_s32f_quad_demod_32f_u (x, &input[1], &input[0], 1.0, BLOCK_SIZE);
+}
+
+int
+main (int argc, char **argv)
+{
+  for (int j = 0; j < BLOCK_SIZE + 1; j++)
+    input[j] = gr_complex (2.0 * random () / RAND_MAX - 1.0,
+			   2.0 * random () / RAND_MAX - 1.0);
+
+  benchmark (native_atan2, "native atan2");
+  benchmark (fast_atan2, "gr_fast_atan2f");
+  benchmark (volk_atan2, "volk atan2");
+  benchmark (fast_quad_demod, "gr_fast_atan2f demod");
+  benchmark (volk_quad_demod, "volk quad demod");
+}
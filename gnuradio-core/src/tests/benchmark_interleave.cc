@@ -0,0 +1,168 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+#include <unistd.h>
+#include <time.h>
+#include <gri_interleave.h>
+#include <string.h>
+
+#define TOTAL_BYTES	(1024 * 1024 * 1024)
+#define BLOCK_BYTES	(64 * 1024)	// fits in cache
+#define MAX_STREAMS	8
+
+static char input[BLOCK_BYTES];
+static char output[BLOCK_BYTES];
+
+typedef void (*test_fct) (size_t itemsize, int nstreams);
+
+static double
+timeval_to_double (const struct timeval *tv)
+{
+  return (double) tv->tv_sec + (double) tv->tv_usec * 1e-6;
+}
+
+static double
+cpu_time ()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if (getrusage (RUSAGE_SELF, &rusage) < 0){
+    perror ("getrusage");
+    exit (1);
+  }
+  return timeval_to_double (&rusage.ru_utime) + timeval_to_double (&rusage.ru_stime);
+#else
+  return (double) clock () / CLOCKS_PER_SEC;
+#endif
+}
+
+static double
+benchmark (test_fct test, size_t itemsize, int nstreams)
+{
+  double start = cpu_time ();
+  test (itemsize, nstreams);
+  return cpu_time () - start;
+}
+
+// ----------------------------------------------------------------
+// The per-item loops the stream (de)interleaving blocks used to run.
+
+void memcpy_deinterleave (size_t itemsize, int nstreams)
+{
+  int nitems = BLOCK_BYTES / itemsize / nstreams;
+  for (int b = 0; b < TOTAL_BYTES / BLOCK_BYTES; b++){
+    const char *in = input;
+    char *outv[MAX_STREAMS];
+    for (int j = 0; j < nstreams; j++)
+      outv[j] = &output[j * nitems * itemsize];
+
+    for (int i = 0; i < nitems; i++){
+      for (int j = 0; j < nstreams; j++){
+	memcpy(outv[j], in, itemsize);
+	outv[j] += itemsize;
+	in += itemsize;
+      }
+    }
+  }
+}
+
+void memcpy_interleave (size_t itemsize, int nstreams)
+{
+  int nitems = BLOCK_BYTES / itemsize / nstreams;
+  for (int b = 0; b < TOTAL_BYTES / BLOCK_BYTES; b++){
+    const char *inv[MAX_STREAMS];
+    char *out = output;
+    for (int j = 0; j < nstreams; j++)
+      inv[j] = &input[j * nitems * itemsize];
+
+    for (int i = 0; i < nitems; i++){
+      for (int j = 0; j < nstreams; j++){
+	memcpy(out, inv[j], itemsize);
+	out += itemsize;
+	inv[j] += itemsize;
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------
+
+void engine_deinterleave (size_t itemsize, int nstreams)
+{
+  int nitems = BLOCK_BYTES / itemsize / nstreams;
+  void *outv[MAX_STREAMS];
+  for (int j = 0; j < nstreams; j++)
+    outv[j] = &output[j * nitems * itemsize];
+
+  for (int b = 0; b < TOTAL_BYTES / BLOCK_BYTES; b++)
+    gri_deinterleave (outv, input, nstreams, itemsize, nitems);
+}
+
+void engine_interleave (size_t itemsize, int nstreams)
+{
+  int nitems = BLOCK_BYTES / itemsize / nstreams;
+  const void *inv[MAX_STREAMS];
+  for (int j = 0; j < nstreams; j++)
+    inv[j] = &input[j * nitems * itemsize];
+
+  for (int b = 0; b < TOTAL_BYTES / BLOCK_BYTES; b++)
+    gri_interleave (output, inv, nstreams, itemsize, nitems);
+}
+
+int
+main (int argc, char **argv)
+{
+  static const size_t itemsizes[] = { 1, 2, 4, 8, 16 };
+  static const int stream_counts[] = { 2, 3, 4, 8 };
+
+  for (int i = 0; i < BLOCK_BYTES; i++)
+    input[i] = random ();
+
+  printf ("%8s %8s  %16s %16s  %16s %16s\n", "itemsize", "nstreams",
+	  "memcpy deint", "gri_deinterleave", "memcpy int", "gri_interleave");
+
+  for (size_t s = 0; s < sizeof (itemsizes) / sizeof (itemsizes[0]); s++){
+    for (size_t c = 0; c < sizeof (stream_counts) / sizeof (stream_counts[0]); c++){
+      size_t itemsize = itemsizes[s];
+      int nstreams = stream_counts[c];
+      double t[4];
+      t[0] = benchmark (memcpy_deinterleave, itemsize, nstreams);
+      t[1] = benchmark (engine_deinterleave, itemsize, nstreams);
+      t[2] = benchmark (memcpy_interleave, itemsize, nstreams);
+      t[3] = benchmark (engine_interleave, itemsize, nstreams);
+
+      // throughput in MB/s of interleaved data
+      printf ("%8d %8d ", (int) itemsize, nstreams);
+      for (int k = 0; k < 4; k++)
+	printf (" %11.1f MB/s", TOTAL_BYTES / t[k] * 1e-6);
+      printf ("\n");
+    }
+  }
+}
@@ -0,0 +1,128 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+#include <unistd.h>
+#include <time.h>
+#include <math.h>
+#include <string.h>
+#include <gri_viterbi_27.h>
+
+extern "C" {
+#include <viterbi.h>
+}
+
+#define TOTAL_BITS	(64 * 1024 * 1024)
+#define BLOCK_BITS	(32 * 1024)	// fits in cache
+
+static unsigned char symbols[2 * BLOCK_BITS];
+static unsigned char output[BLOCK_BITS / 8];
+static int mettab[2][256];
+
+typedef void (*test_fct) ();
+
+static double
+timeval_to_double (const struct timeval *tv)
+{
+  return (double) tv->tv_sec + (double) tv->tv_usec * 1e-6;
+}
+
+static double
+cpu_time ()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if (getrusage (RUSAGE_SELF, &rusage) < 0){
+    perror ("getrusage");
+    exit (1);
+  }
+  return timeval_to_double (&rusage.ru_utime) + timeval_to_double (&rusage.ru_stime);
+#else
+  return (double) clock () / CLOCKS_PER_SEC;
+#endif
+}
+
+static double
+benchmark (test_fct test)
+{
+  double start = cpu_time ();
+  test ();
+  return cpu_time () - start;
+}
+
+// ----------------------------------------------------------------
+// What gr_decode_ccsds_27_fb used to do: a butterfly every four
+// symbols and a byte out every sixteen.
+
+void butterfly2_decode ()
+{
+  struct viterbi_state state0[64], state1[64];
+  viterbi_chunks_init (state0);
+
+  for (int b = 0; b < TOTAL_BITS / BLOCK_BITS; b++){
+    unsigned char *out = output;
+    for (int i = 0; i < 2 * BLOCK_BITS; i += 4){
+      viterbi_butterfly2 (&symbols[i], mettab, state0, state1);
+      if (i % 16 == 8)
+	viterbi_get_output (state0, out++);
+    }
+  }
+}
+
+// ----------------------------------------------------------------
+
+void engine_decode ()
+{
+  gri_viterbi_27 v (mettab);
+
+  for (int b = 0; b < TOTAL_BITS / BLOCK_BITS; b++)
+    v.decode (symbols, BLOCK_BITS, output);
+}
+
+int
+main (int argc, char **argv)
+{
+  float esn0 = 0.5 * pow (10.0, 12.0/10.0);
+  gen_met (mettab, 100, esn0, 0.0, 256);
+
+  // random data through the encoder, with some noise
+  static unsigned char data[BLOCK_BITS / 8];
+  for (int i = 0; i < BLOCK_BITS / 8; i++)
+    data[i] = random ();
+  encode (symbols, data, BLOCK_BITS / 8, 0);
+  for (int i = 0; i < 2 * BLOCK_BITS; i++)
+    symbols[i] = symbols[i] ? 228 - random () % 80 : 28 + random () % 80;
+
+  double t0 = benchmark (butterfly2_decode);
+  double t1 = benchmark (engine_decode);
+
+  printf ("%16s %8.2f Mbit/s\n", "butterfly2", TOTAL_BITS / t0 * 1e-6);
+  printf ("%16s %8.2f Mbit/s\n", "gri_viterbi_27", TOTAL_BITS / t1 * 1e-6);
+}
@@ -27,6 +27,7 @@
 #include <atsc_rs_decoder.h>
 #include <gr_io_signature.h>
 #include <atsc_consts.h>
+#include <algorithm>
 
 
 atsc_rs_decoder_sptr
@@ -51,12 +52,19 @@ atsc_rs_decoder::work (int noutput_items,
   const atsc_mpeg_packet_rs_encoded *in = (const atsc_mpeg_packet_rs_encoded *) input_items[0];
   atsc_mpeg_packet_no_sync *out = (atsc_mpeg_packet_no_sync *) output_items[0];
 
-  for (int i = 0; i < noutput_items; i++){
-    assert(in[i].pli.regular_seg_p());
-    out[i].pli = in[i].pli;			// copy pipeline info...
+  static const int CHUNK = 64;
+  int nerrors_corrected[CHUNK];
 
-    int nerrors_corrrected = d_rs_decoder.decode(out[i], in[i]);
-    out[i].pli.set_transport_error(nerrors_corrrected == -1);
+  for (int base = 0; base < noutput_items; base += CHUNK){
+    int n = std::min(CHUNK, noutput_items - base);
+
+    d_rs_decoder.decode(&out[base], &in[base], nerrors_corrected, n);
+
+    for (int i = 0; i < n; i++){
+      assert(in[base + i].pli.regular_seg_p());
+      out[base + i].pli = in[base + i].pli;	// copy pipeline info...
+      out[base + i].pli.set_transport_error(nerrors_corrected[i] == -1);
+    }
   }
 
   return noutput_items;
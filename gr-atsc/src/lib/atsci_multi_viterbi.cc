@@ -0,0 +1,174 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <atsci_multi_viterbi.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+atsci_multi_viterbi::atsci_multi_viterbi ()
+{
+  reset ();
+}
+
+void
+atsci_multi_viterbi::reset ()
+{
+  memset (path_metrics, 0, sizeof (path_metrics));
+  memset (traceback_lo, 0, sizeof (traceback_lo));
+  memset (traceback_hi, 0, sizeof (traceback_hi));
+  phase = 0;
+}
+
+#ifdef __SSE2__
+
+static inline __m128i
+select (__m128 mask, __m128i a, __m128i b)	// mask ? a : b
+{
+  __m128i m = _mm_castps_si128 (mask);
+  return _mm_or_si128 (_mm_and_si128 (m, a), _mm_andnot_si128 (m, b));
+}
+
+void
+atsci_multi_viterbi::decode (char out[NDECODERS], const float input[NDECODERS])
+{
+  const int *transition_table = atsci_single_viterbi::transition_table;
+  const float *was_sent = atsci_single_viterbi::was_sent;
+  const __m128 abs_mask = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff));
+  const __m128 renorm_limit = _mm_set1_ps (10000);
+
+  float (*pm)[NDECODERS] = path_metrics[phase];
+  float (*pm_new)[NDECODERS] = path_metrics[phase^1];
+  unsigned int (*lo)[NDECODERS] = traceback_lo[phase];
+  unsigned int (*lo_new)[NDECODERS] = traceback_lo[phase^1];
+  unsigned int (*hi)[NDECODERS] = traceback_hi[phase];
+  unsigned int (*hi_new)[NDECODERS] = traceback_hi[phase^1];
+
+  for (int d = 0; d < NDECODERS; d += 4) {
+    __m128 in = _mm_loadu_ps (&input[d]);
+
+    for (unsigned int next_state = 0; next_state < 8; next_state++) {
+      unsigned int index = next_state << 2;
+      int prev = transition_table[index];
+      __m128 min_metric =
+	_mm_add_ps (_mm_and_ps (_mm_sub_ps (in, _mm_set1_ps (was_sent[index])), abs_mask),
+		    _mm_loadu_ps (&pm[prev][d]));
+      __m128i min_metric_symb = _mm_setzero_si128 ();
+      __m128i tb_lo = _mm_loadu_si128 ((const __m128i *) &lo[prev][d]);
+      __m128i tb_hi = _mm_loadu_si128 ((const __m128i *) &hi[prev][d]);
+
+      for (unsigned int symbol_sent = 1; symbol_sent < 4; symbol_sent++) {
+	prev = transition_table[index + symbol_sent];
+	__m128 metric =
+	  _mm_add_ps (_mm_and_ps (_mm_sub_ps (in, _mm_set1_ps (was_sent[index + symbol_sent])), abs_mask),
+		      _mm_loadu_ps (&pm[prev][d]));
+	__m128 better = _mm_cmplt_ps (metric, min_metric);
+	min_metric = _mm_min_ps (metric, min_metric);
+	min_metric_symb = select (better, _mm_set1_epi32 (symbol_sent), min_metric_symb);
+	tb_lo = select (better, _mm_loadu_si128 ((const __m128i *) &lo[prev][d]), tb_lo);
+	tb_hi = select (better, _mm_loadu_si128 ((const __m128i *) &hi[prev][d]), tb_hi);
+      }
+
+      // traceback = (symb << 62) | (traceback >> 2), in 32 bit halves
+      _mm_storeu_ps (&pm_new[next_state][d], min_metric);
+      _mm_storeu_si128 ((__m128i *) &lo_new[next_state][d],
+			_mm_or_si128 (_mm_srli_epi32 (tb_lo, 2), _mm_slli_epi32 (tb_hi, 30)));
+      _mm_storeu_si128 ((__m128i *) &hi_new[next_state][d],
+			_mm_or_si128 (_mm_srli_epi32 (tb_hi, 2), _mm_slli_epi32 (min_metric_symb, 30)));
+    }
+
+    __m128 best_state_metric = _mm_loadu_ps (&pm_new[0][d]);
+    __m128i best_state = _mm_setzero_si128 ();
+    for (unsigned int state = 1; state < 8; state++) {
+      __m128 metric = _mm_loadu_ps (&pm_new[state][d]);
+      __m128 better = _mm_cmplt_ps (metric, best_state_metric);
+      best_state_metric = _mm_min_ps (metric, best_state_metric);
+      best_state = select (better, _mm_set1_epi32 (state), best_state);
+    }
+
+    // subtract the best metric from the decoders that went over the limit
+    __m128 renorm = _mm_and_ps (_mm_cmpgt_ps (best_state_metric, renorm_limit),
+				best_state_metric);
+    for (unsigned int state = 0; state < 8; state++)
+      _mm_storeu_ps (&pm_new[state][d],
+		     _mm_sub_ps (_mm_loadu_ps (&pm_new[state][d]), renorm));
+
+    int best[4];
+    _mm_storeu_si128 ((__m128i *) best, best_state);
+    for (int i = 0; i < 4; i++)
+      out[d + i] = 0x3 & lo_new[best[i]][d + i];
+  }
+  phase ^= 1;
+}
+
+#else
+
+void
+atsci_multi_viterbi::decode (char out[NDECODERS], const float input[NDECODERS])
+{
+  const int *transition_table = atsci_single_viterbi::transition_table;
+  const float *was_sent = atsci_single_viterbi::was_sent;
+
+  for (int d = 0; d < NDECODERS; d++) {
+    for (unsigned int next_state = 0; next_state < 8; next_state++) {
+      unsigned int index = next_state << 2;
+      int min_metric_symb = 0;
+      int prev = transition_table[index];
+      float min_metric = fabsf (input[d] - was_sent[index]) + path_metrics[phase][prev][d];
+
+      for (unsigned int symbol_sent = 1; symbol_sent < 4; symbol_sent++) {
+	int p = transition_table[index + symbol_sent];
+	float metric = fabsf (input[d] - was_sent[index + symbol_sent]) + path_metrics[phase][p][d];
+	if (metric < min_metric) {
+	  min_metric = metric;
+	  min_metric_symb = symbol_sent;
+	  prev = p;
+	}
+      }
+
+      path_metrics[phase^1][next_state][d] = min_metric;
+      traceback_lo[phase^1][next_state][d] =
+	(traceback_lo[phase][prev][d] >> 2) | (traceback_hi[phase][prev][d] << 30);
+      traceback_hi[phase^1][next_state][d] =
+	(traceback_hi[phase][prev][d] >> 2) | ((unsigned int) min_metric_symb << 30);
+    }
+
+    unsigned int best_state = 0;
+    float best_state_metric = path_metrics[phase^1][0][d];
+    for (unsigned int state = 1; state < 8; state++)
+      if (path_metrics[phase^1][state][d] < best_state_metric) {
+	best_state = state;
+	best_state_metric = path_metrics[phase^1][state][d];
+      }
+    if (best_state_metric > 10000)
+      for (unsigned int state = 0; state < 8; state++)
+	path_metrics[phase^1][state][d] -= best_state_metric;
+
+    out[d] = 0x3 & traceback_lo[phase^1][best_state][d];
+  }
+  phase ^= 1;
+}
+
+#endif
@@ -0,0 +1,66 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _ATSCMULTIVITERBI_H_
+#define _ATSCMULTIVITERBI_H_
+
+#include <atsc_api.h>
+#include <atsci_single_viterbi.h>
+
+/*!
+ * \brief NDECODERS single channel viterbi decoders run in lockstep
+ *
+ * All the decoders share the same 8 state trellis, so each step is
+ * done for all of them at once, with one decoder per SIMD lane.
+ * Decoder \p i gives exactly the output of an atsci_single_viterbi
+ * fed the same inputs.
+ */
+class ATSC_API atsci_multi_viterbi
+{
+
+public:
+  static const int NDECODERS = 12;
+  static const unsigned int TB_LEN = atsci_single_viterbi::TB_LEN;
+
+  atsci_multi_viterbi ();
+
+  /*!
+   * Feed \p input[i] to decoder i and return its decoded dibit in
+   * \p out[i].  Inputs ideally take on the values +/- 1,3,5,7.
+   */
+  void decode (char out[NDECODERS], const float input[NDECODERS]);
+
+  void reset ();
+
+  //! internal delay of decoder
+  int delay () { return TB_LEN - 1; }
+
+protected:
+  // [phase][state][decoder].  The 64 bit traceback of the single
+  // decoder is kept as two 32 bit halves.
+  float path_metrics [2][8][NDECODERS];
+  unsigned int traceback_lo [2][8][NDECODERS];
+  unsigned int traceback_hi [2][8][NDECODERS];
+  unsigned char phase;
+};
+
+#endif
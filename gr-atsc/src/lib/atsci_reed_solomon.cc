@@ -23,6 +23,7 @@
 #include <atsci_reed_solomon.h>
 #include <assert.h>
 #include <string.h>
+#include <algorithm>
 
 extern "C" {
 #include "rs.h"
@@ -39,6 +40,15 @@ static const int K = N - rs_init_nroots;		// 235
 
 static const int amount_of_pad	 = N - ATSC_MPEG_RS_ENCODED_LENGTH;	  // 48
 
+static bool
+all_zero (const unsigned char *s, int n)
+{
+  for (int i = 0; i < n; i++)
+    if (s[i] != 0)
+      return false;
+  return true;
+}
+
 atsci_reed_solomon::atsci_reed_solomon ()
 {
   d_rs = init_rs_char (rs_init_symsize, rs_init_gfpoly,
@@ -75,20 +85,44 @@ atsci_reed_solomon::encode (atsc_mpeg_packet_rs_encoded &out, const atsc_mpeg_pa
 int
 atsci_reed_solomon::decode (atsc_mpeg_packet_no_sync &out, const atsc_mpeg_packet_rs_encoded &in)
 {
-  unsigned char tmp[N];
-  int		ncorrections;
-
-  assert ((int)(amount_of_pad + sizeof (in.data)) == N);
-
-  // add missing prefix zero padding to message
-  memset (tmp, 0, amount_of_pad);
-  memcpy (&tmp[amount_of_pad], in.data, sizeof (in.data));
-
-  // correct message...
-  ncorrections = decode_rs_char (d_rs, tmp, 0, 0);
-
-  // copy corrected message to output, skipping prefix zero padding
-  memcpy (out.data, &tmp[amount_of_pad], sizeof (out.data));
+  int	ncorrections;
 
+  decode (&out, &in, &ncorrections, 1);
   return ncorrections;
 }
+
+void
+atsci_reed_solomon::decode (atsc_mpeg_packet_no_sync out[],
+			    const atsc_mpeg_packet_rs_encoded in[],
+			    int ncorrections[], int n)
+{
+  static const int CHUNK = 64;
+  unsigned char	syndromes[CHUNK * rs_init_nroots];
+  unsigned char tmp[ATSC_MPEG_RS_ENCODED_LENGTH];
+
+  assert ((int)(amount_of_pad + sizeof (in[0].data)) == N);
+
+  for (int base = 0; base < n; base += CHUNK){
+    int nblocks = std::min (CHUNK, n - base);
+
+    // The prefix zero padding doesn't change the syndromes, so they're
+    // computed straight from the packets.
+    int nerrors = syndromes_rs_char (d_rs, in[base].data, sizeof (in[0].data),
+				     sizeof (in[0]), nblocks, syndromes);
+
+    for (int i = base; i < base + nblocks; i++){
+      const unsigned char *s = &syndromes[(i - base) * rs_init_nroots];
+
+      if (nerrors == 0 || all_zero (s, rs_init_nroots)){
+	memcpy (out[i].data, in[i].data, sizeof (out[i].data));
+	ncorrections[i] = 0;
+      }
+      else {
+	// correct message...
+	memcpy (tmp, in[i].data, sizeof (tmp));
+	ncorrections[i] = correct_rs_char (d_rs, tmp, sizeof (tmp), s, 0, 0);
+	memcpy (out[i].data, tmp, sizeof (out[i].data));
+      }
+    }
+  }
+}
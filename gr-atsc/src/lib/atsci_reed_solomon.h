@@ -50,6 +50,15 @@ class ATSC_API atsci_reed_solomon {
    */
   int decode (atsc_mpeg_packet_no_sync &out, const atsc_mpeg_packet_rs_encoded &in);
 
+  /*!
+   * Decode \p n RS encoded packets.  Packets without errors are
+   * recognized from their syndromes, which are computed for the whole
+   * batch at once, and copied straight through.
+   * \p ncorrections[i] is set as decode's return value for packet i.
+   */
+  void decode (atsc_mpeg_packet_no_sync out[], const atsc_mpeg_packet_rs_encoded in[],
+	       int ncorrections[], int n);
+
  private:
   void	*d_rs;
 };
@@ -48,6 +48,8 @@ public:
   int delay () { return TB_LEN - 1; }
 
 protected:
+  friend class atsci_multi_viterbi;
+
   static const int transition_table[32];
   static const float was_sent[32];
   float path_metrics [2][8];
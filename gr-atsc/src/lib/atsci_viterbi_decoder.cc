@@ -51,7 +51,11 @@ atsci_viterbi_decoder::atsci_viterbi_decoder ()
    */
 
   // the -4 is for the 4 sync symbols
+#if (USE_SIMPLE_SLICER)
   int	fifo_size = ATSC_DATA_SEGMENT_LENGTH - 4 - viterbi[0].delay ();
+#else
+  int	fifo_size = ATSC_DATA_SEGMENT_LENGTH - 4 - multi_viterbi.delay ();
+#endif
   for (int i = 0; i < NCODERS; i++)
     fifo[i] = new fifo_t(fifo_size);
 
@@ -68,9 +72,14 @@ void
 atsci_viterbi_decoder::reset ()
 {
   for (int i = 0; i < NCODERS; i++){
+#if (USE_SIMPLE_SLICER)
     viterbi[i].reset ();
+#endif
     fifo[i]->reset ();
   }
+#if !(USE_SIMPLE_SLICER)
+  multi_viterbi.reset ();
+#endif
 }
 
 
@@ -112,12 +121,10 @@ atsci_viterbi_decoder::decode_helper (unsigned char out[OUTPUT_SIZE],
 {
   int encoder;
   unsigned int i;
-  int dbi;
   int dbwhere;
   int dbindex;
   int shift;
   unsigned char dibit;
-  float symbol;
 
   /* Memset is not necessary if it's all working... */
   memset (out, 0, OUTPUT_SIZE);
@@ -151,6 +158,10 @@ atsci_viterbi_decoder::decode_helper (unsigned char out[OUTPUT_SIZE],
 
   // printf ("@@@ DIBITS @@@\n");
 
+#if (USE_SIMPLE_SLICER)
+  int dbi;
+  float symbol;
+
   /* Now run each of the 12 Trellis encoders over their subset of
      the input symbols */
   for (encoder = 0; encoder < NCODERS; encoder++) {
@@ -171,6 +182,29 @@ atsci_viterbi_decoder::decode_helper (unsigned char out[OUTPUT_SIZE],
 	(out[dbindex] & ~(0x03 << shift)) | (dibit << shift);
     } /* Symbols fed into one encoder */
   } /* Encoders */
+#else
+  /* Run the 12 Trellis decoders side by side: step i feeds symbol i
+     of each encoder's subset to its decoder. */
+  float	symbols[NCODERS];
+  char	decoded[NCODERS];
+
+  for (i = 0; i < enco_which_max; i++) {
+    for (encoder = 0; encoder < NCODERS; encoder++)
+      symbols[encoder] = symbols_in[enco_which_syms[encoder][i]];
+
+    multi_viterbi.decode (decoded, symbols);
+
+    for (encoder = 0; encoder < NCODERS; encoder++) {
+      dibit = fifo[encoder]->stuff (decoded[encoder]);
+      /* Store the dibit into the output data segment */
+      dbwhere = enco_which_dibits[encoder][i];
+      dbindex = dbwhere >> 3;
+      shift = dbwhere & 0x7;
+      out[dbindex] =
+	(out[dbindex] & ~(0x03 << shift)) | (dibit << shift);
+    }
+  }
+#endif
 
   // fflush (stdout);
 }
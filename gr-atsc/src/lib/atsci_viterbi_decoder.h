@@ -33,8 +33,7 @@
 #include <atsci_fake_single_viterbi.h>
 typedef atsci_fake_single_viterbi	single_viterbi_t;
 #else
-#include <atsci_single_viterbi.h>
-typedef atsci_single_viterbi		single_viterbi_t;
+#include <atsci_multi_viterbi.h>
 #endif
 
 /*!
@@ -73,8 +72,12 @@ public:
 		      const float in[INPUT_SIZE]);
 
 
-  single_viterbi_t	viterbi[NCODERS];
   fifo_t		*fifo[NCODERS];
+#if (USE_SIMPLE_SLICER)
+  single_viterbi_t	viterbi[NCODERS];
+#else
+  atsci_multi_viterbi	multi_viterbi;	// decodes all NCODERS side by side
+#endif
   bool			debug;
 
 };
@@ -35,6 +35,7 @@
 #include <qa_atsci_sliding_correlator.h>
 #include <qa_atsci_fake_single_viterbi.h>
 #include <qa_atsci_single_viterbi.h>
+#include <qa_atsci_multi_viterbi.h>
 #include <qa_atsci_trellis_encoder.h>
 #include <qa_atsci_viterbi_decoder.h>
 #include <qa_atsci_fs_correlator.h>
@@ -54,6 +55,7 @@ qa_atsc::suite ()
   s->addTest (qa_atsci_sliding_correlator::suite ());
   s->addTest (qa_atsci_fake_single_viterbi::suite ());
   s->addTest (qa_atsci_single_viterbi::suite ());
+  s->addTest (qa_atsci_multi_viterbi::suite ());
   s->addTest (qa_atsci_trellis_encoder::suite ());
   s->addTest (qa_atsci_viterbi_decoder::suite ());
   s->addTest (qa_atsci_fs_correlator::suite ());
@@ -0,0 +1,96 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cppunit/TestAssert.h>
+#include <stdlib.h>
+#include <atsci_single_viterbi.h>
+#include <atsci_multi_viterbi.h>
+#include <qa_atsci_multi_viterbi.h>
+#include <random.h>
+
+static const int NDECODERS = atsci_multi_viterbi::NDECODERS;
+static const int NN        = 20000;
+
+static float
+noise ()
+{
+  return 2.0 * ((float) random () / RANDOM_MAX - 0.5);	// uniformly (-1, 1)
+}
+
+/*
+ * Run the multi decoder and NDECODERS single decoders over the same
+ * noisy symbols and insist on identical output.  The noise is bursty
+ * so that the path metrics grow large enough to be renormalized at
+ * different times in different decoders.
+ */
+static void
+compare (atsci_multi_viterbi &multi, atsci_single_viterbi single[NDECODERS], int n)
+{
+  float	in[NDECODERS];
+  char	out[NDECODERS];
+
+  for (int i = 0; i < n; i++){
+    for (int d = 0; d < NDECODERS; d++){
+      float noise_factor = (i + 37 * d) % 1000 < 100 ? 50.0 : 2.0;
+      in[d] = (2 * (random () & 0x7) - 7) + noise () * noise_factor;
+    }
+
+    multi.decode (out, in);
+
+    for (int d = 0; d < NDECODERS; d++)
+      CPPUNIT_ASSERT_EQUAL ((int) single[d].decode (in[d]), (int) out[d]);
+  }
+}
+
+void
+qa_atsci_multi_viterbi::t0 ()
+{
+  atsci_multi_viterbi	multi;
+  atsci_single_viterbi	single[NDECODERS];
+
+  srandom (27);		// reproducable sequence of "random" values
+
+  CPPUNIT_ASSERT_EQUAL (single[0].delay (), multi.delay ());
+  compare (multi, single, NN);
+}
+
+void
+qa_atsci_multi_viterbi::t1 ()
+{
+  atsci_multi_viterbi	multi;
+  atsci_single_viterbi	single[NDECODERS];
+
+  srandom (28);
+
+  compare (multi, single, NN / 2);
+
+  // reset must put every lane back to its initial state
+  multi.reset ();
+  for (int d = 0; d < NDECODERS; d++)
+    single[d].reset ();
+
+  compare (multi, single, NN / 2);
+}
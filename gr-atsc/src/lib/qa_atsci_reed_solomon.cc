@@ -113,3 +113,36 @@ qa_atsci_reed_solomon::t0_reed_solomon ()
 
   CPPUNIT_ASSERT (decoder_errors == 0);
 }
+
+// The batch decoder must agree with decoding the packets one at a time
+void
+qa_atsci_reed_solomon::t1_batch ()
+{
+  static const int		NPACKETS = 100;	// more than one chunk
+  static atsc_mpeg_packet_no_sync	in[NPACKETS];
+  static atsc_mpeg_packet_rs_encoded	enc[NPACKETS];
+  static atsc_mpeg_packet_no_sync	out[NPACKETS];
+  atsc_mpeg_packet_no_sync		out1;
+  int					ncorrections[NPACKETS];
+
+  for (int k = 0; k < NPACKETS; k++){
+    for (int i = 0; i < ATSC_MPEG_DATA_LENGTH; i++)
+      in[k].data[i] = random () & 0xff;
+
+    rs.encode (enc[k], in[k]);
+
+    // from clean to uncorrectable
+    int errors = k % (NROOTS/2 + 5);
+    for (int i = 0; i < errors; i++)
+      enc[k].data[random () % NN] ^= (random () & 0xff) | 1;
+  }
+
+  rs.decode (out, enc, ncorrections, NPACKETS);
+
+  for (int k = 0; k < NPACKETS; k++){
+    CPPUNIT_ASSERT_EQUAL (rs.decode (out1, enc[k]), ncorrections[k]);
+    CPPUNIT_ASSERT (out1 == out[k]);
+    if (k % (NROOTS/2 + 5) == 0)
+      CPPUNIT_ASSERT (ncorrections[k] == 0 && in[k] == out[k]);
+  }
+}
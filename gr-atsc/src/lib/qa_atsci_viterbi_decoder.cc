@@ -176,3 +176,34 @@ qa_atsci_viterbi_decoder::t1 ()
     CPPUNIT_ASSERT (expected_out[i] == decoder_out[i]);
   }
 }
+
+/*
+ * Not a correctness test: times the decoder on noisy symbols and
+ * reports its throughput.
+ */
+void
+qa_atsci_viterbi_decoder::t2 ()
+{
+  static const int		NGROUPS = 200;
+  atsc_soft_data_segment	decoder_in[NCODERS];
+  atsc_mpeg_packet_rs_encoded	decoder_out[NCODERS];
+
+  srandom (27);
+
+  for (int i = 0; i < NCODERS; i++){
+    for (unsigned int j = 0; j < NELEM (decoder_in[i].data); j++)
+      decoder_in[i].data[j] =
+	(2 * (random () & 0x7) - 7) + 2.0 * ((float) random () / RAND_MAX - 0.5);
+  }
+  pad_decoder_input (decoder_in);		// sync symbols and pipeline info
+
+  viterbi.reset ();
+
+  clock_t start = clock ();
+  for (int n = 0; n < NGROUPS; n++)
+    viterbi.decode (decoder_out, decoder_in);
+  double secs = (double) (clock () - start) / CLOCKS_PER_SEC;
+
+  if (secs > 0)
+    printf ("\n  viterbi decoder: %.0f segments/s\n", NGROUPS * NCODERS / secs);
+}
@@ -41,6 +41,7 @@ class qa_atsci_viterbi_decoder : public CppUnit::TestCase {
   CPPUNIT_TEST_SUITE (qa_atsci_viterbi_decoder);
   CPPUNIT_TEST (t0);
   CPPUNIT_TEST (t1);
+  CPPUNIT_TEST (t2);
   CPPUNIT_TEST_SUITE_END ();
 
  private:
@@ -48,6 +49,7 @@ class qa_atsci_viterbi_decoder : public CppUnit::TestCase {
 
   void t0 ();
   void t1 ();
+  void t2 ();
 };
 
 
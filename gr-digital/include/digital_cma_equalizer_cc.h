@@ -72,6 +72,13 @@ protected:
     // Hn+1 = Hn - mu*conj(Xn)*zn*(|zn|^2 - 1)
     tap -= d_mu*conj(in)*d_error;
   }
+
+  virtual bool linear_update(gr_complex &mu, bool &conj_input)
+  {
+    mu = -d_mu;
+    conj_input = true;
+    return true;
+  }
   
 public:
   float get_gain() 
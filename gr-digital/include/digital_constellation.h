@@ -75,12 +75,20 @@ public:
   unsigned int decision_maker_pe (const gr_complex *sample, float *phase_error);
   //! Calculates distance.
   unsigned int decision_maker_e (const gr_complex *sample, float *error);
+  //! Makes decisions for \p nsymbols consecutive symbols of
+  //! dimensionality() samples each; results are truncated to 8 bits.
+  virtual void decision_maker_n (const gr_complex *sample, unsigned char *out,
+				 unsigned int nsymbols);
   
   //! Calculates metrics for all points in the constellation.
   //! For use with the viterbi algorithm.
   virtual void calc_metric(const gr_complex *sample, float *metric, trellis_metric_type_t type);
   virtual void calc_euclidean_metric(const gr_complex *sample, float *metric);
   virtual void calc_hard_symbol_metric(const gr_complex *sample, float *metric);
+  //! Calculates metrics for \p nsymbols consecutive symbols, arity()
+  //! values per symbol.
+  void calc_metric_n(const gr_complex *sample, float *metric,
+		     trellis_metric_type_t type, unsigned int nsymbols);
   
   //! Returns the set of points in this constellation.
   std::vector<gr_complex> points() { return d_constellation;}
@@ -120,8 +128,15 @@ public:
   unsigned int d_rotational_symmetry;
   unsigned int d_dimensionality;
   unsigned int d_arity;
+  //! Real and imaginary parts of the points, indexed by
+  //! dimension*arity + point, for the vectorized distance loops.
+  std::vector<float> d_re_points;
+  std::vector<float> d_im_points;
 
   float get_distance(unsigned int index, const gr_complex *sample);
+  //! Distances from \p sample to points first .. first+count-1.
+  void get_distances(const gr_complex *sample, unsigned int first,
+		     unsigned int count, float *dist);
   unsigned int get_closest_point(const gr_complex *sample);
   void calc_arity ();
 };
@@ -157,6 +172,9 @@ class DIGITAL_API digital_constellation_calcdist : public digital_constellation
 				  unsigned int rotational_symmetry,
 				  unsigned int dimensionality);
   unsigned int decision_maker (const gr_complex *sample);
+  //! Searches four symbols at a time for dimension one constellations.
+  void decision_maker_n (const gr_complex *sample, unsigned char *out,
+			 unsigned int nsymbols);
   // void calc_metric(gr_complex *sample, float *metric, trellis_metric_type_t type);
   // void calc_euclidean_metric(gr_complex *sample, float *metric);
   // void calc_hard_symbol_metric(gr_complex *sample, float *metric);
@@ -198,9 +216,6 @@ class DIGITAL_API digital_constellation_sector : public digital_constellation
   void find_sector_values ();
 
   unsigned int n_sectors;
-
- private:
-
   std::vector<unsigned int> sector_values;
 
 };
@@ -249,6 +264,10 @@ class DIGITAL_API digital_constellation_rect : public digital_constellation_sect
 			      float width_real_sectors,
 			      float width_imag_sectors);
 
+  //! Finds the sectors of four samples at a time.
+  void decision_maker_n (const gr_complex *sample, unsigned char *out,
+			 unsigned int nsymbols);
+
  protected:
 
   unsigned int get_sector (const gr_complex *sample);
@@ -25,6 +25,7 @@
 
 #include <digital_api.h>
 #include <gr_sync_block.h>
+#include <gri_access_code_correlator.h>
 #include <string>
 
 class digital_correlate_access_code_bb;
@@ -56,13 +57,11 @@ class DIGITAL_API digital_correlate_access_code_bb : public gr_sync_block
   friend DIGITAL_API digital_correlate_access_code_bb_sptr 
   digital_make_correlate_access_code_bb (const std::string &access_code, int threshold);
  private:
-  unsigned long long d_access_code;	// access code to locate start of packet
-                                        //   access code is left justified in the word
-  unsigned long long d_data_reg;	// used to look for access_code
+  gri_access_code_correlator d_correlator;	// looks for access_code
+  std::vector<int>   d_hits;		// where it was found in the last work call
   unsigned long long d_flag_reg;	// keep track of decisions
   unsigned long long d_flag_bit;	// mask containing 1 bit which is location of new flag
-  unsigned long long d_mask;		// masks access_code bits (top N bits are set where
-                                        //   N is the number of bits in the access code)
+  unsigned int	     d_len;		// number of bits in the access code
   unsigned int	     d_threshold;	// how many bits may be wrong in sync vector
 
  protected:
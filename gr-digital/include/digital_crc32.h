@@ -48,4 +48,38 @@ digital_crc32(const unsigned char *buf, size_t len);
 DIGITAL_API unsigned int 
 digital_crc32(const std::string buf);
 
+/*!
+ * \brief running CRC-32 with any polynomial
+ * \ingroup digital
+ *
+ * Computes the same CRC as digital_update_crc32 and digital_crc32,
+ * MSB first, for the generator polynomial \p poly (x^32 implied; the
+ * default is the one they use).  Bytes are taken 8 at a time through
+ * slicing-by-8 tables, or 64 at a time folded with carry-less
+ * multiplies on CPUs that have PCLMULQDQ.
+ */
+class DIGITAL_API digital_crc32_engine
+{
+ public:
+  digital_crc32_engine(unsigned int poly = 0x04C11DB7);
+
+  unsigned int poly() const { return d_poly; }
+
+  //! Update a running CRC with the bytes buf[0..len-1]
+  unsigned int update(unsigned int crc, const unsigned char *buf, size_t len) const;
+  unsigned int update(unsigned int crc, const std::string buf) const;
+
+  //! CRC of buf[0..len-1]: start from all 1's, complement at the end
+  unsigned int crc(const unsigned char *buf, size_t len) const;
+  unsigned int crc(const std::string buf) const;
+
+ private:
+  unsigned int d_poly;
+  unsigned int d_table[8][256];	// d_table[k][b] = b * x^(32+8k) mod poly
+  unsigned int d_fold[4];	// x^576, x^512, x^192, x^128 mod poly
+
+  unsigned int update_slice8(unsigned int crc, const unsigned char *buf, size_t len) const;
+  unsigned int update_clmul(unsigned int crc, const unsigned char *buf, size_t len) const;
+};
+
 #endif /* INCLUDED_CRC32_H */
@@ -100,6 +100,13 @@ protected:
   {
     tap += d_mu*in*d_error;
   }
+
+  virtual bool linear_update(gr_complex &mu, bool &conj_input)
+  {
+    mu = d_mu;
+    conj_input = false;
+    return true;
+  }
   
 public:
   void set_gain(float mu) 
@@ -97,6 +97,13 @@ protected:
     tap += d_mu*conj(in)*d_error;
   }
 
+  virtual bool linear_update(gr_complex &mu, bool &conj_input)
+  {
+    mu = d_mu;
+    conj_input = true;
+    return true;
+  }
+
 public:
   float get_gain()
   {
@@ -34,6 +34,11 @@
 #include <stdlib.h>
 #include <float.h>
 #include <stdexcept>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #define M_TWOPI (2*M_PI)
 #define SQRT_TWO 0.707107
@@ -93,25 +98,65 @@ digital_constellation::get_distance(unsigned int index, const gr_complex *sample
   return dist;
 }
 
+void
+digital_constellation::get_distances(const gr_complex *sample, unsigned int first,
+				     unsigned int count, float *dist)
+{
+  unsigned int j = 0;
+
+#if defined(__SSE2__)
+  // Same operations in the same order as get_distance, four points
+  // at a time.
+  for (; j + 4 <= count; j += 4) {
+    __m128 acc = _mm_setzero_ps();
+    for (unsigned int d = 0; d < d_dimensionality; d++) {
+      unsigned int k = d*d_arity + first + j;
+      __m128 dr = _mm_sub_ps(_mm_set1_ps(sample[d].real()), _mm_loadu_ps(&d_re_points[k]));
+      __m128 di = _mm_sub_ps(_mm_set1_ps(sample[d].imag()), _mm_loadu_ps(&d_im_points[k]));
+      acc = _mm_add_ps(acc, _mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(di, di)));
+    }
+    _mm_storeu_ps(&dist[j], acc);
+  }
+#endif
+
+  for (; j < count; j++)
+    dist[j] = get_distance(first + j, sample);
+}
+
 unsigned int
 digital_constellation::get_closest_point(const gr_complex *sample)
 {
+  const unsigned int CHUNK = 64;
+  float dist[CHUNK];
   unsigned int min_index = 0;
-  float min_euclid_dist;
-  float euclid_dist;
-    
-  min_euclid_dist = get_distance(0, sample);
-  min_index = 0;
-  for (unsigned int j = 1; j < d_arity; j++){
-    euclid_dist = get_distance(j, sample);
-    if (euclid_dist < min_euclid_dist){
-      min_euclid_dist = euclid_dist;
-      min_index = j;
+  float min_euclid_dist = 0;
+
+  for (unsigned int first = 0; first < d_arity; first += CHUNK){
+    unsigned int count = std::min(CHUNK, d_arity - first);
+    get_distances(sample, first, count, dist);
+    unsigned int j = 0;
+    if (first == 0){
+      min_euclid_dist = dist[0];
+      j = 1;
+    }
+    for (; j < count; j++){
+      if (dist[j] < min_euclid_dist){
+	min_euclid_dist = dist[j];
+	min_index = first + j;
+      }
     }
   }
   return min_index;
 }
 
+void
+digital_constellation::decision_maker_n(const gr_complex *sample, unsigned char *out,
+					unsigned int nsymbols)
+{
+  for (unsigned int i = 0; i < nsymbols; i++)
+    out[i] = decision_maker(&sample[i*d_dimensionality]);
+}
+
 unsigned int
 digital_constellation::decision_maker_pe(const gr_complex *sample, float *phase_error)
 {
@@ -175,12 +220,18 @@ digital_constellation::calc_metric(const gr_complex *sample, float *metric,
   }
 }
 
+void
+digital_constellation::calc_metric_n(const gr_complex *sample, float *metric,
+				     trellis_metric_type_t type, unsigned int nsymbols)
+{
+  for (unsigned int i = 0; i < nsymbols; i++)
+    calc_metric(&sample[i*d_dimensionality], &metric[i*d_arity], type);
+}
+
 void
 digital_constellation::calc_euclidean_metric(const gr_complex *sample, float *metric)
 {
-  for (unsigned int o=0; o<d_arity; o++) {
-    metric[o] = get_distance(o, sample);
-  }
+  get_distances(sample, 0, d_arity, metric);
 }
 
 void
@@ -206,6 +257,15 @@ digital_constellation::calc_arity ()
   if (d_constellation.size() % d_dimensionality != 0)
     throw std::runtime_error ("Constellation vector size must be a multiple of the dimensionality.");    
   d_arity = d_constellation.size()/d_dimensionality;
+
+  d_re_points.resize(d_constellation.size());
+  d_im_points.resize(d_constellation.size());
+  for (unsigned int p=0; p<d_arity; p++) {
+    for (unsigned int d=0; d<d_dimensionality; d++) {
+      d_re_points[d*d_arity + p] = d_constellation[p*d_dimensionality + d].real();
+      d_im_points[d*d_arity + p] = d_constellation[p*d_dimensionality + d].imag();
+    }
+  }
 }
 
 unsigned int
@@ -241,6 +301,50 @@ digital_constellation_calcdist::decision_maker(const gr_complex *sample)
   return get_closest_point(sample);
 }
 
+void
+digital_constellation_calcdist::decision_maker_n(const gr_complex *sample,
+						 unsigned char *out,
+						 unsigned int nsymbols)
+{
+  unsigned int i = 0;
+
+#if defined(__SSE2__)
+  // Four symbols per pass, visiting the points in order and keeping
+  // the first smallest distance, exactly as get_closest_point does.
+  if (d_dimensionality == 1 && d_arity > 0) {
+    int index[4];
+    for (; i + 4 <= nsymbols; i += 4) {
+      __m128 a = _mm_loadu_ps((const float *) &sample[i]);
+      __m128 b = _mm_loadu_ps((const float *) &sample[i+2]);
+      __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+      __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+
+      __m128 dr = _mm_sub_ps(re, _mm_set1_ps(d_re_points[0]));
+      __m128 di = _mm_sub_ps(im, _mm_set1_ps(d_im_points[0]));
+      __m128 min_dist = _mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(di, di));
+      __m128i min_index = _mm_setzero_si128();
+
+      for (unsigned int j = 1; j < d_arity; j++) {
+	dr = _mm_sub_ps(re, _mm_set1_ps(d_re_points[j]));
+	di = _mm_sub_ps(im, _mm_set1_ps(d_im_points[j]));
+	__m128 dist = _mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(di, di));
+	__m128i less = _mm_castps_si128(_mm_cmplt_ps(dist, min_dist));
+	min_dist = _mm_min_ps(dist, min_dist);
+	min_index = _mm_or_si128(_mm_and_si128(less, _mm_set1_epi32(j)),
+				 _mm_andnot_si128(less, min_index));
+      }
+
+      _mm_storeu_si128((__m128i *) index, min_index);
+      for (unsigned int k = 0; k < 4; k++)
+	out[i+k] = index[k];
+    }
+  }
+#endif
+
+  for (; i < nsymbols; i++)
+    out[i] = get_closest_point(&sample[i*d_dimensionality]);
+}
+
 digital_constellation_sector::digital_constellation_sector (std::vector<gr_complex> constellation,
 							    std::vector<unsigned int> pre_diff_code,
 							    unsigned int rotational_symmetry,
@@ -317,6 +421,57 @@ digital_constellation_rect::get_sector (const gr_complex *sample)
   sector = real_sector * n_imag_sectors + imag_sector;
   return sector;
 }
+
+void
+digital_constellation_rect::decision_maker_n(const gr_complex *sample,
+					     unsigned char *out,
+					     unsigned int nsymbols)
+{
+  unsigned int i = 0;
+
+#if defined(__SSE2__)
+  // Same arithmetic as get_sector: the quotient is a float and the
+  // offset is added in double precision before truncating.
+  const __m128 width_r = _mm_set1_ps(d_width_real_sectors);
+  const __m128 width_i = _mm_set1_ps(d_width_imag_sectors);
+  const __m128d half_r = _mm_set1_pd(n_real_sectors/2.0);
+  const __m128d half_i = _mm_set1_pd(n_imag_sectors/2.0);
+  const __m128i last_r = _mm_set1_epi32(n_real_sectors - 1);
+  const __m128i last_i = _mm_set1_epi32(n_imag_sectors - 1);
+  const __m128i zero = _mm_setzero_si128();
+  int real_sector[4], imag_sector[4];
+
+  for (; i + 4 <= nsymbols; i += 4) {
+    __m128 a = _mm_loadu_ps((const float *) &sample[i]);
+    __m128 b = _mm_loadu_ps((const float *) &sample[i+2]);
+    __m128 qr = _mm_div_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0)), width_r);
+    __m128 qi = _mm_div_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1)), width_i);
+
+    __m128i sr = _mm_unpacklo_epi64
+      (_mm_cvttpd_epi32(_mm_add_pd(_mm_cvtps_pd(qr), half_r)),
+       _mm_cvttpd_epi32(_mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(qr, qr)), half_r)));
+    __m128i si = _mm_unpacklo_epi64
+      (_mm_cvttpd_epi32(_mm_add_pd(_mm_cvtps_pd(qi), half_i)),
+       _mm_cvttpd_epi32(_mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(qi, qi)), half_i)));
+
+    // Clamp to [0, n-1]
+    sr = _mm_andnot_si128(_mm_cmplt_epi32(sr, zero), sr);
+    si = _mm_andnot_si128(_mm_cmplt_epi32(si, zero), si);
+    __m128i over_r = _mm_cmpgt_epi32(sr, last_r);
+    __m128i over_i = _mm_cmpgt_epi32(si, last_i);
+    sr = _mm_or_si128(_mm_and_si128(over_r, last_r), _mm_andnot_si128(over_r, sr));
+    si = _mm_or_si128(_mm_and_si128(over_i, last_i), _mm_andnot_si128(over_i, si));
+
+    _mm_storeu_si128((__m128i *) real_sector, sr);
+    _mm_storeu_si128((__m128i *) imag_sector, si);
+    for (unsigned int k = 0; k < 4; k++)
+      out[i+k] = sector_values[real_sector[k] * n_imag_sectors + imag_sector[k]];
+  }
+#endif
+
+  for (; i < nsymbols; i++)
+    out[i] = sector_values[get_sector(&sample[i])];
+}
   
 unsigned int
 digital_constellation_rect::calc_sector_value (unsigned int sector)
@@ -68,9 +68,7 @@ digital_constellation_decoder_cb::general_work (int noutput_items,
   gr_complex const *in = (const gr_complex *) input_items[0];
   unsigned char *out = (unsigned char *) output_items[0];
 
-  for(int i = 0; i < noutput_items; i++){
-    out[i] = d_constellation->decision_maker(&(in[i*d_dim]));
-  }
+  d_constellation->decision_maker_n(in, out, noutput_items);
 
   consume_each (noutput_items * d_dim);
   return noutput_items;
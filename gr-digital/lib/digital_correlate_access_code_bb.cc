@@ -27,8 +27,8 @@
 #include <digital_correlate_access_code_bb.h>
 #include <gr_io_signature.h>
 #include <stdexcept>
-#include <gr_count_bits.h>
 #include <cstdio>
+#include <algorithm>
 
 
 #define VERBOSE 0
@@ -47,7 +47,7 @@ digital_correlate_access_code_bb::digital_correlate_access_code_bb (
   : gr_sync_block ("correlate_access_code_bb",
 		   gr_make_io_signature (1, 1, sizeof(char)),
 		   gr_make_io_signature (1, 1, sizeof(char))),
-    d_data_reg(0), d_flag_reg(0), d_flag_bit(0), d_mask(0),
+    d_flag_reg(0), d_flag_bit(0), d_len(0),
     d_threshold(threshold)
 
 {
@@ -69,18 +69,17 @@ digital_correlate_access_code_bb::set_access_code(
   if (len > 64)
     return false;
 
-  // set len top bits to 1.
-  d_mask = ((~0ULL) >> (64 - len)) << (64 - len);
-
+  d_len = len;
   d_flag_bit = 1LL << (64 - len);	// Where we or-in new flag values.
                                         // new data always goes in 0x0000000000000001
-  d_access_code = 0;
+  unsigned long long code = 0;
   for (unsigned i=0; i < 64; i++){
-    d_access_code <<= 1;
+    code <<= 1;
     if (i < len)
-      d_access_code |= access_code[i] & 1;	// look at LSB only
+      code |= access_code[i] & 1;	// look at LSB only
   }
 
+  d_correlator.set_access_code(code, len, d_threshold);
   return true;
 }
 
@@ -92,41 +91,34 @@ digital_correlate_access_code_bb::work (int noutput_items,
   const unsigned char *in = (const unsigned char *) input_items[0];
   unsigned char *out = (unsigned char *) output_items[0];
 
-  for (int i = 0; i < noutput_items; i++){
-
-    // compute output value
-    unsigned int t = 0;
+  // The output is what falls out of the top of the data and flag
+  // registers: the input delayed 64 bits, and a flag d_len bits after
+  // each place the access code was found.
+  unsigned long long data_reg = d_correlator.data_reg();
+  int nreg = std::min(64, noutput_items);
 
-    t |= ((d_data_reg >> 63) & 0x1) << 0;
-    t |= ((d_flag_reg >> 63) & 0x1) << 1;	// flag bit
-    out[i] = t;
-    
-    // compute hamming distance between desired access code and current data
-    unsigned long long wrong_bits = 0;
-    unsigned int nwrong = d_threshold+1;
-    int new_flag = 0;
+  for (int i = 0; i < nreg; i++) {
+    out[i] = ((data_reg >> (63 - i)) & 0x1) << 0;
+    out[i] |= ((d_flag_reg >> (63 - i)) & 0x1) << 1;	// flag bit
+  }
+  for (int i = 64; i < noutput_items; i++)
+    out[i] = in[i - 64] & 0x1;
 
-    wrong_bits  = (d_data_reg ^ d_access_code) & d_mask;
-    nwrong = gr_count_bits64(wrong_bits);
+  // positions where the access code ended just before in[i]
+  d_correlator.search(in, noutput_items, d_hits);
 
-    // test for access code with up to threshold errors
-    new_flag = (nwrong <= d_threshold);
+  d_flag_reg = noutput_items < 64 ? d_flag_reg << noutput_items : 0;
+  for (size_t h = 0; h < d_hits.size(); h++) {
+    int i = d_hits[h];
 
 #if VERBOSE
-    if(new_flag) {
-      fprintf(stderr, "access code found: %llx\n", d_access_code);
-    }
-    else {
-      fprintf(stderr, "%llx  ==>  %llx\n", d_access_code, d_data_reg);
-    }
+    fprintf(stderr, "access code found before bit %d\n", i);
 #endif
 
-    // shift in new data and new flag
-    d_data_reg = (d_data_reg << 1) | (in[i] & 0x1);
-    d_flag_reg = (d_flag_reg << 1);
-    if (new_flag) {
-      d_flag_reg |= d_flag_bit;
-    }
+    if (i + d_len < (unsigned int) noutput_items)
+      out[i + d_len] |= 0x2;
+    else				// still in the flag register
+      d_flag_reg |= d_flag_bit << (noutput_items - 1 - i);
   }
 
   return noutput_items;
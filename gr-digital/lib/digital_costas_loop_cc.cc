@@ -26,8 +26,7 @@
 
 #include <digital_costas_loop_cc.h>
 #include <gr_io_signature.h>
-#include <gr_expj.h>
-#include <gr_sincos.h>
+#include <gr_fxpt.h>
 #include <gr_math.h>
 
 digital_costas_loop_cc_sptr
@@ -119,12 +118,14 @@ digital_costas_loop_cc::work (int noutput_items,
   bool write_foptr = output_items.size() >= 2;
 
   float error;
+  float t_imag, t_real;
   gr_complex nco_out;
   
   if (write_foptr) {
 
     for (int i = 0; i < noutput_items; i++){
-      nco_out = gr_expj(-d_phase);
+      gr_fxpt::sincos(gr_fxpt::float_to_fixed(-d_phase), &t_imag, &t_real);
+      nco_out = gr_complex(t_real, t_imag);
       optr[i] = iptr[i] * nco_out;
       
       error = (*this.*d_phase_detector)(optr[i]);
@@ -138,7 +139,8 @@ digital_costas_loop_cc::work (int noutput_items,
     } 
   } else {
     for (int i = 0; i < noutput_items; i++){
-      nco_out = gr_expj(-d_phase);
+      gr_fxpt::sincos(gr_fxpt::float_to_fixed(-d_phase), &t_imag, &t_real);
+      nco_out = gr_complex(t_real, t_imag);
       optr[i] = iptr[i] * nco_out;
       
       error = (*this.*d_phase_detector)(optr[i]);
@@ -23,16 +23,25 @@ from gnuradio import gru
 import digital_swig
 import struct
 
-def gen_and_append_crc32(s):
-    crc = digital_swig.crc32(s)
+_engines = {}
+
+def _crc32(s, poly):
+    if poly is None:
+        return digital_swig.crc32(s)
+    if poly not in _engines:
+        _engines[poly] = digital_swig.crc32_engine(poly)
+    return _engines[poly].crc(s)
+
+def gen_and_append_crc32(s, poly=None):
+    crc = _crc32(s, poly)
     return s + struct.pack(">I", gru.hexint(crc) & 0xFFFFFFFF)
 
-def check_crc32(s):
+def check_crc32(s, poly=None):
     if len(s) < 4:
         return (False, '')
     msg = s[:-4]
     #print "msg = '%s'" % (msg,)
-    actual = digital_swig.crc32(msg)
+    actual = _crc32(msg, poly)
     (expected,) = struct.unpack(">I", s[-4:])
     # print "actual =", hex(actual), "expected =", hex(expected)
     return (actual == expected, msg)
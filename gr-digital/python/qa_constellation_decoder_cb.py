@@ -23,6 +23,7 @@
 from gnuradio import gr, gr_unittest
 import digital_swig
 import math
+import random
 
 class test_constellation_decoder (gr_unittest.TestCase):
 
@@ -70,6 +71,28 @@ class test_constellation_decoder (gr_unittest.TestCase):
 	#print "expected result", expected_result
         self.assertFloatTuplesAlmostEqual (expected_result, actual_result)
 
+    def test_constellation_decoder_cb_batch (self):
+        # The block decides several symbols at a time; check it against
+        # one decision per sample, including the tails.
+        points = [complex(a, b) for a in (-3, -1, 1, 3) for b in (-3, -1, 1, 3)]
+        cnsts = (digital_swig.constellation_calcdist(points, [], 4, 1),
+                 digital_swig.constellation_rect(points, [], 4, 4, 4, 2, 2))
+        src_data = tuple([complex(random.uniform(-5, 5), random.uniform(-5, 5))
+                          for i in range(1027)])
+        for cnst in cnsts:
+            expected_result = tuple([cnst.decision_maker_v((x,)) for x in src_data])
+            src = gr.vector_source_c (src_data)
+            op = digital_swig.constellation_decoder_cb (cnst.base())
+            dst = gr.vector_sink_b ()
+
+            self.tb = gr.top_block ()
+            self.tb.connect (src, op)
+            self.tb.connect (op, dst)
+            self.tb.run ()
+
+            actual_result = dst.data ()
+            self.assertEqual (expected_result, actual_result)
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_constellation_decoder, "test_constellation_decoder.xml")
@@ -56,5 +56,33 @@ class test_crc32(gr_unittest.TestCase):
 
         self.assertEqual (expected_result, result)
 
+    def test04 (self):
+        # the table driven and folding paths against a bit at a time CRC
+        def bitwise_crc32(data, poly):
+            crc = 0xFFFFFFFF
+            for c in data:
+                crc ^= ord(c) << 24
+                for i in range(8):
+                    if crc & 0x80000000:
+                        crc = ((crc << 1) ^ poly) & 0xFFFFFFFF
+                    else:
+                        crc = (crc << 1) & 0xFFFFFFFF
+            return crc ^ 0xFFFFFFFF
+
+        random.seed(0)
+        engine = digital_swig.crc32_engine(0x1EDC6F41)
+        for n in (0, 1, 7, 8, 63, 64, 127, 128, 129, 200, 1000, 1517):
+            data = ''.join([chr(random.randint(0, 255)) for i in range(n)])
+            self.assertEqual (bitwise_crc32(data, 0x04C11DB7), digital_swig.crc32(data))
+            self.assertEqual (bitwise_crc32(data, 0x1EDC6F41), engine.crc(data))
+
+    def test05 (self):
+        # a running CRC over pieces is the CRC of the whole
+        data = 100*"0123456789"
+        crc = 0xFFFFFFFF
+        for i in range(0, len(data), 300):
+            crc = digital_swig.update_crc32(crc, data[i:i+300])
+        self.assertEqual (digital_swig.crc32(data), crc ^ 0xFFFFFFFF)
+
 if __name__ == '__main__':
     gr_unittest.run(test_crc32, "test_crc32.xml")
@@ -25,3 +25,14 @@
 
 unsigned int digital_update_crc32(unsigned int crc, const std::string buf);
 unsigned int digital_crc32(const std::string buf);
+
+%rename(crc32_engine) digital_crc32_engine;
+
+class digital_crc32_engine
+{
+ public:
+  digital_crc32_engine(unsigned int poly = 0x04C11DB7);
+  unsigned int poly() const;
+  unsigned int update(unsigned int crc, const std::string buf) const;
+  unsigned int crc(const std::string buf) const;
+};
@@ -21,21 +21,9 @@
  */
 
 #include <fft/fft.h>
-#include <gr_sys_paths.h>
+#include <gri_fft.h>
 #include <fftw3.h>
 
-#ifdef _MSC_VER //http://www.fftw.org/install/windows.html#DLLwisdom
-static void my_fftw_write_char(char c, void *f) { fputc(c, (FILE *) f); }
-#define fftw_export_wisdom_to_file(f) fftw_export_wisdom(my_fftw_write_char, (void*) (f))
-#define fftwf_export_wisdom_to_file(f) fftwf_export_wisdom(my_fftw_write_char, (void*) (f))
-#define fftwl_export_wisdom_to_file(f) fftwl_export_wisdom(my_fftw_write_char, (void*) (f))
-
-static int my_fftw_read_char(void *f) { return fgetc((FILE *) f); }
-#define fftw_import_wisdom_from_file(f) fftw_import_wisdom(my_fftw_read_char, (void*) (f))
-#define fftwf_import_wisdom_from_file(f) fftwf_import_wisdom(my_fftw_read_char, (void*) (f))
-#define fftwl_import_wisdom_from_file(f) fftwl_import_wisdom(my_fftw_read_char, (void*) (f))
-#endif //_MSC_VER
-
 #include <gr_complex.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,10 +31,6 @@ static int my_fftw_read_char(void *f) { return fgetc((FILE *) f); }
 #include <cassert>
 #include <stdexcept>
 
-#include <boost/filesystem/operations.hpp>
-#include <boost/filesystem/path.hpp>
-namespace fs = boost::filesystem;
-
 namespace gr {
   namespace fft {
 
@@ -68,74 +52,18 @@ namespace gr {
       fftwf_free(b);
     }
 
+    // Share the planner lock, plan cache and wisdom handling with
+    // gri_fft, so the two never plan concurrently or save wisdom twice.
     boost::mutex &
     planner::mutex()
     {
-      static boost::mutex  s_planning_mutex;
-
-      return s_planning_mutex;
-    }
-
-    static const char *
-    wisdom_filename()
-    {
-      static fs::path path;
-      path = fs::path(gr_appdata_path()) / ".gr_fftw_wisdom";
-      return path.string().c_str();
-    }
-
-    static void
-    import_wisdom()
-    {
-      const char *filename = wisdom_filename ();
-      FILE *fp = fopen (filename, "r");
-      if (fp != 0){
-	int r = fftwf_import_wisdom_from_file (fp);
-	fclose (fp);
-	if (!r){
-	  fprintf (stderr, "gr::fft: can't import wisdom from %s\n", filename);
-	}
-      }
-    }
-
-    static void
-    config_threading(int nthreads)
-    {
-      static int fftw_threads_inited = 0;
-
-#ifdef FFTW3F_THREADS
-      if (fftw_threads_inited == 0)
-	{
-	  fftw_threads_inited = 1;
-	  fftwf_init_threads();
-	}
-
-      fftwf_plan_with_nthreads(nthreads);
-#endif
-    }
-
-    static void
-    export_wisdom()
-    {
-      const char *filename = wisdom_filename ();
-      FILE *fp = fopen (filename, "w");
-      if (fp != 0){
-	fftwf_export_wisdom_to_file (fp);
-	fclose (fp);
-      }
-      else {
-	fprintf (stderr, "fft_impl_fftw: ");
-	perror (filename);
-      }
+      return gri_fft_planner::mutex();
     }
 
 // ----------------------------------------------------------------
 
     fft_complex::fft_complex(int fft_size, bool forward, int nthreads)
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
       assert (sizeof (fftwf_complex) == sizeof (gr_complex));
 
       if (fft_size <= 0)
@@ -153,28 +81,22 @@ namespace gr {
       }
       
       d_nthreads = nthreads;
-      config_threading(nthreads);
-      import_wisdom();	// load prior wisdom from disk
-      
-      d_plan = fftwf_plan_dft_1d (fft_size,
-				  reinterpret_cast<fftwf_complex *>(d_inbuf),
-				  reinterpret_cast<fftwf_complex *>(d_outbuf),
-				  forward ? FFTW_FORWARD : FFTW_BACKWARD,
-				  FFTW_MEASURE);
+      d_plan = gri_fft_planner::acquire_plan(forward ? gri_fft_planner::COMPLEX_FORWARD
+					     : gri_fft_planner::COMPLEX_REVERSE,
+					     fft_size, nthreads, 1,
+					     d_inbuf, d_outbuf);
 
       if (d_plan == NULL) {
 	fprintf(stderr, "gr::fft: error creating plan\n");
+	fftwf_free (d_inbuf);
+	fftwf_free (d_outbuf);
 	throw std::runtime_error ("fftwf_plan_dft_1d failed");
       }
-      export_wisdom();	// store new wisdom to disk
     }
 
     fft_complex::~fft_complex()
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
-      fftwf_destroy_plan ((fftwf_plan) d_plan);
+      gri_fft_planner::release_plan(d_plan);
       fftwf_free (d_inbuf);
       fftwf_free (d_outbuf);
     }
@@ -194,16 +116,15 @@ namespace gr {
     void
     fft_complex::execute()
     {
-      fftwf_execute((fftwf_plan) d_plan);
+      fftwf_execute_dft((fftwf_plan) d_plan,
+			reinterpret_cast<fftwf_complex *>(d_inbuf),
+			reinterpret_cast<fftwf_complex *>(d_outbuf));
     }
 
 // ----------------------------------------------------------------
 
     fft_real_fwd::fft_real_fwd (int fft_size, int nthreads)
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
       assert (sizeof (fftwf_complex) == sizeof (gr_complex));
 
       if (fft_size <= 0)
@@ -221,27 +142,21 @@ namespace gr {
       }
 
       d_nthreads = nthreads;
-      config_threading(nthreads);
-      import_wisdom();	// load prior wisdom from disk
-
-      d_plan = fftwf_plan_dft_r2c_1d (fft_size,
-				      d_inbuf,
-				      reinterpret_cast<fftwf_complex *>(d_outbuf),
-				      FFTW_MEASURE);
+      d_plan = gri_fft_planner::acquire_plan(gri_fft_planner::REAL_FORWARD,
+					     fft_size, nthreads, 1,
+					     d_inbuf, d_outbuf);
 
       if (d_plan == NULL) {
 	fprintf(stderr, "gr::fft::fft_real_fwd: error creating plan\n");
+	fftwf_free (d_inbuf);
+	fftwf_free (d_outbuf);
 	throw std::runtime_error ("fftwf_plan_dft_r2c_1d failed");
       }
-      export_wisdom();	// store new wisdom to disk
     }
 
     fft_real_fwd::~fft_real_fwd()
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-      
-      fftwf_destroy_plan ((fftwf_plan) d_plan);
+      gri_fft_planner::release_plan(d_plan);
       fftwf_free (d_inbuf);
       fftwf_free (d_outbuf);
     }
@@ -261,16 +176,14 @@ namespace gr {
     void
     fft_real_fwd::execute()
     {
-      fftwf_execute ((fftwf_plan) d_plan);
+      fftwf_execute_dft_r2c((fftwf_plan) d_plan, d_inbuf,
+			    reinterpret_cast<fftwf_complex *>(d_outbuf));
     }
 
     // ----------------------------------------------------------------
 
     fft_real_rev::fft_real_rev(int fft_size, int nthreads)
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-
       assert (sizeof (fftwf_complex) == sizeof (gr_complex));
       
       if (fft_size <= 0)
@@ -288,30 +201,21 @@ namespace gr {
       }
 
       d_nthreads = nthreads;
-      config_threading(nthreads);
-      import_wisdom();	// load prior wisdom from disk
-
-      // FIXME If there's ever a chance that the planning functions
-      // will be called in multiple threads, we've got to ensure single
-      // threaded access.  They are not thread-safe.
-      d_plan = fftwf_plan_dft_c2r_1d (fft_size,
-				      reinterpret_cast<fftwf_complex *>(d_inbuf),
-				      d_outbuf,
-				      FFTW_MEASURE);
+      d_plan = gri_fft_planner::acquire_plan(gri_fft_planner::REAL_REVERSE,
+					     fft_size, nthreads, 1,
+					     d_inbuf, d_outbuf);
 
       if (d_plan == NULL) {
 	fprintf(stderr, "gr::fft::fft_real_rev: error creating plan\n");
+	fftwf_free (d_inbuf);
+	fftwf_free (d_outbuf);
 	throw std::runtime_error ("fftwf_plan_dft_c2r_1d failed");
       }
-      export_wisdom ();	// store new wisdom to disk
     }
 
     fft_real_rev::~fft_real_rev ()
     {
-      // Hold global mutex during plan construction and destruction.
-      planner::scoped_lock lock(planner::mutex());
-      
-      fftwf_destroy_plan ((fftwf_plan) d_plan);
+      gri_fft_planner::release_plan(d_plan);
       fftwf_free (d_inbuf);
       fftwf_free (d_outbuf);
     }
@@ -331,7 +235,8 @@ namespace gr {
     void
     fft_real_rev::execute ()
     {
-      fftwf_execute ((fftwf_plan) d_plan);
+      fftwf_execute_dft_c2r((fftwf_plan) d_plan,
+			    reinterpret_cast<fftwf_complex *>(d_inbuf), d_outbuf);
     }
 
   } /* namespace fft */
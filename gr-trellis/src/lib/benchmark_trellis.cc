@@ -0,0 +1,121 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Compares the nested-vector viterbi_algorithm/siso_algorithm with
+ * flat_trellis on convolutional code trellises of growing size.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+#include "fsm.h"
+#include "core_algorithms.h"
+#include "flat_trellis.h"
+
+#define K		1000	// trellis steps per block
+#define TOTAL_STEPS	(4 * 1024 * 1024)
+
+// min_star as it was computed before the table
+static float
+log_min_star (float a, float b)
+{
+  return (a <= b ? a : b)-log(1+exp(a <= b ? a-b : b-a));
+}
+
+static double
+cpu_time ()
+{
+  return (double) clock () / CLOCKS_PER_SEC;
+}
+
+static void
+report (const char *what, int S, int steps, double t)
+{
+  printf ("S=%4d %28s %8.3f Msteps/s\n", S, what, steps / t * 1e-6);
+}
+
+static void
+run (const fsm &FSM)
+{
+  int I = FSM.I (), S = FSM.S (), O = FSM.O ();
+  int nblocks = TOTAL_STEPS / S / K + 1;	// keep the run time roughly flat
+  std::vector<float> in (K*O), priori (K*I, 0.0), post (K*(I+O));
+  std::vector<int> out (K);
+  for (unsigned int i = 0; i < in.size (); i++)
+    in[i] = 4.0 * random () / RAND_MAX;
+
+  flat_trellis T (FSM);
+  double t;
+
+  t = cpu_time ();
+  for (int b = 0; b < nblocks; b++)
+    viterbi_algorithm (I, S, O, FSM.NS (), FSM.OS (), FSM.PS (), FSM.PI (),
+		       K, 0, -1, &in[0], &out[0]);
+  report ("viterbi_algorithm", S, nblocks*K, cpu_time () - t);
+
+  t = cpu_time ();
+  for (int b = 0; b < nblocks; b++)
+    T.viterbi (K, 0, -1, &in[0], &out[0]);
+  report ("flat_trellis::viterbi", S, nblocks*K, cpu_time () - t);
+
+  t = cpu_time ();
+  for (int b = 0; b < nblocks; b++)
+    siso_algorithm (I, S, O, FSM.NS (), FSM.OS (), FSM.PS (), FSM.PI (),
+		    K, 0, -1, true, true, &min, &priori[0], &in[0], &post[0]);
+  report ("siso_algorithm min", S, nblocks*K, cpu_time () - t);
+
+  t = cpu_time ();
+  for (int b = 0; b < nblocks; b++)
+    T.siso (K, 0, -1, true, true, &min, &priori[0], &in[0], &post[0]);
+  report ("flat_trellis::siso min", S, nblocks*K, cpu_time () - t);
+
+  t = cpu_time ();
+  for (int b = 0; b < nblocks; b++)
+    siso_algorithm (I, S, O, FSM.NS (), FSM.OS (), FSM.PS (), FSM.PI (),
+		    K, 0, -1, true, true, &log_min_star, &priori[0], &in[0], &post[0]);
+  report ("siso_algorithm log min_star", S, nblocks*K, cpu_time () - t);
+
+  t = cpu_time ();
+  for (int b = 0; b < nblocks; b++)
+    T.siso (K, 0, -1, true, true, &min_star, &priori[0], &in[0], &post[0]);
+  report ("flat_trellis::siso min_star", S, nblocks*K, cpu_time () - t);
+}
+
+int
+main (int argc, char **argv)
+{
+  // rate 1/2 codes with memory 2, 4, 6 and 8
+  static const int G[][2] = {
+    { 05, 07 }, { 023, 035 }, { 0133, 0171 }, { 0561, 0753 }
+  };
+
+  for (unsigned int n = 0; n < sizeof (G) / sizeof (G[0]); n++){
+    std::vector<int> g (G[n], G[n] + 2);
+    run (fsm (1, 2, g));
+  }
+}
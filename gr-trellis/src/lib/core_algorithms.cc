@@ -26,6 +26,7 @@
 #include <iostream>
 #include "core_algorithms.h"
 #include "calc_metric.h"
+#include "flat_trellis.h"
 
 static const float INF = 1.0e9;
 
@@ -36,7 +37,7 @@ float min(float a, float b)
 
 float min_star(float a, float b)
 {
-  return (a <= b ? a : b)-log(1+exp(a <= b ? a-b : b-a));
+  return flat_trellis::min_star(a,b);
 }
 
 
@@ -780,6 +781,48 @@ void siso_algorithm_combined<gr_complex>(int I, int S, int O,
 
 //=========================================================
 
+/*
+ * Hard decisions of the iterative decoders: the input symbol with the
+ * smallest metric at each step.  Returns how many of them differ from
+ * what was in dec[] before.
+ */
+static int
+hard_decisions(int I, int K, const float *post, int *dec)
+{
+  int changed=0;
+  for(int k=0;k<K;k++) {
+    float min=INF;
+    int mini=0;
+    for(int i=0;i<I;i++) {
+      if(post[k*I+i]<min) {
+        min=post[k*I+i];
+        mini=i;
+      }
+    }
+    if(dec[k]!=mini) {
+      dec[k]=mini;
+      changed++;
+    }
+  }
+  return changed;
+}
+
+/*
+ * Early termination test, called once per iteration with the new
+ * decisions.  stable counts the iterations without a change.
+ */
+static bool
+converged(const iterative_decoder_options &options,
+          const std::vector<int> &decisions, int changed, int &stable)
+{
+  stable = changed ? 0 : stable+1;
+  if(options.check && (*options.check)(&(decisions[0]),decisions.size(),options.check_arg))
+    return true;
+  return options.stable_iterations>0 && stable>=options.stable_iterations;
+}
+
+//=========================================================
+
 template<class Ti, class To>
 void sccc_decoder_combined(
       const fsm &FSMo, int STo0, int SToK,
@@ -793,6 +836,9 @@ void sccc_decoder_combined(
 )
 {
 
+// trellises and workspace shared by all iterations
+flat_trellis TRi(FSMi), TRo(FSMo);
+
 //allocate space for priori, prioro and posti of inner FSM
 std::vector<float> ipriori(blocklength*FSMi.I(),0.0);
 std::vector<float> iprioro(blocklength*FSMi.O());
@@ -812,9 +858,7 @@ for(int k=0;k<blocklength;k++) {
 
 for(int rep=0;rep<iterations;rep++) {
   // run inner SISO
-  siso_algorithm(FSMi.I(),FSMi.S(),FSMi.O(),
-             FSMi.NS(), FSMi.OS(), FSMi.PS(), FSMi.PI(),
-             blocklength,
+  TRi.siso(blocklength,
              STi0,STiK,
              true, false,
              p2mymin,
@@ -833,9 +877,7 @@ for(int rep=0;rep<iterations;rep++) {
   // run outer SISO
 
   if(rep<iterations-1) { // do not produce posti
-    siso_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
-             FSMo.NS(), FSMo.OS(), FSMo.PS(), FSMo.PI(),
-             blocklength,
+    TRo.siso(blocklength,
              STo0,SToK,
              false, true,
              p2mymin,
@@ -853,9 +895,7 @@ for(int rep=0;rep<iterations;rep++) {
   }
   else // produce posti but not posto
 
-    siso_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
-             FSMo.NS(), FSMo.OS(), FSMo.PS(), FSMo.PI(),
-             blocklength,
+    TRo.siso(blocklength,
              STo0,SToK,
              true, false,
              p2mymin,
@@ -975,9 +1015,18 @@ void sccc_decoder(
       const fsm &FSMi, int STi0, int STiK,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *iprioro, T *data
+      const float *iprioro, T *data,
+      const iterative_decoder_options &options
 )
 {
+  // trellises and workspace shared by all iterations
+  flat_trellis TRi(FSMi), TRo(FSMo);
+  TRi.set_window(options.window,options.overlap);
+  TRi.set_nthreads(options.nthreads);
+  TRo.set_window(options.window,options.overlap);
+  TRo.set_nthreads(options.nthreads);
+  bool early_stop = options.stable_iterations>0 || options.check;
+
   //allocate space for priori, and posti of inner FSM
   std::vector<float> ipriori(blocklength*FSMi.I(),0.0);
   std::vector<float> iposti(blocklength*FSMi.I());
@@ -988,11 +1037,14 @@ void sccc_decoder(
   std::vector<float> oposti(blocklength*FSMo.I());
   std::vector<float> oposto(blocklength*FSMo.O());
 
+  // posti and posto of the outer FSM, and decisions, for early stopping
+  std::vector<float> opost(early_stop ? blocklength*(FSMo.I()+FSMo.O()) : 0);
+  std::vector<int> decisions(early_stop ? blocklength : 0, -1);
+  int stable=0;
+
   for(int rep=0;rep<iterations;rep++) {
     // run inner SISO
-    siso_algorithm(FSMi.I(),FSMi.S(),FSMi.O(),
-             FSMi.NS(), FSMi.OS(), FSMi.PS(), FSMi.PI(),
-             blocklength,
+    TRi.siso(blocklength,
              STi0,STiK,
              true, false,
              p2mymin,
@@ -1010,10 +1062,29 @@ void sccc_decoder(
 
     // run outer SISO
 
-    if(rep<iterations-1) { // do not produce posti
-      siso_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
-             FSMo.NS(), FSMo.OS(), FSMo.PS(), FSMo.PI(),
-             blocklength,
+    if(early_stop) { // produce both, and look at the decisions
+      TRo.siso(blocklength,
+             STo0,SToK,
+             true, true,
+             p2mymin,
+             &(opriori[0]),  &(oprioro[0]), &(opost[0])
+      );
+      for(int k=0;k<blocklength;k++) {
+        memcpy(&(oposti[k*FSMo.I()]),&(opost[k*(FSMo.I()+FSMo.O())]),FSMo.I()*sizeof(float));
+        memcpy(&(oposto[k*FSMo.O()]),&(opost[k*(FSMo.I()+FSMo.O())+FSMo.I()]),FSMo.O()*sizeof(float));
+      }
+      int changed = hard_decisions(FSMo.I(),blocklength,&(oposti[0]),&(decisions[0]));
+      if(rep==iterations-1 || converged(options,decisions,changed,stable))
+        break;
+
+      //interleave soft info outer --> inner
+      for(int k=0;k<blocklength;k++) {
+        int ki = INTERLEAVER.DEINTER()[k];
+        memcpy(&(ipriori[ki*FSMi.I()]),&(oposto[k*FSMi.I()]),FSMi.I()*sizeof(float));
+      }
+    }
+    else if(rep<iterations-1) { // do not produce posti
+      TRo.siso(blocklength,
              STo0,SToK,
              false, true,
              p2mymin,
@@ -1031,9 +1102,7 @@ void sccc_decoder(
     }
     else {// produce posti but not posto
 
-      siso_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
-             FSMo.NS(), FSMo.OS(), FSMo.PS(), FSMo.PI(),
-             blocklength,
+      TRo.siso(blocklength,
              STo0,SToK,
              true, false,
              p2mymin,
@@ -1077,7 +1146,8 @@ void sccc_decoder<unsigned char>(
       const fsm &FSMi, int STi0, int STiK,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *iprioro, unsigned char *data
+      const float *iprioro, unsigned char *data,
+      const iterative_decoder_options &options
 );
 
 template
@@ -1086,7 +1156,8 @@ void sccc_decoder<short>(
       const fsm &FSMi, int STi0, int STiK,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *iprioro, short *data
+      const float *iprioro, short *data,
+      const iterative_decoder_options &options
 );
 
 template
@@ -1095,7 +1166,8 @@ void sccc_decoder<int>(
       const fsm &FSMi, int STi0, int STiK,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *iprioro, int *data
+      const float *iprioro, int *data,
+      const iterative_decoder_options &options
 );
 
 
@@ -1107,10 +1179,22 @@ void pccc_decoder(
       const fsm &FSM2, int ST20, int ST2K,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *cprioro, T *data
+      const float *cprioro, T *data,
+      const iterative_decoder_options &options
 )
 {
 
+  // trellises and workspace shared by all iterations
+  flat_trellis TR1(FSM1), TR2(FSM2);
+  TR1.set_window(options.window,options.overlap);
+  TR1.set_nthreads(options.nthreads);
+  TR2.set_window(options.window,options.overlap);
+  TR2.set_nthreads(options.nthreads);
+  bool early_stop = options.stable_iterations>0 || options.check;
+  std::vector<float> post1(early_stop ? blocklength*FSM1.I() : 0);
+  std::vector<int> decisions(early_stop ? blocklength : 0, -1);
+  int stable=0;
+
   //allocate space for priori, prioro and posti of FSM1
   std::vector<float> priori1(blocklength*FSM1.I(),0.0);
   std::vector<float> prioro1(blocklength*FSM1.O());
@@ -1142,9 +1226,7 @@ void pccc_decoder(
 
   for(int rep=0;rep<iterations;rep++) {
     // run  SISO 1
-    siso_algorithm(FSM1.I(),FSM1.S(),FSM1.O(),
-             FSM1.NS(), FSM1.OS(), FSM1.PS(), FSM1.PI(),
-             blocklength,
+    TR1.siso(blocklength,
              ST10,ST1K,
              true, false,
              p2mymin,
@@ -1167,9 +1249,7 @@ void pccc_decoder(
     }
 
     // run SISO 2
-    siso_algorithm(FSM2.I(),FSM2.S(),FSM2.O(),
-           FSM2.NS(), FSM2.OS(), FSM2.PS(), FSM2.PI(),
-           blocklength,
+    TR2.siso(blocklength,
            ST20,ST2K,
            true, false,
            p2mymin,
@@ -1185,6 +1265,14 @@ void pccc_decoder(
       memcpy(&(priori1[ki*FSM1.I()]),&(posti2[k*FSM2.I()]),FSM1.I()*sizeof(float));
     }
 
+    if(early_stop) { // same decisions as below, without touching posti1
+      for(int k=0;k<blocklength*FSM1.I();k++)
+        post1[k] = (*p2mymin)(priori1[k],posti1[k]);
+      int changed = hard_decisions(FSM1.I(),blocklength,&(post1[0]),&(decisions[0]));
+      if(converged(options,decisions,changed,stable))
+        break;
+    }
+
   } // end iterations
 
   // generate hard decisions
@@ -1214,7 +1302,8 @@ void pccc_decoder<unsigned char>(
       const fsm &FSM2, int ST20, int ST2K,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *cprioro, unsigned char *data
+      const float *cprioro, unsigned char *data,
+      const iterative_decoder_options &options
 );
 
 template
@@ -1223,7 +1312,8 @@ void pccc_decoder<short>(
       const fsm &FSM2, int ST20, int ST2K,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *cprioro, short *data
+      const float *cprioro, short *data,
+      const iterative_decoder_options &options
 );
 
 template
@@ -1232,7 +1322,8 @@ void pccc_decoder<int>(
       const fsm &FSM2, int ST20, int ST2K,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *cprioro, int *data
+      const float *cprioro, int *data,
+      const iterative_decoder_options &options
 );
 
 
@@ -1253,6 +1344,9 @@ void pccc_decoder_combined(
 )
 {
 
+  // trellises and workspace shared by all iterations
+  flat_trellis TR1(FSM1), TR2(FSM2);
+
   //allocate space for cprioro
   std::vector<float> cprioro(blocklength*FSM1.O()*FSM2.O(),0.0);
 
@@ -1294,9 +1388,7 @@ void pccc_decoder_combined(
 
   for(int rep=0;rep<iterations;rep++) {
     // run  SISO 1
-    siso_algorithm(FSM1.I(),FSM1.S(),FSM1.O(),
-             FSM1.NS(), FSM1.OS(), FSM1.PS(), FSM1.PI(),
-             blocklength,
+    TR1.siso(blocklength,
              ST10,ST1K,
              true, false,
              p2mymin,
@@ -1319,9 +1411,7 @@ void pccc_decoder_combined(
     }
 
     // run SISO 2
-    siso_algorithm(FSM2.I(),FSM2.S(),FSM2.O(),
-           FSM2.NS(), FSM2.OS(), FSM2.PS(), FSM2.PI(),
-           blocklength,
+    TR2.siso(blocklength,
            ST20,ST2K,
            true, false,
            p2mymin,
@@ -91,13 +91,38 @@ void siso_algorithm_combined(int I, int S, int O,
 );
 
 
+/*!
+ * \brief Options of sccc_decoder and pccc_decoder.
+ *
+ * \p window, \p overlap and \p nthreads split each SISO into
+ * windows decoded in parallel (see flat_trellis::set_window).
+ *
+ * The decoder stops before \p iterations when the hard decisions
+ * have not changed for \p stable_iterations iterations in a row,
+ * or when \p check returns true for them (e.g. a CRC passes).
+ * 0 and NULL disable the two tests.
+ */
+struct iterative_decoder_options {
+  int nthreads;
+  int window;
+  int overlap;
+  int stable_iterations;
+  bool (*check)(const int *decisions, int blocklength, void *arg);
+  void *check_arg;
+
+  iterative_decoder_options()
+    : nthreads(1), window(0), overlap(0), stable_iterations(0),
+      check(0), check_arg(0) {}
+};
+
 template<class T>
 void sccc_decoder(
       const fsm &FSMo, int STo0, int SToK,
       const fsm &FSMi, int STi0, int STiK,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *iprioro, T *data
+      const float *iprioro, T *data,
+      const iterative_decoder_options &options = iterative_decoder_options()
 );
 
 
@@ -119,7 +144,8 @@ void pccc_decoder(
       const fsm &FSM2, int ST20, int ST2K,
       const interleaver &INTERLEAVER, int blocklength, int iterations,
       float (*p2mymin)(float,float),
-      const float *cprioro, T *data
+      const float *cprioro, T *data,
+      const iterative_decoder_options &options = iterative_decoder_options()
 );
 
 template<class Ti, class To>
@@ -0,0 +1,528 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <boost/bind.hpp>
+#include <gruel/thread_group.h>
+#include "flat_trellis.h"
+#include "core_algorithms.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const float INF = 1.0e9;
+
+float flat_trellis::s_min_star_table[flat_trellis::MIN_STAR_RANGE * flat_trellis::MIN_STAR_STEPS];
+float flat_trellis::s_min_star_slope[flat_trellis::MIN_STAR_RANGE * flat_trellis::MIN_STAR_STEPS];
+
+// fill the log(1+exp(-d)) table at load time
+struct min_star_table_init {
+  min_star_table_init()
+  {
+    const int N = flat_trellis::MIN_STAR_RANGE * flat_trellis::MIN_STAR_STEPS;
+    for(int n=0;n<N;n++) {
+      double d0 = (double) n / flat_trellis::MIN_STAR_STEPS;
+      double d1 = (double) (n+1) / flat_trellis::MIN_STAR_STEPS;
+      double f0 = log(1+exp(-d0));
+      double f1 = log(1+exp(-d1));
+      flat_trellis::s_min_star_table[n] = f0;
+      flat_trellis::s_min_star_slope[n] = f1-f0;
+    }
+  }
+};
+
+static min_star_table_init s_min_star_table_init;
+
+
+flat_trellis::flat_trellis(const fsm &FSM)
+{
+  init(FSM.I(),FSM.S(),FSM.O(),FSM.NS(),FSM.OS(),FSM.PS(),FSM.PI());
+}
+
+flat_trellis::flat_trellis(int I, int S, int O,
+             const std::vector<int> &NS,
+             const std::vector<int> &OS,
+             const std::vector< std::vector<int> > &PS,
+             const std::vector< std::vector<int> > &PI)
+{
+  init(I,S,O,NS,OS,PS,PI);
+}
+
+void
+flat_trellis::init(int I, int S, int O,
+             const std::vector<int> &NS,
+             const std::vector<int> &OS,
+             const std::vector< std::vector<int> > &PS,
+             const std::vector< std::vector<int> > &PI)
+{
+  d_I=I;
+  d_S=S;
+  d_O=O;
+  d_NS=NS;
+  d_OS=OS;
+
+  d_P=0;
+  d_Pmin=S>0 ? (int) PS[0].size() : 0;
+  for(int j=0;j<S;j++) {
+    int n = (int) PS[j].size();
+    if(n>d_P) d_P=n;
+    if(n<d_Pmin) d_Pmin=n;
+  }
+
+  d_PS.assign(d_P*S,0);
+  d_PI.assign(d_P*S,0);
+  d_PO.assign(d_P*S,O);
+  for(int j=0;j<S;j++) {
+    for(unsigned int p=0;p<PS[j].size();p++) {
+      d_PS[p*S+j]=PS[j][p];
+      d_PI[p*S+j]=PI[j][p];
+      d_PO[p*S+j]=OS[PS[j][p]*I+PI[j][p]];
+    }
+  }
+
+  d_NSt.resize(I*S);
+  d_OSt.resize(I*S);
+  for(int j=0;j<S;j++) {
+    for(int i=0;i<I;i++) {
+      d_NSt[i*S+j]=NS[j*I+i];
+      d_OSt[i*S+j]=OS[j*I+i];
+    }
+  }
+
+  d_window=0;
+  d_overlap=0;
+  d_nthreads=1;
+  d_ws.resize(1);
+}
+
+
+/*
+ * Compare-select of one predecessor slot into the survivors:
+ * where cand[j] < best[j], best[j] = cand[j] and idx[j] = p.
+ * Ties keep the earlier slot, as viterbi_algorithm does.
+ */
+static inline void
+argmin_fold(float *best, int *idx, const float *cand, int p, int S)
+{
+  int j=0;
+#if defined(__AVX2__)
+  __m256i pv = _mm256_set1_epi32(p);
+  for(;j+8<=S;j+=8) {
+    __m256 c = _mm256_loadu_ps(cand+j);
+    __m256 b = _mm256_loadu_ps(best+j);
+    __m256 lt = _mm256_cmp_ps(c,b,_CMP_LT_OQ);
+    __m256i ix = _mm256_loadu_si256((const __m256i *)(idx+j));
+    _mm256_storeu_ps(best+j,_mm256_min_ps(c,b));
+    ix = _mm256_blendv_epi8(ix,pv,_mm256_castps_si256(lt));
+    _mm256_storeu_si256((__m256i *)(idx+j),ix);
+  }
+#elif defined(__SSE2__)
+  __m128i pv = _mm_set1_epi32(p);
+  for(;j+4<=S;j+=4) {
+    __m128 c = _mm_loadu_ps(cand+j);
+    __m128 b = _mm_loadu_ps(best+j);
+    __m128i lt = _mm_castps_si128(_mm_cmplt_ps(c,b));
+    __m128i ix = _mm_loadu_si128((const __m128i *)(idx+j));
+    _mm_storeu_ps(best+j,_mm_min_ps(c,b));
+    ix = _mm_or_si128(_mm_and_si128(lt,pv),_mm_andnot_si128(lt,ix));
+    _mm_storeu_si128((__m128i *)(idx+j),ix);
+  }
+#endif
+  for(;j<S;j++) {
+    if(cand[j]<best[j]) {
+      best[j]=cand[j];
+      idx[j]=p;
+    }
+  }
+}
+
+
+/*
+ * The combining operators of the SISO.  fold() does
+ * acc[j] = op(acc[j],cand[j]) for every j; reduce() folds cand[]
+ * into one value starting from INF, in index order.
+ */
+struct min_op {
+  float operator()(float a, float b) const { return a <= b ? a : b; }
+
+  void fold(float *acc, const float *cand, int n) const
+  {
+    int j=0;
+#if defined(__AVX2__)
+    for(;j+8<=n;j+=8)
+      _mm256_storeu_ps(acc+j,_mm256_min_ps(_mm256_loadu_ps(cand+j),_mm256_loadu_ps(acc+j)));
+#elif defined(__SSE2__)
+    for(;j+4<=n;j+=4)
+      _mm_storeu_ps(acc+j,_mm_min_ps(_mm_loadu_ps(cand+j),_mm_loadu_ps(acc+j)));
+#endif
+    for(;j<n;j++)
+      acc[j]=(*this)(acc[j],cand[j]);
+  }
+
+  float reduce(const float *cand, int n) const
+  {
+    // the smallest value does not depend on the order of the scan
+    int j=0;
+    float m=INF;
+#if defined(__SSE2__)
+    if(n>=4) {
+      __m128 mv = _mm_set1_ps(INF);
+      for(;j+4<=n;j+=4)
+        mv=_mm_min_ps(_mm_loadu_ps(cand+j),mv);
+      mv=_mm_min_ps(mv,_mm_movehl_ps(mv,mv));
+      mv=_mm_min_ss(mv,_mm_shuffle_ps(mv,mv,1));
+      m=_mm_cvtss_f32(mv);
+    }
+#endif
+    for(;j<n;j++)
+      m=(*this)(m,cand[j]);
+    return m;
+  }
+};
+
+struct min_star_op {
+  float operator()(float a, float b) const { return flat_trellis::min_star(a,b); }
+
+  void fold(float *acc, const float *cand, int n) const
+  {
+    for(int j=0;j<n;j++)
+      acc[j]=flat_trellis::min_star(acc[j],cand[j]);
+  }
+
+  float reduce(const float *cand, int n) const
+  {
+    float m=INF;
+    for(int j=0;j<n;j++)
+      m=flat_trellis::min_star(m,cand[j]);
+    return m;
+  }
+};
+
+struct pointer_op {
+  float (*d_f)(float,float);
+  pointer_op(float (*f)(float,float)) : d_f(f) {}
+
+  float operator()(float a, float b) const { return (*d_f)(a,b); }
+
+  void fold(float *acc, const float *cand, int n) const
+  {
+    for(int j=0;j<n;j++)
+      acc[j]=(*d_f)(acc[j],cand[j]);
+  }
+
+  float reduce(const float *cand, int n) const
+  {
+    float m=INF;
+    for(int j=0;j<n;j++)
+      m=(*d_f)(m,cand[j]);
+    return m;
+  }
+};
+
+
+// subtract the smallest of x[0..n-1] from all of them
+static inline void
+normalize(float *x, int n)
+{
+  float norm=INF;
+  for(int j=0;j<n;j++)
+    if(x[j]<norm) norm=x[j];
+  for(int j=0;j<n;j++)
+    x[j]-=norm;
+}
+
+
+template<class T>
+void
+flat_trellis::viterbi(int K, int S0, int SK, const float *in, T *out)
+{
+  const int S=d_S;
+  const int O=d_O;
+
+  workspace &ws=d_ws[0];
+  d_trace.resize(S*K);
+  ws.alpha.resize(S*2);
+  ws.cand.resize(S);
+  float *alpha=&ws.alpha[0];
+  float *alphan=&ws.alpha[S];
+  float *cand=&ws.cand[0];
+
+  if(S0<0) { // initial state not specified
+      for(int j=0;j<S;j++) alpha[j]=0;
+  }
+  else {
+      for(int j=0;j<S;j++) alpha[j]=INF;
+      alpha[S0]=0.0;
+  }
+
+  for(int k=0;k<K;k++) {
+      const float *gamma=&in[k*O];
+      int *trace=&d_trace[k*S];
+
+      for(int j=0;j<S;j++) {
+          alphan[j]=INF;
+          trace[j]=0;
+      }
+      for(int p=0;p<d_P;p++) { // add-compare-select, one slot at a time
+          const int *ps=&d_PS[p*S];
+          const int *po=&d_PO[p*S];
+          if(p<d_Pmin) {
+              for(int j=0;j<S;j++)
+                  cand[j]=alpha[ps[j]]+gamma[po[j]];
+          }
+          else {
+              for(int j=0;j<S;j++)
+                  cand[j]=(po[j]==O ? INF : alpha[ps[j]]+gamma[po[j]]);
+          }
+          argmin_fold(alphan,trace,cand,p,S);
+      }
+      normalize(alphan,S); // so the metrics do not explode
+      std::swap(alpha,alphan);
+  }
+
+  int st;
+  if(SK<0) { // final state not specified
+      float minm=INF;
+      st=0;
+      for(int j=0;j<S;j++)
+          if(alpha[j]<minm) minm=alpha[j],st=j;
+  }
+  else {
+      st=SK;
+  }
+
+  for(int k=K-1;k>=0;k--) { // traceback
+      int p=d_trace[k*S+st];
+      out[k]=(T) d_PI[p*S+st];
+      st=d_PS[p*S+st];
+  }
+}
+
+template
+void flat_trellis::viterbi<unsigned char>(int K, int S0, int SK, const float *in, unsigned char *out);
+
+template
+void flat_trellis::viterbi<short>(int K, int S0, int SK, const float *in, short *out);
+
+template
+void flat_trellis::viterbi<int>(int K, int S0, int SK, const float *in, int *out);
+
+
+void
+flat_trellis::set_window(int window, int overlap)
+{
+  d_window = window > 0 ? window : 0;
+  d_overlap = overlap > 0 ? overlap : 0;
+}
+
+void
+flat_trellis::set_nthreads(int nthreads)
+{
+  d_nthreads = nthreads > 1 ? nthreads : 1;
+  if((int) d_ws.size() < d_nthreads)
+    d_ws.resize(d_nthreads);
+}
+
+void
+flat_trellis::siso(int K, int S0, int SK,
+             bool POSTI, bool POSTO,
+             float (*p2mymin)(float,float),
+             const float *priori, const float *prioro, float *post)
+{
+  if(!POSTI && !POSTO)
+    throw std::runtime_error ("Not both POSTI and POSTO can be false.");
+
+  siso_job job;
+  job.K=K;
+  job.S0=S0;
+  job.SK=SK;
+  job.POSTI=POSTI;
+  job.POSTO=POSTO;
+  job.priori=priori;
+  job.prioro=prioro;
+  job.post=post;
+  job.W=(d_window>0 && d_window<K) ? d_window : K;
+
+  if(p2mymin==&::min)
+    siso_run(min_op(),job);
+  else if(p2mymin==&::min_star)
+    siso_run(min_star_op(),job);
+  else
+    siso_run(pointer_op(p2mymin),job);
+}
+
+template<class OP>
+void
+flat_trellis::siso_run(const OP &op, const siso_job &job)
+{
+  int nwindows = job.W>0 ? (job.K+job.W-1)/job.W : 0;
+  int nthreads = std::min(d_nthreads,nwindows);
+
+  if(nthreads<=1) {
+    siso_windows(op,job,0,1);
+    return;
+  }
+
+  // thread t decodes windows t, t+nthreads, ... with workspace t
+  gruel::thread_group threads;
+  for(int t=1;t<nthreads;t++)
+    threads.create_thread(boost::bind(&flat_trellis::siso_windows<OP>,this,
+                                      boost::cref(op),boost::cref(job),t,nthreads));
+  siso_windows(op,job,0,nthreads);
+  threads.join_all();
+}
+
+template<class OP>
+void
+flat_trellis::siso_windows(const OP &op, const siso_job &job, int first, int step)
+{
+  for(int k0=first*job.W;k0<job.K;k0+=step*job.W)
+    siso_window(op,d_ws[first],job,k0,std::min(job.K,k0+job.W));
+}
+
+/*
+ * SISO over trellis steps [k0,k1).  Inside the block the recursions
+ * start d_overlap steps outside the window from equiprobable states;
+ * at the block edges they start from S0 and SK.  With a single window
+ * this is exactly the full-block SISO.
+ */
+template<class OP>
+void
+flat_trellis::siso_window(const OP &op, workspace &ws, const siso_job &job, int k0, int k1)
+{
+  const int I=d_I;
+  const int S=d_S;
+  const int O=d_O;
+  const float *priori=job.priori;
+  const float *prioro=job.prioro;
+
+  int a0=std::max(0,k0-d_overlap);
+  int b1=std::min(job.K,k1+d_overlap);
+
+  // alpha[(k-a0)*S] for k in [a0,k1), beta[(k-k0)*S] for k in (k0,b1]
+  ws.alpha.resize(S*(k1-a0));
+  ws.beta.resize(S*(b1-k0+1));
+  ws.cand.resize(S);
+  ws.acc.resize(O);
+  float *cand=&ws.cand[0];
+
+  float *alpha=&ws.alpha[0];
+  if(a0>0 || job.S0<0) { // initial state not specified
+      for(int j=0;j<S;j++) alpha[j]=0;
+  }
+  else {
+      for(int j=0;j<S;j++) alpha[j]=INF;
+      alpha[job.S0]=0.0;
+  }
+
+  for(int k=a0;k+1<k1;k++) { // forward recursion
+      const float *a=&ws.alpha[(k-a0)*S];
+      float *an=&ws.alpha[(k+1-a0)*S];
+      const float *pri=&priori[k*I];
+      const float *pro=&prioro[k*O];
+
+      for(int j=0;j<S;j++) an[j]=INF;
+      for(int p=0;p<d_P;p++) {
+          const int *ps=&d_PS[p*S];
+          const int *pi=&d_PI[p*S];
+          const int *po=&d_PO[p*S];
+          if(p<d_Pmin) {
+              for(int j=0;j<S;j++)
+                  cand[j]=a[ps[j]]+pri[pi[j]]+pro[po[j]];
+          }
+          else {
+              for(int j=0;j<S;j++)
+                  cand[j]=(po[j]==O ? INF : a[ps[j]]+pri[pi[j]]+pro[po[j]]);
+          }
+          op.fold(an,cand,S);
+      }
+      normalize(an,S);
+  }
+
+  float *beta=&ws.beta[(b1-k0)*S];
+  if(b1<job.K || job.SK<0) { // final state not specified
+      for(int j=0;j<S;j++) beta[j]=0;
+  }
+  else {
+      for(int j=0;j<S;j++) beta[j]=INF;
+      beta[job.SK]=0.0;
+  }
+
+  for(int k=b1-1;k>k0;k--) { // backward recursion
+      const float *b1p=&ws.beta[(k+1-k0)*S];
+      float *b=&ws.beta[(k-k0)*S];
+      const float *pro=&prioro[k*O];
+
+      for(int j=0;j<S;j++) b[j]=INF;
+      for(int i=0;i<I;i++) {
+          const int *ns=&d_NSt[i*S];
+          const int *os=&d_OSt[i*S];
+          float pi=priori[k*I+i];
+          for(int j=0;j<S;j++)
+              cand[j]=b1p[ns[j]]+pi+pro[os[j]];
+          op.fold(b,cand,S);
+      }
+      normalize(b,S);
+  }
+
+  const int stride = (job.POSTI ? I : 0) + (job.POSTO ? O : 0);
+  for(int k=k0;k<k1;k++) {
+      const float *a=&ws.alpha[(k-a0)*S];
+      const float *b1p=&ws.beta[(k+1-k0)*S];
+      const float *pri=&priori[k*I];
+      const float *pro=&prioro[k*O];
+
+      if(job.POSTI) { // input combining
+          float *pi=&job.post[k*stride];
+          for(int i=0;i<I;i++) {
+              const int *ns=&d_NSt[i*S];
+              const int *os=&d_OSt[i*S];
+              for(int j=0;j<S;j++)
+                  cand[j]=a[j]+pro[os[j]]+b1p[ns[j]];
+              pi[i]=op.reduce(cand,S);
+          }
+          normalize(pi,I);
+      }
+
+      if(job.POSTO) { // output combining
+          // Each branch only contributes to its own output symbol, so
+          // fold the branches straight into their symbols in (j,i)
+          // order instead of scanning all of them for every symbol.
+          float *po=&job.post[k*stride+(job.POSTI ? I : 0)];
+          float *acc=&ws.acc[0];
+          for(int n=0;n<O;n++) acc[n]=INF;
+          for(int j=0;j<S;j++) {
+              const int *ns=&d_NS[j*I];
+              const int *os=&d_OS[j*I];
+              for(int i=0;i<I;i++)
+                  acc[os[i]]=op(acc[os[i]],a[j]+pri[i]+b1p[ns[i]]);
+          }
+          for(int n=0;n<O;n++) po[n]=acc[n];
+          normalize(po,O);
+      }
+  }
+}
@@ -0,0 +1,175 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_TRELLIS_FLAT_TRELLIS_H
+#define INCLUDED_TRELLIS_FLAT_TRELLIS_H
+
+#include <trellis_api.h>
+#include <vector>
+#include "fsm.h"
+
+/*!
+ * \brief Trellis of an FSM laid out for the Viterbi and SISO recursions.
+ *
+ * The nested PS/PI vectors of an fsm are flattened into slot-major
+ * arrays (entry p*S+j is the p-th predecessor of state j) and the
+ * NS/OS tables are transposed to input-major order, so that the
+ * add-compare-select steps run across all states at once.  States
+ * with fewer predecessors than the largest fan-in are padded with a
+ * branch that can never win.
+ *
+ * The metric and traceback buffers are kept between calls, so one
+ * instance should be kept per block (or per decoder) and reused.
+ * The results are the same as those of viterbi_algorithm and
+ * siso_algorithm, unless the SISO is split into windows.
+ */
+class TRELLIS_API flat_trellis {
+private:
+  int d_I;
+  int d_S;
+  int d_O;
+  int d_P;        // largest number of predecessors of a state
+  int d_Pmin;     // smallest number of predecessors of a state
+  std::vector<int> d_NS;
+  std::vector<int> d_OS;
+  std::vector<int> d_NSt;   // d_NSt[i*S+j] = NS[j*I+i]
+  std::vector<int> d_OSt;   // d_OSt[i*S+j] = OS[j*I+i]
+  std::vector<int> d_PS;    // d_PS[p*S+j] = PS[j][p]
+  std::vector<int> d_PI;    // d_PI[p*S+j] = PI[j][p]
+  std::vector<int> d_PO;    // output symbol of that branch, O if padding
+
+  int d_window;
+  int d_overlap;
+  int d_nthreads;
+
+  // workspace, one per SISO thread
+  struct workspace {
+    std::vector<float> alpha;
+    std::vector<float> beta;
+    std::vector<float> cand;
+    std::vector<float> acc;
+  };
+  std::vector<workspace> d_ws;
+  std::vector<int> d_trace;
+
+  struct siso_job {
+    int K, S0, SK;
+    bool POSTI, POSTO;
+    const float *priori;
+    const float *prioro;
+    float *post;
+    int W;        // window length
+  };
+
+  void init(int I, int S, int O,
+            const std::vector<int> &NS,
+            const std::vector<int> &OS,
+            const std::vector< std::vector<int> > &PS,
+            const std::vector< std::vector<int> > &PI);
+
+  template<class OP>
+  void siso_run(const OP &op, const siso_job &job);
+  template<class OP>
+  void siso_windows(const OP &op, const siso_job &job, int first, int step);
+  template<class OP>
+  void siso_window(const OP &op, workspace &ws, const siso_job &job, int k0, int k1);
+
+public:
+  flat_trellis(const fsm &FSM);
+  flat_trellis(int I, int S, int O,
+               const std::vector<int> &NS,
+               const std::vector<int> &OS,
+               const std::vector< std::vector<int> > &PS,
+               const std::vector< std::vector<int> > &PI);
+
+  int I() const { return d_I; }
+  int S() const { return d_S; }
+  int O() const { return d_O; }
+
+  /*!
+   * \brief Viterbi decoding of \p K steps.
+   *
+   * \p in holds K*O() branch metrics, \p out receives K input
+   * symbols.  A negative \p S0 or \p SK leaves the initial or final
+   * state unspecified.  Same as viterbi_algorithm.
+   */
+  template<class T>
+  void viterbi(int K, int S0, int SK, const float *in, T *out);
+
+  /*!
+   * \brief Split the SISO into windows of \p window steps.
+   *
+   * Each window runs its forward and backward recursions from \p
+   * overlap steps outside of it, starting from equiprobable states,
+   * so windows can be decoded independently.  The result is an
+   * approximation that improves with \p overlap; a few constraint
+   * lengths is usually enough.  0 (the default) decodes the whole
+   * block as one window, exactly as siso_algorithm does.
+   */
+  void set_window(int window, int overlap);
+  int window() const { return d_window; }
+  int overlap() const { return d_overlap; }
+
+  /*!
+   * \brief Decode the SISO windows on up to \p nthreads threads.
+   * Only has an effect together with set_window.
+   */
+  void set_nthreads(int nthreads);
+  int nthreads() const { return d_nthreads; }
+
+  /*!
+   * \brief Soft-in soft-out decoding of \p K steps.
+   *
+   * Same arguments and output layout as siso_algorithm.  min and
+   * min_star run inlined; any other \p p2mymin is called through
+   * the pointer, and must then be safe to call from several threads.
+   */
+  void siso(int K, int S0, int SK,
+            bool POSTI, bool POSTO,
+            float (*p2mymin)(float,float),
+            const float *priori, const float *prioro, float *post);
+
+  /*!
+   * \brief min_star(a,b) = min(a,b) - log(1+exp(-|a-b|)), with the
+   * correction term read from a table.  Absolute error below 2e-4.
+   */
+  static inline float min_star(float a, float b)
+  {
+    float m = a <= b ? a : b;
+    float d = a <= b ? b - a : a - b;
+    if (!(d < MIN_STAR_RANGE))
+      return m;
+    float x = d * MIN_STAR_STEPS;
+    int n = (int) x;
+    return m - (s_min_star_table[n] + (x - n) * s_min_star_slope[n]);
+  }
+
+  static const int MIN_STAR_STEPS = 32;   // table entries per unit of |a-b|
+  static const int MIN_STAR_RANGE = 16;   // correction is taken as 0 beyond this
+
+private:
+  static float s_min_star_table[MIN_STAR_RANGE * MIN_STAR_STEPS];
+  static float s_min_star_slope[MIN_STAR_RANGE * MIN_STAR_STEPS];
+  friend struct min_star_table_init;
+};
+
+#endif
@@ -0,0 +1,147 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2012 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Checks flat_trellis against viterbi_algorithm/siso_algorithm on
+ * random FSMs and random metrics.
+ *
+ * - Viterbi: the decoded symbols must be identical.
+ * - SISO with min: the outputs must be identical.
+ * - SISO with the table min_star on both sides: |a-b| <= 1e-5 * (1+|b|).
+ *   The results match exactly here, but flat_trellis inlines min_star,
+ *   so the compiler may contract its interpolation into an FMA there
+ *   and not in the out-of-line copy.
+ * - flat_trellis with the table min_star against siso_algorithm with
+ *   the exact log/exp min_star: |a-b| <= 1e-3 * (1+|b|).  The table is
+ *   off by less than 2e-4 per min_star; the largest difference seen
+ *   is 1e-4.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "fsm.h"
+#include "core_algorithms.h"
+#include "flat_trellis.h"
+
+#define NFSMS		200	// random FSMs tried
+#define K		100	// trellis steps per block
+
+static const float SISO_MIN_STAR_TOL = 1e-5;
+static const float SISO_EXACT_TOL = 1e-3;
+
+// min_star as it was computed before the table
+static float
+log_min_star (float a, float b)
+{
+  return (a <= b ? a : b)-log(1+exp(a <= b ? a-b : b-a));
+}
+
+static float
+uniform (float scale)
+{
+  return scale * random () / RAND_MAX;
+}
+
+static fsm
+random_fsm ()
+{
+  int I = 1 + random () % 4;
+  int S = 1 + random () % 16;
+  int O = 1 + random () % 8;
+  std::vector<int> NS (I*S), OS (I*S);
+  for (int i = 0; i < I*S; i++){
+    NS[i] = random () % S;
+    OS[i] = random () % O;
+  }
+  // input 0 walks all states in a cycle, so every state is reachable
+  for (int s = 0; s < S; s++)
+    NS[s*I] = (s + 1) % S;
+  return fsm (I, S, O, NS, OS);
+}
+
+static int
+compare (const char *what, int n, const std::vector<float> &a,
+	 const std::vector<float> &b, float tol)
+{
+  for (unsigned int i = 0; i < a.size (); i++){
+    if (!(fabs (a[i] - b[i]) <= tol * (1 + fabs (b[i])))){
+      printf ("fsm %d: %s differs at %u: %g vs %g\n", n, what, i, a[i], b[i]);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int
+main (int argc, char **argv)
+{
+  int nerrors = 0;
+
+  srandom (42);
+  for (int n = 0; n < NFSMS; n++){
+    fsm FSM = random_fsm ();
+    int I = FSM.I (), S = FSM.S (), O = FSM.O ();
+    flat_trellis T (FSM);
+
+    std::vector<float> in (K*O), priori (K*I), post1 (K*(I+O)), post2 (K*(I+O));
+    for (unsigned int i = 0; i < in.size (); i++)
+      in[i] = uniform (4.0);
+    for (unsigned int i = 0; i < priori.size (); i++)
+      priori[i] = uniform (1.0);
+
+    // with and without fixed initial and final states
+    int S0 = n % 2 ? -1 : random () % S;
+    int SK = n % 3 ? -1 : random () % S;
+
+    std::vector<int> out1 (K), out2 (K);
+    viterbi_algorithm (I, S, O, FSM.NS (), FSM.OS (), FSM.PS (), FSM.PI (),
+		       K, S0, SK, &in[0], &out1[0]);
+    T.viterbi (K, S0, SK, &in[0], &out2[0]);
+    if (out1 != out2){
+      printf ("fsm %d: viterbi differs\n", n);
+      nerrors++;
+    }
+
+    siso_algorithm (I, S, O, FSM.NS (), FSM.OS (), FSM.PS (), FSM.PI (),
+		    K, S0, SK, true, true, &min, &priori[0], &in[0], &post1[0]);
+    T.siso (K, S0, SK, true, true, &min, &priori[0], &in[0], &post2[0]);
+    nerrors += compare ("siso min", n, post2, post1, 0);
+
+    siso_algorithm (I, S, O, FSM.NS (), FSM.OS (), FSM.PS (), FSM.PI (),
+		    K, S0, SK, true, true, &min_star, &priori[0], &in[0], &post1[0]);
+    T.siso (K, S0, SK, true, true, &min_star, &priori[0], &in[0], &post2[0]);
+    nerrors += compare ("siso min_star", n, post2, post1, SISO_MIN_STAR_TOL);
+
+    siso_algorithm (I, S, O, FSM.NS (), FSM.OS (), FSM.PS (), FSM.PI (),
+		    K, S0, SK, true, true, &log_min_star, &priori[0], &in[0], &post1[0]);
+    nerrors += compare ("siso exact min_star", n, post2, post1, SISO_EXACT_TOL);
+  }
+
+  if (nerrors)
+    printf ("%d mismatches\n", nerrors);
+  return nerrors ? 1 : 0;
+}
@@ -80,9 +80,7 @@ for (unsigned int m=0;m<nstreams;m++) {
   const gr_complex *in = (gr_complex *) input_items[m];
   float *out = (float *) output_items[m];
 
-  for (unsigned int i = 0; i < noutput_items / d_O ; i++){
-    d_constellation->calc_metric(&(in[i*d_D]), &(out[i*d_O]), d_TYPE);
-  }
+  d_constellation->calc_metric_n(in, out, d_TYPE, noutput_items / d_O);
 }
 
   consume_each (d_D * noutput_items / d_O);
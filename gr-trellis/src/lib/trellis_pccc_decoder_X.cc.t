@@ -71,7 +71,11 @@ trellis_make_@BASE_NAME@ (
   d_INTERLEAVER (INTERLEAVER),
   d_blocklength (blocklength),
   d_repetitions (repetitions),
-  d_SISO_TYPE (SISO_TYPE)
+  d_SISO_TYPE (SISO_TYPE),
+  d_window (0),
+  d_overlap (0),
+  d_nthreads (1),
+  d_stable_iterations (0)
 {
     assert(d_FSM1.I() == d_FSM2.I());
     set_relative_rate (1.0 / ((double) d_FSM1.O() * d_FSM2.O()));
@@ -89,6 +93,15 @@ void
 
 
 
+void
+@NAME@::set_window (int window, int overlap, int nthreads)
+{
+  d_window = window;
+  d_overlap = overlap;
+  d_nthreads = nthreads;
+}
+
+
 //===========================================================
 
 int
@@ -106,6 +119,11 @@ int
   else if(d_SISO_TYPE == TRELLIS_SUM_PRODUCT)
     p2min = &min_star;
 
+  iterative_decoder_options options;
+  options.window = d_window;
+  options.overlap = d_overlap;
+  options.nthreads = d_nthreads;
+  options.stable_iterations = d_stable_iterations;
 
   const float *in = (const float *) input_items[0];
   @O_TYPE@ *out = (@O_TYPE@ *) output_items[0];
@@ -115,7 +133,8 @@ int
       d_FSM2, d_ST20, d_ST2K,
       d_INTERLEAVER, d_blocklength, d_repetitions,
       p2min,
-      &(in[n*d_blocklength*d_FSM1.O()*d_FSM2.O()]),&(out[n*d_blocklength])
+      &(in[n*d_blocklength*d_FSM1.O()*d_FSM2.O()]),&(out[n*d_blocklength]),
+      options
     );
   }
 
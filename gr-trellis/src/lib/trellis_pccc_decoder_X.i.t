@@ -57,4 +57,10 @@ public:
   int blocklength () const { return d_blocklength; }
   int repetitions () const { return d_repetitions; }
   trellis_siso_type_t SISO_TYPE () const { return d_SISO_TYPE; }
+  void set_window (int window, int overlap, int nthreads);
+  int window () const { return d_window; }
+  int overlap () const { return d_overlap; }
+  int nthreads () const { return d_nthreads; }
+  void set_stable_iterations (int stable) { d_stable_iterations = stable; }
+  int stable_iterations () const { return d_stable_iterations; }
 };
@@ -61,6 +61,10 @@ class TRELLIS_API @NAME@ : public gr_block
   int d_repetitions;
   trellis_siso_type_t d_SISO_TYPE;
   std::vector<float> d_buffer;
+  int d_window;
+  int d_overlap;
+  int d_nthreads;
+  int d_stable_iterations;
 
   friend TRELLIS_API @SPTR_NAME@ trellis_make_@BASE_NAME@ (
     const fsm &FSMo, int STo0, int SToK,
@@ -92,6 +96,24 @@ public:
   int repetitions () const { return d_repetitions; }
   trellis_siso_type_t SISO_TYPE () const { return d_SISO_TYPE; }
 
+  /*!
+   * \brief Decode each SISO in windows of \p window trellis steps,
+   * with \p overlap steps of warm-up on each side, on up to
+   * \p nthreads threads.  window 0 (the default) decodes whole blocks.
+   */
+  void set_window (int window, int overlap, int nthreads);
+  int window () const { return d_window; }
+  int overlap () const { return d_overlap; }
+  int nthreads () const { return d_nthreads; }
+
+  /*!
+   * \brief Stop iterating on a block once its hard decisions have not
+   * changed for \p stable iterations.  0 (the default) always runs
+   * all repetitions.
+   */
+  void set_stable_iterations (int stable) { d_stable_iterations = stable; }
+  int stable_iterations () const { return d_stable_iterations; }
+
   void forecast (int noutput_items,
                  gr_vector_int &ninput_items_required);
   int general_work (int noutput_items,
@@ -63,6 +63,7 @@ trellis_siso_combined_f::trellis_siso_combined_f (
 			  gr_make_io_signature (1, -1, sizeof (float)),
 			  gr_make_io_signature (1, -1, sizeof (float))),
   d_FSM (FSM),
+  d_trellis (FSM),
   d_K (K),
   d_S0 (S0),
   d_SK (SK),
@@ -71,7 +72,8 @@ trellis_siso_combined_f::trellis_siso_combined_f (
   d_SISO_TYPE (SISO_TYPE),
   d_D (D),
   d_TABLE (TABLE),
-  d_TYPE (TYPE)//,
+  d_TYPE (TYPE),
+  d_metric (FSM.O()*K)//,
   //d_alpha(FSM.S()*(K+1)),
   //d_beta(FSM.S()*(K+1))
 {
@@ -335,13 +337,12 @@ trellis_siso_combined_f::general_work (int noutput_items,
     const float *in2 = (const float *) input_items[2*m+1];
     float *out = (float *) output_items[m];
     for (int n=0;n<nblocks;n++) {
-      siso_algorithm_combined(d_FSM.I(),d_FSM.S(),d_FSM.O(),
-        d_FSM.NS(),d_FSM.OS(),d_FSM.PS(),d_FSM.PI(),
-        d_K,d_S0,d_SK,
+      for (int k=0;k<d_K;k++)
+        calc_metric(d_FSM.O(),d_D,d_TABLE,&(in2[(n*d_K+k)*d_D]),&(d_metric[k*d_FSM.O()]),d_TYPE);
+      d_trellis.siso(d_K,d_S0,d_SK,
         d_POSTI,d_POSTO,
         p2min,
-        d_D,d_TABLE,d_TYPE,
-        &(in1[n*d_K*d_FSM.I()]),&(in2[n*d_K*d_D]),
+        &(in1[n*d_K*d_FSM.I()]),&(d_metric[0]),
         &(out[n*d_K*multiple])//,
         //d_alpha,d_beta
         );
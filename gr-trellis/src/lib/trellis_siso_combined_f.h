@@ -28,6 +28,7 @@
 #include "siso_type.h"
 #include "calc_metric.h"
 #include "core_algorithms.h"
+#include "flat_trellis.h"
 #include <gr_block.h>
 
 class trellis_siso_combined_f;
@@ -52,6 +53,7 @@ TRELLIS_API trellis_siso_combined_f_sptr trellis_make_siso_combined_f (
 class TRELLIS_API trellis_siso_combined_f : public gr_block
 {
   fsm d_FSM;
+  flat_trellis d_trellis;
   int d_K;
   int d_S0;
   int d_SK;
@@ -61,6 +63,7 @@ class TRELLIS_API trellis_siso_combined_f : public gr_block
   int d_D;
   std::vector<float> d_TABLE;
   trellis_metric_type_t d_TYPE;
+  std::vector<float> d_metric;
   //std::vector<float> d_alpha;
   //std::vector<float> d_beta;
 
@@ -57,6 +57,7 @@ trellis_siso_f::trellis_siso_f (
 			  gr_make_io_signature (1, -1, sizeof (float)),
 			  gr_make_io_signature (1, -1, sizeof (float))),
   d_FSM (FSM),
+  d_trellis (FSM),
   d_K (K),
   d_S0 (S0),
   d_SK (SK),
@@ -317,9 +318,7 @@ trellis_siso_f::general_work (int noutput_items,
     const float *in2 = (const float *) input_items[2*m+1];
     float *out = (float *) output_items[m];
     for (int n=0;n<nblocks;n++) {
-      siso_algorithm(d_FSM.I(),d_FSM.S(),d_FSM.O(),
-        d_FSM.NS(),d_FSM.OS(),d_FSM.PS(),d_FSM.PI(),
-        d_K,d_S0,d_SK,
+      d_trellis.siso(d_K,d_S0,d_SK,
         d_POSTI,d_POSTO,
         p2min,
         &(in1[n*d_K*d_FSM.I()]),&(in2[n*d_K*d_FSM.O()]),
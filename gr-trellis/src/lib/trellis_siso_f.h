@@ -27,6 +27,7 @@
 #include "fsm.h"
 #include "siso_type.h"
 #include "core_algorithms.h"
+#include "flat_trellis.h"
 #include <gr_block.h>
 
 class trellis_siso_f;
@@ -49,6 +50,7 @@ TRELLIS_API trellis_siso_f_sptr trellis_make_siso_f (
 class TRELLIS_API trellis_siso_f : public gr_block
 {
   fsm d_FSM;
+  flat_trellis d_trellis;
   int d_K;
   int d_S0;
   int d_SK;
@@ -52,6 +52,7 @@ trellis_make_@BASE_NAME@ (
 			  gr_make_io_signature (1, -1, sizeof (float)),
 			  gr_make_io_signature (1, -1, sizeof (@TYPE@))),
   d_FSM (FSM),
+  d_trellis (FSM),
   d_K (K),
   d_S0 (S0),
   d_SK (SK)//,
@@ -174,7 +175,7 @@ int
     const float *in = (const float *) input_items[m];
     @TYPE@ *out = (@TYPE@ *) output_items[m];
     for (int n=0;n<nblocks;n++) {
-      viterbi_algorithm(d_FSM.I(),d_FSM.S(),d_FSM.O(),d_FSM.NS(),d_FSM.OS(),d_FSM.PS(),d_FSM.PI(),d_K,d_S0,d_SK,&(in[n*d_K*d_FSM.O()]),&(out[n*d_K]));//,d_trace);
+      d_trellis.viterbi(d_K,d_S0,d_SK,&(in[n*d_K*d_FSM.O()]),&(out[n*d_K]));
     }
   }
 
@@ -29,6 +29,7 @@
 #include "fsm.h"
 #include <gr_block.h>
 #include "core_algorithms.h"
+#include "flat_trellis.h"
 
 class @NAME@;
 typedef boost::shared_ptr<@NAME@> @SPTR_NAME@;
@@ -47,6 +48,7 @@ TRELLIS_API @SPTR_NAME@ trellis_make_@BASE_NAME@ (
 class TRELLIS_API @NAME@ : public gr_block
 {
   fsm d_FSM;
+  flat_trellis d_trellis;
   int d_K;
   int d_S0;
   int d_SK;
@@ -58,12 +58,14 @@ trellis_make_@BASE_NAME@ (
 			  gr_make_io_signature (1, -1, sizeof (@I_TYPE@)),
 			  gr_make_io_signature (1, -1, sizeof (@O_TYPE@))),
   d_FSM (FSM),
+  d_trellis (FSM),
   d_K (K),
   d_S0 (S0),
   d_SK (SK),
   d_D (D),
   d_TABLE (TABLE),
-  d_TYPE (TYPE)//,
+  d_TYPE (TYPE),
+  d_metric (FSM.O()*K)//,
   //d_trace(FSM.S()*K)
 {
     set_relative_rate (1.0 / ((double) d_D));
@@ -182,7 +184,9 @@ int
     const @I_TYPE@ *in = (const @I_TYPE@ *) input_items[m];
     @O_TYPE@ *out = (@O_TYPE@ *) output_items[m];
     for (int n=0;n<nblocks;n++) {
-      viterbi_algorithm_combined(d_FSM.I(),d_FSM.S(),d_FSM.O(),d_FSM.NS(),d_FSM.OS(),d_FSM.PS(),d_FSM.PI(),d_K,d_S0,d_SK,d_D,d_TABLE,d_TYPE,&(in[n*d_K*d_D]),&(out[n*d_K]));//,d_trace);
+      for (int k=0;k<d_K;k++)
+        calc_metric(d_FSM.O(),d_D,d_TABLE,&(in[(n*d_K+k)*d_D]),&(d_metric[k*d_FSM.O()]),d_TYPE);
+      d_trellis.viterbi(d_K,d_S0,d_SK,&(d_metric[0]),&(out[n*d_K]));
     }
   }
 
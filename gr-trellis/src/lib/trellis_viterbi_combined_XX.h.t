@@ -30,6 +30,7 @@
 #include <gr_block.h>
 #include "calc_metric.h"
 #include "core_algorithms.h"
+#include "flat_trellis.h"
 
 class @NAME@;
 typedef boost::shared_ptr<@NAME@> @SPTR_NAME@;
@@ -50,12 +51,14 @@ TRELLIS_API @SPTR_NAME@ trellis_make_@BASE_NAME@ (
 class TRELLIS_API @NAME@ : public gr_block
 {
   fsm d_FSM;
+  flat_trellis d_trellis;
   int d_K;
   int d_S0;
   int d_SK;
   int d_D;
   std::vector<@I_TYPE@> d_TABLE;
   trellis_metric_type_t d_TYPE;
+  std::vector<float> d_metric;
   //std::vector<int> d_trace;
 
   friend TRELLIS_API @SPTR_NAME@ trellis_make_@BASE_NAME@ (
@@ -86,6 +86,43 @@ class test_trellis (gr_unittest.TestCase):
             # Make sure all packets succesfully transmitted.
             self.assertEqual(tb.dst.ntotal(), tb.dst.nright())
 
+    def test_001_pccc(self):
+        """
+        PCCC round trip over a channel that flips a few bits, decoded
+        as whole blocks and with windowed SISOs and early stopping.
+        """
+        f = trellis.fsm(*fsm_args["awgn1o2_4"])
+        K = 1000
+        il = trellis.interleaver(K, 666)
+        data = tuple([(i*i*7 + i/3) % 2 for i in range(2*K)])
+
+        tb = gr.top_block()
+        src = gr.vector_source_s(data)
+        enc = trellis.pccc_encoder_ss(f, 0, f, 0, il, K)
+        dst = gr.vector_sink_s()
+        tb.connect(src, enc, dst)
+        tb.run()
+
+        # Hamming distance metrics, one bit flipped every 23 symbols
+        O = f.O()*f.O()
+        metrics = []
+        for n, sym in enumerate(dst.data()):
+            if n % 23 == 0:
+                sym ^= 1 << (n % 4)
+            metrics += [float(bin(c ^ sym).count('1')) for c in range(O)]
+
+        for window, overlap, nthreads, stable in ((0, 0, 1, 0), (100, 20, 2, 1)):
+            tb = gr.top_block()
+            src = gr.vector_source_f(metrics)
+            dec = trellis.pccc_decoder_s(f, 0, -1, f, 0, -1, il, K, 10,
+                                         trellis.TRELLIS_MIN_SUM)
+            dec.set_window(window, overlap, nthreads)
+            dec.set_stable_iterations(stable)
+            dst = gr.vector_sink_s()
+            tb.connect(src, dec, dst)
+            tb.run()
+            self.assertEqual(data, dst.data())
+
 
 class trellis_tb(gr.top_block):
     """
@@ -39,6 +39,8 @@ int main(int argc, char *argv[]) {
     VOLK_PROFILE(volk_32fc_s32f_power_32fc_a, 1e-4, 0, 204600, 50, &results);
     VOLK_PROFILE(volk_32f_s32f_calc_spectral_noise_floor_32f_a, 1e-4, 20.0, 204600, 1000, &results);
     VOLK_PROFILE(volk_32fc_s32f_atan2_32f_a, 1e-4, 10.0, 204600, 100, &results);
+    VOLK_PROFILE(volk_32fc_s32f_atan2_32f_u, 1e-4, 10.0, 204600, 100, &results);
+    VOLK_PROFILE(volk_32fc_x2_s32f_quad_demod_32f_u, 1e-4, 2.0, 204600, 100, &results);
     //VOLK_PROFILE(volk_32fc_x2_conjugate_dot_prod_32fc_a, 1e-4, 0, 2046, 10000, &results);
     VOLK_PROFILE(volk_32fc_x2_conjugate_dot_prod_32fc_u, 1e-4, 0, 204600, 10000, &results);
     VOLK_PROFILE(volk_32fc_deinterleave_32f_x2_a, 1e-4, 0, 204600, 1000, &results);
@@ -0,0 +1,101 @@
+#ifndef INCLUDED_volk_32fc_32f_dot_prod_32fc_a_H
+#define INCLUDED_volk_32fc_32f_dot_prod_32fc_a_H
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+#include <stdio.h>
+
+#ifdef LV_HAVE_GENERIC
+
+  /*!
+    \brief Computes the dot product of a complex vector with a real vector
+    \param result The complex dot product
+    \param input The complex input vector
+    \param taps The real vector, e.g. the taps of a real FIR filter
+    \param num_points The number of values in input and taps
+  */
+static inline void volk_32fc_32f_dot_prod_32fc_a_generic(lv_32fc_t* result, const lv_32fc_t* input, const float * taps, unsigned int num_points) {
+
+  float res[2];
+  float *realpt = &res[0], *imagpt = &res[1];
+  const float* aPtr = (float*)input;
+  const float* bPtr=  taps;
+  unsigned int number = 0;
+
+  *realpt = 0;
+  *imagpt = 0;
+
+  for(number = 0; number < num_points; number++){
+    *realpt += ((*aPtr++) * (*bPtr));
+    *imagpt += ((*aPtr++) * (*bPtr++));
+  }
+
+  *result = lv_cmake(res[0], res[1]);
+}
+
+#endif /*LV_HAVE_GENERIC*/
+
+#ifdef LV_HAVE_SSE
+
+#include <xmmintrin.h>
+
+  /*!
+    \brief Computes the dot product of a complex vector with a real vector
+    \param result The complex dot product
+    \param input The complex input vector (aligned)
+    \param taps The real vector, e.g. the taps of a real FIR filter (aligned)
+    \param num_points The number of values in input and taps
+  */
+static inline void volk_32fc_32f_dot_prod_32fc_a_sse( lv_32fc_t* result, const  lv_32fc_t* input, const  float* taps, unsigned int num_points) {
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  float res[2];
+  float *realpt = &res[0], *imagpt = &res[1];
+
+  const float* aPtr = (float*)input;
+  const float* bPtr = taps;
+
+  __m128 a0Val, a1Val, bVal, b0Val, b1Val;
+
+  __m128 dotProdVal0 = _mm_setzero_ps();
+  __m128 dotProdVal1 = _mm_setzero_ps();
+
+  for(;number < quarterPoints; number++){
+
+    a0Val = _mm_load_ps(aPtr);     // r0,i0,r1,i1
+    a1Val = _mm_load_ps(aPtr+4);   // r2,i2,r3,i3
+    bVal = _mm_load_ps(bPtr);      // t0,t1,t2,t3
+
+    b0Val = _mm_unpacklo_ps(bVal, bVal); // t0,t0,t1,t1
+    b1Val = _mm_unpackhi_ps(bVal, bVal); // t2,t2,t3,t3
+
+    dotProdVal0 = _mm_add_ps(dotProdVal0, _mm_mul_ps(a0Val, b0Val));
+    dotProdVal1 = _mm_add_ps(dotProdVal1, _mm_mul_ps(a1Val, b1Val));
+
+    aPtr += 8;
+    bPtr += 4;
+  }
+
+  dotProdVal0 = _mm_add_ps(dotProdVal0, dotProdVal1);
+
+  __VOLK_ATTR_ALIGNED(16) float dotProductVector[4];
+
+  _mm_store_ps(dotProductVector,dotProdVal0); // Store the results back into the dot product vector
+
+  *realpt = dotProductVector[0] + dotProductVector[2];
+  *imagpt = dotProductVector[1] + dotProductVector[3];
+
+  number = quarterPoints * 4;
+  for(;number < num_points; number++){
+    *realpt += ((*aPtr++) * (*bPtr));
+    *imagpt += ((*aPtr++) * (*bPtr++));
+  }
+
+  *result = lv_cmake(res[0], res[1]);
+}
+
+#endif /*LV_HAVE_SSE*/
+
+#endif /*INCLUDED_volk_32fc_32f_dot_prod_32fc_a_H*/
@@ -0,0 +1,137 @@
+#ifndef INCLUDED_volk_32fc_s32fc_x2_rotator_32fc_u_H
+#define INCLUDED_volk_32fc_s32fc_x2_rotator_32fc_u_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+#include <math.h>
+
+// Number of points between renormalizations of the running phasor.
+#ifndef ROTATOR_RELOAD
+#define ROTATOR_RELOAD 512
+#endif
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+/*!
+  \brief Rotates the input vector by a running phasor: outVector[i] = inVector[i] * phase * phase_inc^i.
+  \param outVector The vector where the results will be stored
+  \param inVector The vector to be rotated
+  \param phase_inc The unit magnitude phasor the phase is multiplied by after each point
+  \param phase The starting phase; updated to the phase of the next point on return
+  \param num_points The number of complex values in inVector to be rotated and stored into outVector
+*/
+static inline void volk_32fc_s32fc_x2_rotator_32fc_u_sse3(lv_32fc_t* outVector, const lv_32fc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+    lv_32fc_t* cPtr = outVector;
+    const lv_32fc_t* aPtr = inVector;
+    lv_32fc_t incr = phase_inc * phase_inc;
+    __VOLK_ATTR_ALIGNED(16) lv_32fc_t phase_Ptr[2] = {(*phase), (*phase) * phase_inc};
+
+    unsigned int i, j = 0;
+
+    __m128 aVal, phase_Val, inc_Val, yl, yh, tmp1, tmp2, z, ylp, yhp, tmp1p, tmp2p;
+
+    phase_Val = _mm_load_ps((float*)phase_Ptr);
+    inc_Val = _mm_set_ps(lv_cimag(incr), lv_creal(incr), lv_cimag(incr), lv_creal(incr));
+
+    const unsigned int halfPoints = num_points / 2;
+
+    for(i = 0; i < (unsigned int)(halfPoints / (ROTATOR_RELOAD / 2)); i++) {
+      for(j = 0; j < ROTATOR_RELOAD / 2; ++j) {
+
+        aVal = _mm_loadu_ps((float*)aPtr);
+
+        yl = _mm_moveldup_ps(phase_Val);
+        yh = _mm_movehdup_ps(phase_Val);
+        ylp = _mm_moveldup_ps(inc_Val);
+        yhp = _mm_movehdup_ps(inc_Val);
+
+        tmp1 = _mm_mul_ps(aVal, yl);
+        tmp1p = _mm_mul_ps(phase_Val, ylp);
+
+        aVal = _mm_shuffle_ps(aVal, aVal, 0xB1);
+        phase_Val = _mm_shuffle_ps(phase_Val, phase_Val, 0xB1);
+        tmp2 = _mm_mul_ps(aVal, yh);
+        tmp2p = _mm_mul_ps(phase_Val, yhp);
+
+        z = _mm_addsub_ps(tmp1, tmp2);
+        phase_Val = _mm_addsub_ps(tmp1p, tmp2p);
+
+        _mm_storeu_ps((float*)cPtr, z);
+
+        aPtr += 2;
+        cPtr += 2;
+      }
+      // Renormalize both phasors so rounding can't change the gain
+      tmp1 = _mm_mul_ps(phase_Val, phase_Val);
+      tmp2 = _mm_hadd_ps(tmp1, tmp1);
+      tmp1 = _mm_shuffle_ps(tmp2, tmp2, _MM_SHUFFLE(1,1,0,0));
+      tmp2 = _mm_sqrt_ps(tmp1);
+      phase_Val = _mm_div_ps(phase_Val, tmp2);
+    }
+    for(i = 0; i < halfPoints % (ROTATOR_RELOAD / 2); ++i) {
+      aVal = _mm_loadu_ps((float*)aPtr);
+
+      yl = _mm_moveldup_ps(phase_Val);
+      yh = _mm_movehdup_ps(phase_Val);
+      ylp = _mm_moveldup_ps(inc_Val);
+      yhp = _mm_movehdup_ps(inc_Val);
+
+      tmp1 = _mm_mul_ps(aVal, yl);
+      tmp1p = _mm_mul_ps(phase_Val, ylp);
+
+      aVal = _mm_shuffle_ps(aVal, aVal, 0xB1);
+      phase_Val = _mm_shuffle_ps(phase_Val, phase_Val, 0xB1);
+      tmp2 = _mm_mul_ps(aVal, yh);
+      tmp2p = _mm_mul_ps(phase_Val, yhp);
+
+      z = _mm_addsub_ps(tmp1, tmp2);
+      phase_Val = _mm_addsub_ps(tmp1p, tmp2p);
+
+      _mm_storeu_ps((float*)cPtr, z);
+
+      aPtr += 2;
+      cPtr += 2;
+    }
+
+    _mm_store_ps((float*)phase_Ptr, phase_Val);
+    (*phase) = phase_Ptr[0];
+    if(num_points & 1) {
+      *cPtr++ = *aPtr++ * (*phase);
+      (*phase) *= phase_inc;
+    }
+}
+#endif /* LV_HAVE_SSE3 */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Rotates the input vector by a running phasor: outVector[i] = inVector[i] * phase * phase_inc^i.
+  \param outVector The vector where the results will be stored
+  \param inVector The vector to be rotated
+  \param phase_inc The unit magnitude phasor the phase is multiplied by after each point
+  \param phase The starting phase; updated to the phase of the next point on return
+  \param num_points The number of complex values in inVector to be rotated and stored into outVector
+*/
+static inline void volk_32fc_s32fc_x2_rotator_32fc_u_generic(lv_32fc_t* outVector, const lv_32fc_t* inVector, const lv_32fc_t phase_inc, lv_32fc_t* phase, unsigned int num_points){
+    lv_32fc_t* cPtr = outVector;
+    const lv_32fc_t* aPtr = inVector;
+    lv_32fc_t ph = *phase;
+    unsigned int i, j;
+
+    for(i = 0; i < num_points / ROTATOR_RELOAD; ++i) {
+      for(j = 0; j < ROTATOR_RELOAD; ++j) {
+        *cPtr++ = *aPtr++ * ph;
+        ph *= phase_inc;
+      }
+      ph /= hypotf(lv_creal(ph), lv_cimag(ph));
+    }
+    for(i = 0; i < num_points % ROTATOR_RELOAD; ++i) {
+      *cPtr++ = *aPtr++ * ph;
+      ph *= phase_inc;
+    }
+    *phase = ph;
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_32fc_s32fc_x2_rotator_32fc_u_H */
@@ -0,0 +1,107 @@
+#ifndef INCLUDED_volk_32fc_x2_dual_dot_prod_32fc_u_H
+#define INCLUDED_volk_32fc_x2_dual_dot_prod_32fc_u_H
+
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+#include <stdio.h>
+
+#ifdef LV_HAVE_GENERIC
+
+  /*!
+    \brief Computes the dot products of a complex vector with the real and with the imaginary parts of a second vector
+    \param result result[0] is sum(input[i] * real(taps[i])), result[1] is sum(input[i] * imag(taps[i]))
+    \param input The complex input vector
+    \param taps Two interleaved real vectors, e.g. the taps of a FIR filter and of its derivative
+    \param num_points The number of values in input and taps
+  */
+static inline void volk_32fc_x2_dual_dot_prod_32fc_u_generic(lv_32fc_t* result, const lv_32fc_t* input, const lv_32fc_t* taps, unsigned int num_points) {
+
+  float res[4] = {0, 0, 0, 0};
+  const float* aPtr = (float*)input;
+  const float* bPtr = (float*)taps;
+  unsigned int number = 0;
+
+  for(number = 0; number < num_points; number++){
+    res[0] += aPtr[0] * bPtr[0];
+    res[1] += aPtr[1] * bPtr[0];
+    res[2] += aPtr[0] * bPtr[1];
+    res[3] += aPtr[1] * bPtr[1];
+    aPtr += 2;
+    bPtr += 2;
+  }
+
+  result[0] = lv_cmake(res[0], res[1]);
+  result[1] = lv_cmake(res[2], res[3]);
+}
+
+#endif /*LV_HAVE_GENERIC*/
+
+#ifdef LV_HAVE_SSE
+
+#include <xmmintrin.h>
+
+  /*!
+    \brief Computes the dot products of a complex vector with the real and with the imaginary parts of a second vector
+    \param result result[0] is sum(input[i] * real(taps[i])), result[1] is sum(input[i] * imag(taps[i]))
+    \param input The complex input vector (unaligned)
+    \param taps Two interleaved real vectors, e.g. the taps of a FIR filter and of its derivative (unaligned)
+    \param num_points The number of values in input and taps
+  */
+static inline void volk_32fc_x2_dual_dot_prod_32fc_u_sse(lv_32fc_t* result, const lv_32fc_t* input, const lv_32fc_t* taps, unsigned int num_points) {
+
+  unsigned int number = 0;
+  const unsigned int halfPoints = num_points / 2;
+
+  float res[4];
+
+  const float* aPtr = (float*)input;
+  const float* bPtr = (float*)taps;
+
+  __m128 aVal, bVal, b0Val, b1Val;
+
+  __m128 dotProdVal0 = _mm_setzero_ps();
+  __m128 dotProdVal1 = _mm_setzero_ps();
+
+  for(;number < halfPoints; number++){
+
+    aVal = _mm_loadu_ps(aPtr);     // r0,i0,r1,i1
+    bVal = _mm_loadu_ps(bPtr);     // h0,d0,h1,d1
+
+    b0Val = _mm_shuffle_ps(bVal, bVal, _MM_SHUFFLE(2,2,0,0)); // h0,h0,h1,h1
+    b1Val = _mm_shuffle_ps(bVal, bVal, _MM_SHUFFLE(3,3,1,1)); // d0,d0,d1,d1
+
+    dotProdVal0 = _mm_add_ps(dotProdVal0, _mm_mul_ps(aVal, b0Val));
+    dotProdVal1 = _mm_add_ps(dotProdVal1, _mm_mul_ps(aVal, b1Val));
+
+    aPtr += 4;
+    bPtr += 4;
+  }
+
+  __VOLK_ATTR_ALIGNED(16) float dotProductVector0[4];
+  __VOLK_ATTR_ALIGNED(16) float dotProductVector1[4];
+
+  _mm_store_ps(dotProductVector0,dotProdVal0); // Store the results back into the dot product vectors
+  _mm_store_ps(dotProductVector1,dotProdVal1);
+
+  res[0] = dotProductVector0[0] + dotProductVector0[2];
+  res[1] = dotProductVector0[1] + dotProductVector0[3];
+  res[2] = dotProductVector1[0] + dotProductVector1[2];
+  res[3] = dotProductVector1[1] + dotProductVector1[3];
+
+  number = halfPoints * 2;
+  for(;number < num_points; number++){
+    res[0] += aPtr[0] * bPtr[0];
+    res[1] += aPtr[1] * bPtr[0];
+    res[2] += aPtr[0] * bPtr[1];
+    res[3] += aPtr[1] * bPtr[1];
+    aPtr += 2;
+    bPtr += 2;
+  }
+
+  result[0] = lv_cmake(res[0], res[1]);
+  result[1] = lv_cmake(res[2], res[3]);
+}
+
+#endif /*LV_HAVE_SSE*/
+
+#endif /*INCLUDED_volk_32fc_x2_dual_dot_prod_32fc_u_H*/
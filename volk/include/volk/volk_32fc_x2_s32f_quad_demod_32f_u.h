@@ -0,0 +1,86 @@
+#ifndef INCLUDED_volk_32fc_x2_s32f_quad_demod_32f_u_H
+#define INCLUDED_volk_32fc_x2_s32f_quad_demod_32f_u_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <math.h>
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+#include <volk/volk_sse_intrinsics.h>
+/*!
+  \brief Quadrature (FM) demodulation: outputVector[i] = gain * arg(aVector[i] * conj(bVector[i]))
+  \param outputVector The vector where the results will be stored
+  \param aVector The current samples
+  \param bVector The previous samples; usually aVector - 1
+  \param gain The phase differences are multiplied by this gain
+  \param num_points The number of values in aVector and bVector
+*/
+static inline void volk_32fc_x2_s32f_quad_demod_32f_u_sse(float* outputVector, const lv_32fc_t* aVector, const lv_32fc_t* bVector, const float gain, unsigned int num_points){
+  const float* aPtr = (const float*)aVector;
+  const float* bPtr = (const float*)bVector;
+  float* outPtr = outputVector;
+
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m128 vGain = _mm_set_ps1(gain);
+  __m128 a1, a2, b1, b2, ar, ai, br, bi, pr, pi;
+
+  for (; number < quarterPoints; number++) {
+    a1 = _mm_loadu_ps(aPtr);
+    a2 = _mm_loadu_ps(aPtr + 4);
+    b1 = _mm_loadu_ps(bPtr);
+    b2 = _mm_loadu_ps(bPtr + 4);
+    aPtr += 8;
+    bPtr += 8;
+
+    ar = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(2,0,2,0));
+    ai = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(3,1,3,1));
+    br = _mm_shuffle_ps(b1, b2, _MM_SHUFFLE(2,0,2,0));
+    bi = _mm_shuffle_ps(b1, b2, _MM_SHUFFLE(3,1,3,1));
+
+    // a * conj(b)
+    pr = _mm_add_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+    pi = _mm_sub_ps(_mm_mul_ps(ai, br), _mm_mul_ps(ar, bi));
+
+    _mm_storeu_ps(outPtr, _mm_mul_ps(_mm_atan2_poly_ps(pi, pr), vGain));
+    outPtr += 4;
+  }
+
+  for (number = quarterPoints * 4; number < num_points; number++) {
+    const float a_r = *aPtr++;
+    const float a_i = *aPtr++;
+    const float b_r = *bPtr++;
+    const float b_i = *bPtr++;
+    *outPtr++ = gain * atan2f(a_i * b_r - a_r * b_i, a_r * b_r + a_i * b_i);
+  }
+}
+#endif /* LV_HAVE_SSE */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Quadrature (FM) demodulation: outputVector[i] = gain * arg(aVector[i] * conj(bVector[i]))
+  \param outputVector The vector where the results will be stored
+  \param aVector The current samples
+  \param bVector The previous samples; usually aVector - 1
+  \param gain The phase differences are multiplied by this gain
+  \param num_points The number of values in aVector and bVector
+*/
+static inline void volk_32fc_x2_s32f_quad_demod_32f_u_generic(float* outputVector, const lv_32fc_t* aVector, const lv_32fc_t* bVector, const float gain, unsigned int num_points){
+  const float* aPtr = (const float*)aVector;
+  const float* bPtr = (const float*)bVector;
+  float* outPtr = outputVector;
+  unsigned int number;
+
+  for (number = 0; number < num_points; number++) {
+    const float ar = *aPtr++;
+    const float ai = *aPtr++;
+    const float br = *bPtr++;
+    const float bi = *bPtr++;
+    *outPtr++ = gain * atan2f(ai * br - ar * bi, ar * br + ai * bi);
+  }
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_32fc_x2_s32f_quad_demod_32f_u_H */
@@ -0,0 +1,73 @@
+#ifndef INCLUDED_volk_8u_diff_encode_8u_u_H
+#define INCLUDED_volk_8u_diff_encode_8u_u_H
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+/*!
+  \brief Differentially encodes the bytes: out[i] = (in[i] + out[i-1]) % modulus
+  \param out The encoded bytes
+  \param in The bytes to be encoded
+  \param last The output before out[0]; updated to the last output on return
+  \param modulus The modulus
+  \param num_points The number of bytes in in and out
+*/
+static inline void volk_8u_diff_encode_8u_u_ssse3(unsigned char* out, const unsigned char* in, unsigned char* last, const unsigned int modulus, unsigned int num_points){
+  unsigned int number = 0;
+  unsigned int lastOut = *last;
+
+  // For a power of two modulus the outputs are a running sum mod 256,
+  // masked: a prefix sum across each vector, plus the previous output.
+  if(modulus > 0 && modulus <= 256 && (modulus & (modulus - 1)) == 0){
+    const __m128i mask = _mm_set1_epi8(modulus - 1);
+    const __m128i lastByte = _mm_set1_epi8(15);
+    __m128i carry = _mm_set1_epi8(lastOut);
+    const unsigned int sixteenthPoints = num_points / 16;
+    for(number = 0; number < sixteenthPoints; number++){
+      __m128i x = _mm_loadu_si128((const __m128i*)in);
+      x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+      x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+      x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+      x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+      x = _mm_and_si128(_mm_add_epi8(x, carry), mask);
+      _mm_storeu_si128((__m128i*)out, x);
+      carry = _mm_shuffle_epi8(x, lastByte);
+      in += 16;
+      out += 16;
+    }
+    number = sixteenthPoints * 16;
+    if(number > 0)
+      lastOut = out[-1];
+  }
+
+  for(; number < num_points; number++){
+    *out = (*in++ + lastOut) % modulus;
+    lastOut = *out++;
+  }
+  *last = lastOut;
+}
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Differentially encodes the bytes: out[i] = (in[i] + out[i-1]) % modulus
+  \param out The encoded bytes
+  \param in The bytes to be encoded
+  \param last The output before out[0]; updated to the last output on return
+  \param modulus The modulus
+  \param num_points The number of bytes in in and out
+*/
+static inline void volk_8u_diff_encode_8u_u_generic(unsigned char* out, const unsigned char* in, unsigned char* last, const unsigned int modulus, unsigned int num_points){
+  unsigned int number;
+  unsigned int lastOut = *last;
+  for(number = 0; number < num_points; number++){
+    *out = (*in++ + lastOut) % modulus;
+    lastOut = *out++;
+  }
+  *last = lastOut;
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_8u_diff_encode_8u_u_H */
@@ -0,0 +1,26 @@
+#ifndef INCLUDED_volk_8u_map_8u_u_H
+#define INCLUDED_volk_8u_map_8u_u_H
+
+#include <inttypes.h>
+#include <stdio.h>
+
+// A 256 entry table is 16 PSHUFB slices; looking a byte up in all of
+// them costs more than the plain table lookup, so there is no SIMD
+// version.
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Maps each byte through a 256 entry table: out[i] = table[in[i]]
+  \param out The mapped bytes
+  \param in The bytes to be mapped
+  \param table The 256 entry table
+  \param num_points The number of bytes in in and out
+*/
+static inline void volk_8u_map_8u_u_generic(unsigned char* out, const unsigned char* in, const unsigned char* table, unsigned int num_points){
+  unsigned int number;
+  for(number = 0; number < num_points; number++)
+    *out++ = table[*in++];
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_8u_map_8u_u_H */
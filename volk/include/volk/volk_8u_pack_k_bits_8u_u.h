@@ -0,0 +1,63 @@
+#ifndef INCLUDED_volk_8u_pack_k_bits_8u_u_H
+#define INCLUDED_volk_8u_pack_k_bits_8u_u_H
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+/*!
+  \brief Packs the LSBs of k bytes at a time into the low bits of one byte, MSB first
+  \param out The packed bytes
+  \param in The bits to be packed, one per byte, num_points * k of them
+  \param k The number of bits in each output byte
+  \param num_points The number of bytes in out
+*/
+static inline void volk_8u_pack_k_bits_8u_u_ssse3(unsigned char* out, const unsigned char* in, const unsigned int k, unsigned int num_points){
+  unsigned int number = 0;
+  unsigned int j;
+
+  if(k == 8){
+    // reverse each group of 8 so the first bit lands in the MSB, move
+    // every LSB to its byte's MSB and gather them
+    const __m128i reverse = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    const unsigned int halfPoints = num_points / 2;
+    for(number = 0; number < halfPoints; number++){
+      __m128i inVal = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), reverse);
+      unsigned int bits = _mm_movemask_epi8(_mm_slli_epi16(inVal, 7));
+      *out++ = bits & 0xff;
+      *out++ = bits >> 8;
+      in += 16;
+    }
+    number = halfPoints * 2;
+  }
+
+  for(; number < num_points; number++){
+    unsigned int t = 0;
+    for(j = 0; j < k; j++)
+      t = (t << 1) | (*in++ & 0x01);
+    *out++ = t;
+  }
+}
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Packs the LSBs of k bytes at a time into the low bits of one byte, MSB first
+  \param out The packed bytes
+  \param in The bits to be packed, one per byte, num_points * k of them
+  \param k The number of bits in each output byte
+  \param num_points The number of bytes in out
+*/
+static inline void volk_8u_pack_k_bits_8u_u_generic(unsigned char* out, const unsigned char* in, const unsigned int k, unsigned int num_points){
+  unsigned int number, j;
+  for(number = 0; number < num_points; number++){
+    unsigned int t = 0;
+    for(j = 0; j < k; j++)
+      t = (t << 1) | (*in++ & 0x01);
+    *out++ = t;
+  }
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_8u_pack_k_bits_8u_u_H */
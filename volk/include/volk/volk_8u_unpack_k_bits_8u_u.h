@@ -0,0 +1,76 @@
+#ifndef INCLUDED_volk_8u_unpack_k_bits_8u_u_H
+#define INCLUDED_volk_8u_unpack_k_bits_8u_u_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <volk/volk_common.h>
+
+#ifdef LV_HAVE_SSSE3
+#include <tmmintrin.h>
+/*!
+  \brief Unpacks the k low bits of each byte, MSB first, one bit per output byte
+  \param out The unpacked bits, 0 or 1, num_points * k of them
+  \param in The bytes to be unpacked
+  \param k The number of bits to take from each byte
+  \param num_points The number of bytes in in
+*/
+static inline void volk_8u_unpack_k_bits_8u_u_ssse3(unsigned char* out, const unsigned char* in, const unsigned int k, unsigned int num_points){
+  unsigned int number = 0;
+  unsigned int i, j;
+
+  if(k <= 8){
+    // 16 bytes in make k vectors of 16 bits out; for each, which byte
+    // each bit comes from and which bit of it
+    __VOLK_ATTR_ALIGNED(16) unsigned char byteIndex[8][16];
+    __VOLK_ATTR_ALIGNED(16) unsigned char bitMask[8][16];
+    for(j = 0; j < k; j++){
+      for(i = 0; i < 16; i++){
+        unsigned int bit = 16 * j + i;
+        byteIndex[j][i] = bit / k;
+        bitMask[j][i] = 1 << (k - 1 - bit % k);
+      }
+    }
+
+    const __m128i one = _mm_set1_epi8(1);
+    const unsigned int sixteenthPoints = num_points / 16;
+    for(number = 0; number < sixteenthPoints; number++){
+      __m128i inVal = _mm_loadu_si128((const __m128i*)in);
+      for(j = 0; j < k; j++){
+        __m128i mask = _mm_load_si128((const __m128i*)bitMask[j]);
+        __m128i bits = _mm_shuffle_epi8(inVal, _mm_load_si128((const __m128i*)byteIndex[j]));
+        bits = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(bits, mask), mask), one);
+        _mm_storeu_si128((__m128i*)out, bits);
+        out += 16;
+      }
+      in += 16;
+    }
+    number = sixteenthPoints * 16;
+  }
+
+  for(; number < num_points; number++){
+    unsigned int t = *in++;
+    for(j = k; j > 0; j--)
+      *out++ = (t >> (j - 1)) & 0x01;
+  }
+}
+#endif /* LV_HAVE_SSSE3 */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Unpacks the k low bits of each byte, MSB first, one bit per output byte
+  \param out The unpacked bits, 0 or 1, num_points * k of them
+  \param in The bytes to be unpacked
+  \param k The number of bits to take from each byte
+  \param num_points The number of bytes in in
+*/
+static inline void volk_8u_unpack_k_bits_8u_u_generic(unsigned char* out, const unsigned char* in, const unsigned int k, unsigned int num_points){
+  unsigned int number, j;
+  for(number = 0; number < num_points; number++){
+    unsigned int t = *in++;
+    for(j = k; j > 0; j--)
+      *out++ = (t >> (j - 1)) & 0x01;
+  }
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_8u_unpack_k_bits_8u_u_H */
@@ -0,0 +1,55 @@
+#ifndef INCLUDED_volk_8u_x2_diff_decode_8u_u_H
+#define INCLUDED_volk_8u_x2_diff_decode_8u_u_H
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+/*!
+  \brief Differentially decodes the bytes: out[i] = (in[i] - inPrev[i]) % modulus
+  \param out The decoded bytes
+  \param in The bytes to be decoded
+  \param inPrev The bytes before them, usually in - 1
+  \param modulus The modulus
+  \param num_points The number of bytes in in and out
+*/
+static inline void volk_8u_x2_diff_decode_8u_u_sse2(unsigned char* out, const unsigned char* in, const unsigned char* inPrev, const unsigned int modulus, unsigned int num_points){
+  unsigned int number = 0;
+
+  // For a power of two modulus the difference mod 256, masked, is it.
+  if(modulus > 0 && modulus <= 256 && (modulus & (modulus - 1)) == 0){
+    const __m128i mask = _mm_set1_epi8(modulus - 1);
+    const unsigned int sixteenthPoints = num_points / 16;
+    for(number = 0; number < sixteenthPoints; number++){
+      __m128i x = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)in), _mm_loadu_si128((const __m128i*)inPrev));
+      _mm_storeu_si128((__m128i*)out, _mm_and_si128(x, mask));
+      in += 16;
+      inPrev += 16;
+      out += 16;
+    }
+    number = sixteenthPoints * 16;
+  }
+
+  for(; number < num_points; number++)
+    *out++ = (*in++ - *inPrev++) % modulus;
+}
+#endif /* LV_HAVE_SSE2 */
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Differentially decodes the bytes: out[i] = (in[i] - inPrev[i]) % modulus
+  \param out The decoded bytes
+  \param in The bytes to be decoded
+  \param inPrev The bytes before them, usually in - 1
+  \param modulus The modulus
+  \param num_points The number of bytes in in and out
+*/
+static inline void volk_8u_x2_diff_decode_8u_u_generic(unsigned char* out, const unsigned char* in, const unsigned char* inPrev, const unsigned int modulus, unsigned int num_points){
+  unsigned int number;
+  for(number = 0; number < num_points; number++)
+    *out++ = (*in++ - *inPrev++) % modulus;
+}
+#endif /* LV_HAVE_GENERIC */
+
+#endif /* INCLUDED_volk_8u_x2_diff_decode_8u_u_H */
@@ -0,0 +1,54 @@
+/*
+ * Helpers shared by the SSE protokernels.
+ */
+
+#ifndef INCLUDED_volk_sse_intrinsics_H
+#define INCLUDED_volk_sse_intrinsics_H
+
+#include <xmmintrin.h>
+
+/*!
+  \brief Four-wide atan2(y, x) using only SSE1 arithmetic.
+
+  The angle is folded into [0, pi/4] with min/max, approximated there
+  by an odd degree 13 minimax polynomial and unfolded with masks.  The
+  error is below 5e-7 radians.  Zeros are handled as atan2f does.
+*/
+static inline __m128 _mm_atan2_poly_ps(const __m128 y, const __m128 x){
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 pi = _mm_set1_ps(3.14159265358979f);
+  const __m128 pi_2 = _mm_set1_ps(1.57079632679490f);
+
+  __m128 ax = _mm_andnot_ps(sign_mask, x);
+  __m128 ay = _mm_andnot_ps(sign_mask, y);
+  __m128 mx = _mm_max_ps(ax, ay);
+  __m128 mn = _mm_min_ps(ax, ay);
+
+  // a = mn / mx, forced to 0 where both are 0
+  __m128 a = _mm_and_ps(_mm_div_ps(mn, mx), _mm_cmpneq_ps(mx, zero));
+  __m128 s = _mm_mul_ps(a, a);
+
+  __m128 r = _mm_set1_ps(0.00681173938f);
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(-0.0336041716f));
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.0796238167f));
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(-0.132333676f));
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.198078302f));
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(-0.333173713f));
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.999996114f));
+  r = _mm_mul_ps(r, a);
+
+  // |y| > |x|: r = pi/2 - r
+  __m128 mask = _mm_cmpgt_ps(ay, ax);
+  r = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(pi_2, r)), _mm_andnot_ps(mask, r));
+
+  // x < 0 or x == -0: r = pi - r.  OR-ing in FLT_MIN keeps the sign
+  // and turns -0 into a negative number the compare can see.
+  mask = _mm_cmplt_ps(_mm_or_ps(x, _mm_set1_ps(1.17549435e-38f)), zero);
+  r = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(pi, r)), _mm_andnot_ps(mask, r));
+
+  // take the sign of y
+  return _mm_xor_ps(r, _mm_and_ps(y, sign_mask));
+}
+
+#endif /* INCLUDED_volk_sse_intrinsics_H */